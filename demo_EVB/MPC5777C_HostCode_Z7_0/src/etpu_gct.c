@@ -256,6 +256,7 @@ struct aw_i2c_master_instance_t  i2c_master_instance =
 struct aw_i2c_master_config_t    i2c_master_config =
 {
     (uint8_t*)0, // will be filled in once allocated
+    0,
     100, // kHz bit rate
     // detailed timing parameters - not used in this example - just set to 0
     0,
@@ -433,6 +434,7 @@ int32_t my_system_etpu_init(void)
 		return FS_ETPU_ERROR_MALLOC;
     // set buffer info into config structures
     i2c_master_config.p_cmd_buffer = g_p_i2c_master_cmd_buf;
+    i2c_master_config.cmd_buffer_size = 64;
     i2c_slave1_config.p_read_buffer = g_p_i2c_slave1_read_buf;
     i2c_slave1_config.read_buffer_size = 64;
     i2c_slave1_config.p_write_buffer = g_p_i2c_slave1_write_buf;
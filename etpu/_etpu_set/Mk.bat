@@ -21,11 +21,19 @@ echo Building eTPU code ...
 if  %ERRORLEVEL% NEQ 0 ( goto errors )
 %CC% etec_i2c_slave.c -globalscratchpad -out=obj\etec_i2c_slave.eao
 if  %ERRORLEVEL% NEQ 0 ( goto errors )
+%CC% etec_i2c_monitor.c -globalscratchpad -out=obj\etec_i2c_monitor.eao
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+%CC% etec_i2c_ufm.c -globalscratchpad -out=obj\etec_i2c_ufm.eao
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+%CC% etec_i2c_multilane.c -globalscratchpad -out=obj\etec_i2c_multilane.eao
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+%CC% etec_i2c_node.c -globalscratchpad -out=obj\etec_i2c_node.eao
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
 
-%LINK% obj\etec_i2c_master.eao obj\etec_i2c_slave.eao -out=etpu_set.elf -etba=0x0 -CodeSize=0x1800 -map -lst
+%LINK% obj\etec_i2c_master.eao obj\etec_i2c_slave.eao obj\etec_i2c_monitor.eao obj\etec_i2c_ufm.eao obj\etec_i2c_multilane.eao obj\etec_i2c_node.eao -out=etpu_set.elf -etba=0x0 -CodeSize=0x3000 -map -lst
 if  %ERRORLEVEL% NEQ 0 ( goto errors )
 
-%LINK% obj\etec_i2c_master.eao obj\etec_i2c_slave.eao -out=etpu_c_set.elf -etba=0x0 -CodeSize=0x1800 -map -GM=C_
+%LINK% obj\etec_i2c_master.eao obj\etec_i2c_slave.eao obj\etec_i2c_monitor.eao obj\etec_i2c_ufm.eao obj\etec_i2c_multilane.eao obj\etec_i2c_node.eao -out=etpu_c_set.elf -etba=0x0 -CodeSize=0x3000 -map -GM=C_
 if  %ERRORLEVEL% NEQ 0 ( goto errors )
 
 echo .
@@ -48,6 +48,44 @@
 // base channel + 2 = SDA_out
 // base channel + 3 = SDA_in
 
+// bus recovery progress/outcome (_recovery_state)
+#define I2C_RECOVERY_CLOCKING		0
+#define I2C_RECOVERY_STOP_SDA_LOW	1
+#define I2C_RECOVERY_STOP_SDA_HIGH	2
+#define I2C_RECOVERY_STOP_DONE		3
+#define I2C_RECOVERY_FAILED			4
+
+// 10-bit address progress of the current command (_addr10_state)
+#define I2C_ADDR10_NONE				0 // 7-bit, or both address bytes sent
+#define I2C_ADDR10_LOW_BYTE			1 // header sent, second address byte next
+#define I2C_ADDR10_RSTART			2 // read: repeated START and header (R) next
+
+// Hs-mode progress of the current transfer (_hs_state)
+#define I2C_HS_NONE					0 // F/S timing in use
+#define I2C_HS_MASTER_CODE			1 // master code being sent at F/S timing
+#define I2C_HS_ACTIVE				2 // Hs timing in use, until the STOP
+
+// load the working timing from the F/S or the Hs-mode profile; the host
+// inputs themselves are never written by the eTPU
+#define I2C_FS_TIMING() \
+	{ \
+		_cur_tLOW = _tLOW; \
+		_cur_tHIGH = _tHIGH; \
+		_cur_tSU_STA = _tSU_STA; \
+		_cur_tSU_STO = _tSU_STO; \
+		_cur_tHD_DAT = _tHD_DAT; \
+		_cur_tr_max = _tr_max; \
+	}
+#define I2C_HS_TIMING() \
+	{ \
+		_cur_tLOW = _hs_tLOW; \
+		_cur_tHIGH = _hs_tHIGH; \
+		_cur_tSU_STA = _hs_tSU_STA; \
+		_cur_tSU_STO = _hs_tSU_STO; \
+		_cur_tHD_DAT = _hs_tHD_DAT; \
+		_cur_tr_max = _hs_tr_max; \
+	}
+
 
 // entered on SCL_out channel, HSR 7
 _eTPU_thread I2C_master::InitSCL_out(_eTPU_matches_disabled)
@@ -109,10 +147,18 @@ _eTPU_thread I2C_master::InitSDA_in(_eTPU_matches_disabled)
 	DetectADisable();
 	DetectBDisable();
 	SingleMatchSingleTransition();
-	DisableEventHandling(); // "handled" by SCL_out channel instead
+	DisableEventHandling(); // "handled" by SCL_out channel instead; match A times out transfers
 	ClearAllLatches();
 	ClrFlag0();
 	ClrFlag1();
+	// multi-master: watch the bus for other masters (see MonitorStart/MonitorStop);
+	// the bus is taken to be free to begin with
+	_bus_busy = 0;
+	if (_multi_master)
+	{
+		DetectAAnyEdge();
+		EnableEventHandling();
+	}
 }
 
 // entered on all channels, HSR 2
@@ -126,8 +172,14 @@ _eTPU_thread I2C_master::Shutdown(_eTPU_matches_disabled)
 // entered on SCL_in channel, HSR 4
 _eTPU_thread I2C_master::LatchAndClearErrorFlags(_eTPU_matches_enabled)
 {
+	// bracket the two-field update with the result sequence counter; if a
+	// transfer is in progress the counter is already odd and is left as is
+	unsigned int24 seq = _result_seq;
+	_result_seq = seq | 1;
 	_latched_error_flags = _error_flags;
 	_error_flags = 0;
+	if ((seq & 1) == 0)
+		_result_seq = seq + 2;
 }
 
 // entered on SCL_out channel, HSR 4
@@ -135,12 +187,6 @@ _eTPU_thread I2C_master::LatchAndClearErrorFlags(_eTPU_matches_enabled)
 // message transfer requested; issue a START to begin the transfer process
 _eTPU_thread I2C_master::StartTransfer(_eTPU_matches_enabled)
 {
-	// need to pulse SDA low, bringing SCL low during SDA low pulse
-	// SDA : ----\_______/--
-	// SCL : --------\______
-
-	int24 start_trans_time;
-
 	// need to make sure a transfer is not in progress
 	if (_in_use_flag)
 	{
@@ -150,38 +196,211 @@ _eTPU_thread I2C_master::StartTransfer(_eTPU_matches_enabled)
 		return;
 	}
 	_in_use_flag = 1;
-	_start_flag = 1;
+	_result_seq++; // odd - results now being updated
+	_abort_request = 0; // only an abort of this transfer counts
+
+	if (_bus_busy)
+	{
+		// another master owns the bus; the START waits for its STOP (see
+		// MonitorStop), for at most the transfer timeout
+		_start_deferred = 1;
+		if (_transfer_timeout)
+		{
+			chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+			ClearMatchALatch();
+			SetupMatchA(tcr1 + _transfer_timeout);
+		}
+		return;
+	}
+
+	if (_auto_recover && !_bus_held)
+	{
+		// a START cannot be generated while a slave holds SDA low;
+		// clear the bus first and issue the transfer once it is free
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		if (!IsCurrentInputPinHigh())
+		{
+			chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+			_recover_then_start = 1;
+			RecoverBus_fragment(); // no return
+		}
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	}
+	StartTransfer_fragment(); // no return
+}
+// entered on SCL_out channel, with _in_use_flag already set
+_eTPU_fragment I2C_master::StartTransfer_fragment()
+{
+	// need to pulse SDA low, bringing SCL low during SDA low pulse
+	// SDA : ----\_______/--
+	// SCL : --------\______
+
+	int24 start_trans_time;
+
+	// aborted while the START waited for the bus (MonitorStop) or for a
+	// bus recovery (RecoverDone_fragment)
+	if (_abort_request)
+		AbortStart_fragment(); // no return
 
 	_p_current_cmd = _p_cmd_list;
 	_cmd_sent_cnt = 0;
+	_aborted = 0;
+	_hold_active = _hold_request;
+	_hold_request = 0;
+	_retry_pending = 0;
+	_attempts = 1;
+	_cmd_attempts = 1;
+	_cur_retry_interval = _retry_interval;
+	_nack_stop = 0;
+	_failed_cmd = ETPU_I2C_MASTER_NO_FAILED_CMD;
+	_failed_cnt = 0;
+	_arb_check = 0;
 
 	// setup header byte transfer and prepare for rest of message
 	_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 16;
 	_working_bit_count = 8;
-	_p_working_buf = _p_current_cmd->p_buffer; // always points to next byte
+	_p_working_buf = (unsigned int8*)_p_current_cmd->p_buffer; // always points to next byte
 	_working_buf_read_write_flag = _p_current_cmd->header & 1;
 	_working_buf_size = _p_current_cmd->size;
-	_remaining_byte_count = _p_current_cmd->size;
+	_addr10_state = I2C_ADDR10_NONE;
+	if (_p_current_cmd->flags & ETPU_I2C_CMD_ADDR10)
+	{
+		// 10-bit address: the header goes out as a write, followed by the
+		// second address byte
+		_working_byte &= ~(((unsigned int24)ETPU_I2C_RW_MASK) << 16);
+		_addr10_state = I2C_ADDR10_LOW_BYTE;
+	}
+	_remaining_byte_count = _working_buf_size;
 	_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
 
-	// setup transfer start after (_tbuf) time
-	start_trans_time = tcr1 + _tBUF;
+	// Hs-mode: the master code goes out first, at F/S timing (see
+	// ProcessAck_Step2); a bus held by an Hs-mode transfer is still in Hs-mode
+	_hs_transfer = _hs_request;
+	_hs_request = 0;
+	if (_hs_state == I2C_HS_ACTIVE)
+		_hs_transfer = 1;
+	else
+	{
+		// pick up the F/S timing as the host last set it
+		I2C_FS_TIMING();
+		if (_hs_transfer)
+		{
+			_hs_state = I2C_HS_MASTER_CODE;
+			_working_byte = ((unsigned int24)_hs_master_code) << 16;
+		}
+	}
 
-	OnMatchA(NoChange);
-	OnMatchB(NoChange);
-	SetupMatchA(start_trans_time); // dummy match to jive w/ chan mode
-	SetupMatchB(start_trans_time);
-	_pulse_edge_next_timestamp = start_trans_time;
+	if (_bus_held)
+	{
+		// the previous transfer held the bus (SCL low, SDA released);
+		// continue with a repeated START instead
+		_bus_held = 0;
+		start_trans_time = tcr1;
 
-	// configure SCL_in channel
-	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
-	ClearTransLatch();
-	EnableEventHandling();
+		// set flags to go to FinishRepeatedStart state next
+		ClrFlag0();
+		SetFlag1();
+		ClearAllLatches();
+		EnableEventHandling();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(start_trans_time);
+		SetupMatchB(erta + _cur_tLOW);
+		_pulse_edge_next_timestamp = ertb;
 
-	// now, setup SDA_out
-	chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
-	OnMatchA(PinLow);
-	SetupMatchA(start_trans_time);
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		ClrFlag0();
+		SetFlag1();
+		ClearTransLatch();
+		EnableEventHandling();
+
+		// drop the hold timeout
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		DisableEventHandling();
+		ClearMatchALatch();
+		ClrFlag0();
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	}
+	else
+	{
+		_start_flag = 1;
+
+		// setup transfer start after (_tbuf) time
+		start_trans_time = tcr1 + _tBUF;
+
+		OnMatchA(NoChange);
+		OnMatchB(NoChange);
+		SetupMatchA(start_trans_time); // dummy match to jive w/ chan mode
+		SetupMatchB(start_trans_time);
+		_pulse_edge_next_timestamp = start_trans_time;
+
+		// configure SCL_in channel
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		ClearTransLatch();
+		EnableEventHandling();
+
+		// now, setup SDA_out
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		OnMatchA(PinLow);
+		SetupMatchA(start_trans_time);
+
+		// the bus is this master's own until its STOP; stop monitoring it
+		if (_multi_master)
+		{
+			chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+			DetectADisable();
+			ClearTransLatch();
+			chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+		}
+	}
+
+	// arm the timeouts on the SDA_in match; the transfer timeout runs from
+	// the START, the byte timeout is restarted at each ACK
+	if (_byte_timeout || _transfer_timeout)
+	{
+		int24 deadline;
+
+		_transfer_deadline = start_trans_time + _transfer_timeout;
+		deadline = _transfer_deadline;
+		if (_byte_timeout)
+		{
+			deadline = start_trans_time + _byte_timeout;
+			if (_transfer_timeout && ((int24)(_transfer_deadline - deadline) < 0))
+				deadline = _transfer_deadline;
+		}
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		ClearMatchALatch();
+		EnableEventHandling();
+		SetupMatchA(deadline);
+	}
+}
+
+// entered on SCL_out channel, from StartTransfer_fragment
+//
+// the transfer was aborted before its START; end it without touching the bus
+_eTPU_fragment I2C_master::AbortStart_fragment()
+{
+	_abort_request = 0;
+	_aborted = 1;
+	_abort_cmd_cnt = 0;
+	_abort_byte_cnt = 0;
+	_failed_cmd = ETPU_I2C_MASTER_NO_FAILED_CMD;
+	_failed_cnt = 0;
+	// disarm the transfer timeout of a deferred START
+	chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+	DisableEventHandling();
+	if (_multi_master)
+	{
+		// back to monitoring the bus for other masters
+		DisableMatch();
+		ClearAllLatches();
+		DetectAAnyEdge();
+		EnableEventHandling();
+	}
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	_in_use_flag = 0;
+	_result_seq++; // even - results stable
+	SetChannelInterrupt();
 }
 
 // entered on SCL_in channel, rising edge detected
@@ -200,8 +419,18 @@ _eTPU_fragment I2C_master::PulseClock_fragment()
 	ClearTransLatch();
 	if (_working_bit_count == 0)
 		SetFlag0(); // go to setup ack mode
-	if (erta - _pulse_edge_next_timestamp > _tr_max)
+	if (erta - _pulse_edge_next_timestamp > _cur_tr_max)
 		_pulse_edge_next_timestamp = erta;
+	// arbitration: a bit this master drove high must read back high at the
+	// rising edge, otherwise another master is driving SDA low
+	if (_arb_check)
+	{
+		_arb_check = 0;
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		if (!IsCurrentInputPinHigh())
+			ArbitrationLost_fragment(); // no return
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	}
 	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
 	// issue one clock pulse cycle
 	// also set up bit read or write, and see if we need to prep next byte
@@ -213,12 +442,23 @@ _eTPU_fragment I2C_master::PulseClock_fragment()
 
 		SetFlag0(); // go to setup ack mode
 
+		// an abort ends the transfer with this byte; a read byte is NACKed
+		if (_abort_request)
+		{
+			_abort_request = 0;
+			_aborted = 1;
+			_abort_cmd_cnt = _cmd_sent_cnt;
+			_abort_byte_cnt = _working_buf_size - _remaining_byte_count;
+			_remaining_byte_count = 0;
+			_addr10_state = I2C_ADDR10_NONE;
+		}
+
 		// setup clock cyle
 		OnMatchA(PinLow);
 		OnMatchB(PinHigh);
-		SetupMatchA(_pulse_edge_next_timestamp + _tHIGH);
+		SetupMatchA(_pulse_edge_next_timestamp + _cur_tHIGH);
 		bit_timestamp = erta;
-		SetupMatchB(erta + _tLOW);
+		SetupMatchB(erta + _cur_tLOW);
 		_pulse_edge_next_timestamp = ertb;
 
 		// process the final bit and/or prepare ack
@@ -227,7 +467,7 @@ _eTPU_fragment I2C_master::PulseClock_fragment()
 			// make sure we put out high so we can read ack from receiving slave
 			chan += ETPU_I2C_MASTER_SDA_OUT_OFFSET;
 			OnMatchA(PinHigh);
-			SetupMatchA(bit_timestamp + _tHD_DAT);
+			SetupMatchA(bit_timestamp + _cur_tHD_DAT);
 		}
 		else
 		{
@@ -236,7 +476,7 @@ _eTPU_fragment I2C_master::PulseClock_fragment()
 			OnMatchA(PinHigh); // default to nack (last byte of read)
 			if (_remaining_byte_count)
 				OnMatchA(PinLow); // ack
-			SetupMatchA(bit_timestamp + _tHD_DAT);
+			SetupMatchA(bit_timestamp + _cur_tHD_DAT);
 
 			// next, get last bit of read
 			chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
@@ -254,9 +494,9 @@ _eTPU_fragment I2C_master::PulseClock_fragment()
 		_working_bit_count--;
 		OnMatchA(PinLow);
 		OnMatchB(PinHigh);
-		SetupMatchA(_pulse_edge_next_timestamp + _tHIGH);
+		SetupMatchA(_pulse_edge_next_timestamp + _cur_tHIGH);
 		bit_timestamp = erta;
-		SetupMatchB(erta + _tLOW);
+		SetupMatchB(erta + _cur_tLOW);
 		_pulse_edge_next_timestamp = ertb;
 
 		// setup bit read/write
@@ -266,8 +506,11 @@ _eTPU_fragment I2C_master::PulseClock_fragment()
 			_working_byte <<= 1;
 			OnMatchA(PinLow);
 			if (CC.C)
+			{
 				OnMatchA(PinHigh);
-			SetupMatchA(bit_timestamp + _tHD_DAT);
+				_arb_check = _multi_master;
+			}
+			SetupMatchA(bit_timestamp + _cur_tHD_DAT);
 		}
 		else
 		{
@@ -290,6 +533,29 @@ _eTPU_thread I2C_master::PulseClockIgnore(_eTPU_matches_enabled)
 	{
 		unsigned int24 tmp = erta;
 		_start_flag = 0;
+		if (_retry_start)
+		{
+			// a retry with other masters on the bus (see RetryStart_fragment)
+			if (_bus_busy)
+			{
+				// another master took the bus during the retry interval; the
+				// START waits for its STOP (see MonitorStop)
+				_start_deferred = 1;
+				return;
+			}
+			_retry_start = 0;
+			// the bus is this master's own until its STOP; stop monitoring
+			// it, then make the START
+			chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+			DetectADisable();
+			ClearTransLatch();
+			chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+			SetPinLow();
+			chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+			ClearTransLatch();
+			EnableEventHandling();
+			chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		}
 		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
 		erta = tmp;
 		PulseClock_fragment(); // no return
@@ -311,21 +577,37 @@ _eTPU_thread I2C_master::ProcessAck(_eTPU_matches_enabled)
 	// - "load" next byte if not the last byte of transfer
 
 	ClearTransLatch();
-	if (erta - _pulse_edge_next_timestamp > _tr_max)
+	if (erta - _pulse_edge_next_timestamp > _cur_tr_max)
 		_pulse_edge_next_timestamp = erta;
 	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
 
-	// note : only care about ack val if NOT the last byte (or header byte)
-	if ((_read_write_flag == ETPU_I2C_WRITE_MESSAGE) && (_remaining_byte_count || !_working_buf_size))
+	// note : only care about ack val if NOT the last byte (or header byte, or
+	// a byte of a 10-bit address); the Hs-mode master code is never ACKed
+	if ((_read_write_flag == ETPU_I2C_WRITE_MESSAGE) && (_hs_state != I2C_HS_MASTER_CODE) &&
+		(_remaining_byte_count || !_working_buf_size || _addr10_state))
 	{
 		// read the ack
 		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
 		if (IsCurrentInputPinHigh())
 		{
-			_error_flags |= ETPU_I2C_MASTER_ACK_FAILED;
 			// make sure the transfer is stopped by zeroing byte count
 			_remaining_byte_count = 0;
-			//_cmd_sent_cnt = _cmd_cnt; // JDD - continue to next transfer (supports START byte)
+			_addr10_state = I2C_ADDR10_NONE;
+			// a command with retries left is issued again after a STOP (see
+			// FinishStop), unless the transfer is being aborted
+			if (!_aborted && (_cmd_attempts <= (_p_current_cmd->flags & ETPU_I2C_CMD_RETRY_MASK)))
+				_retry_pending = 1;
+			else
+			{
+				_error_flags |= ETPU_I2C_MASTER_ACK_FAILED;
+				if (!_failed_cnt)
+					_failed_cmd = _cmd_sent_cnt;
+				_failed_cnt++;
+				// per-command policy: continue to the next transfer (supports
+				// START byte, and lists spanning several devices) or stop
+				if (_p_current_cmd->flags & ETPU_I2C_CMD_NACK_STOP)
+					_nack_stop = 1;
+			}
 		}
 		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
 	}
@@ -343,19 +625,127 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 	ClearLSRLatch();
 
 	// handle delayed case - stretch the bit out some
-	timestamp = _pulse_edge_next_timestamp + _tHIGH;
+	timestamp = _pulse_edge_next_timestamp + _cur_tHIGH;
 	//if ((int24)(tcr1 - timestamp) > 0)
 	//	timestamp = tcr1;
 
-	// on to next byte or repeated START or STOP
-	if (_remaining_byte_count)
+	// restart the byte timeout, bounded by the transfer timeout
+	if (_byte_timeout)
+	{
+		int24 deadline = timestamp + _byte_timeout;
+
+		if (_transfer_timeout && ((int24)(_transfer_deadline - deadline) < 0))
+			deadline = _transfer_deadline;
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		SetupMatchA(deadline);
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	}
+
+	// on to Hs-mode, the second byte of a 10-bit address, next byte or
+	// repeated START or STOP
+	if ((_hs_state == I2C_HS_MASTER_CODE) && !_aborted)
+	{
+		// master code sent; Hs-mode begins with a repeated START (the same
+		// sequence as for combined format), and the header follows at Hs timing
+		ClrFlag0();
+		SetFlag1();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(erta + _cur_tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// make sure SDA_out goes high
+		chan += ETPU_I2C_MASTER_SDA_OUT_OFFSET;
+		OnMatchA(PinHigh);
+		SetupMatchA(timestamp + _cur_tHD_DAT);
+
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		ClrFlag0();
+		SetFlag1();
+
+		_hs_state = I2C_HS_ACTIVE;
+		I2C_HS_TIMING();
+
+		// the header the master code stood in for (written first if 10-bit)
+		_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 16;
+		if (_addr10_state)
+			_working_byte &= ~(((unsigned int24)ETPU_I2C_RW_MASK) << 16);
+		_working_bit_count = 8;
+		_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
+	}
+	else if (_addr10_state == I2C_ADDR10_LOW_BYTE)
+	{
+		unsigned int24 addr_low;
+
+		// setup the first clock pulse of the second address byte
+		ClrFlag0();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(erta + _cur_tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// a read goes on with a repeated START and the header, R/W set
+		_addr10_state = I2C_ADDR10_NONE;
+		if (_working_buf_read_write_flag == ETPU_I2C_READ_MESSAGE)
+			_addr10_state = I2C_ADDR10_RSTART;
+		_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		addr_low = _p_current_cmd->addr10_low;
+		_working_byte = addr_low << 17;
+		OnMatchA(PinLow);
+		if (CC.C)
+		{
+			OnMatchA(PinHigh);
+			_arb_check = _multi_master;
+		}
+		SetupMatchA(timestamp + _cur_tHD_DAT);
+
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		ClrFlag0();
+
+		_working_bit_count = 7; // 7 because one bit will have already gone out
+	}
+	else if (_addr10_state == I2C_ADDR10_RSTART)
+	{
+		// read form of a 10-bit address: repeated START, then the header
+		// again with R/W set; the command is not finished, so the command
+		// count is left alone
+
+		// create a repeated START
+
+		// set flags to go to FinishRepeatedStart state next
+		ClrFlag0();
+		SetFlag1();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(erta + _cur_tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// make sure SDA_out goes high
+		chan += ETPU_I2C_MASTER_SDA_OUT_OFFSET;
+		OnMatchA(PinHigh);
+		SetupMatchA(timestamp + _cur_tHD_DAT);
+
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		ClrFlag0();
+		SetFlag1();
+
+		_addr10_state = I2C_ADDR10_NONE;
+		_working_byte = ((unsigned int24)(_p_current_cmd->header | ETPU_I2C_READ_MESSAGE)) << 16;
+		_working_bit_count = 8;
+		_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
+	}
+	else if (_remaining_byte_count)
 	{
 		// setup the first clock pulse of the next byte
 		ClrFlag0();
 		OnMatchA(PinLow);
 		OnMatchB(PinHigh);
 		SetupMatchA(timestamp);
-		SetupMatchB(erta + _tLOW);
+		SetupMatchB(erta + _cur_tLOW);
 		_pulse_edge_next_timestamp = ertb;
 
 		_read_write_flag = _working_buf_read_write_flag;
@@ -365,8 +755,11 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 			_working_byte = *_p_working_buf << 17;
 			OnMatchA(PinLow);
 			if (CC.C)
+			{
 				OnMatchA(PinHigh);
-			SetupMatchA(timestamp + _tHD_DAT);
+				_arb_check = _multi_master;
+			}
+			SetupMatchA(timestamp + _cur_tHD_DAT);
 			_p_working_buf++;
 		}
 		else
@@ -374,7 +767,7 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 			//_working_byte = 0;
 			// make sure SDA_out goes high
 			OnMatchA(PinHigh);
-			SetupMatchA(timestamp + _tHD_DAT);
+			SetupMatchA(timestamp + _cur_tHD_DAT);
 		}
 
 		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
@@ -384,9 +777,10 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 		_working_bit_count = 7; // 7 because one bit will have already gone out/in
 
 	}
-	else if (++_cmd_sent_cnt < _cmd_cnt)
+	else if (!_aborted && !_retry_pending && !_nack_stop && (++_cmd_sent_cnt < _cmd_cnt))
 	{
-		// combined format; issue repeated start and set up to read/write next buffer
+		// combined format; issue repeated start and set up to read/write
+		// next buffer
 
 		// create a repeated START
 
@@ -396,13 +790,13 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 		OnMatchA(PinLow);
 		OnMatchB(PinHigh);
 		SetupMatchA(timestamp);
-		SetupMatchB(erta + _tLOW);
+		SetupMatchB(erta + _cur_tLOW);
 		_pulse_edge_next_timestamp = ertb;
 
 		// make sure SDA_out goes high
 		chan += ETPU_I2C_MASTER_SDA_OUT_OFFSET;
 		OnMatchA(PinHigh);
-		SetupMatchA(timestamp + _tHD_DAT);
+		SetupMatchA(timestamp + _cur_tHD_DAT);
 
 		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
 		ClrFlag0();
@@ -410,15 +804,57 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 
 		// setup header & message for the next transfer
 		_p_current_cmd++;
+		if (_attempts != 0xff)
+			_attempts++;
+		_cmd_attempts = 1;
+		_cur_retry_interval = _retry_interval;
 		_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 16;
 		_working_bit_count = 8;
-		_p_working_buf = _p_current_cmd->p_buffer; // always points to next byte
+		_p_working_buf = (unsigned int8*)_p_current_cmd->p_buffer; // always points to next byte
 		_working_buf_read_write_flag = _p_current_cmd->header & 1;
 		_working_buf_size = _p_current_cmd->size;
-		_remaining_byte_count = _p_current_cmd->size;
+		_addr10_state = I2C_ADDR10_NONE;
+		if (_p_current_cmd->flags & ETPU_I2C_CMD_ADDR10)
+		{
+			_working_byte &= ~(((unsigned int24)ETPU_I2C_RW_MASK) << 16);
+			_addr10_state = I2C_ADDR10_LOW_BYTE;
+		}
+		_remaining_byte_count = _working_buf_size;
 		_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
 
 	}
+	else if (_hold_active && !_aborted && !_retry_pending && !_nack_stop)
+	{
+		// hold the bus for a following transfer instead of issuing a STOP;
+		// SCL is left low after the ACK and SDA released
+		DisableEventHandling();
+		OnMatchA(PinLow);
+		SetupMatchA(timestamp);
+
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		OnMatchA(PinHigh);
+		SetupMatchA(timestamp + _cur_tHD_DAT);
+
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		DisableEventHandling();
+
+		// trade the transfer timeouts for the hold timeout
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		DisableEventHandling();
+		ClearMatchALatch();
+		if (_hold_timeout)
+		{
+			SetFlag0();
+			EnableEventHandling();
+			SetupMatchA(timestamp + _hold_timeout);
+		}
+
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+		_bus_held = 1;
+		_in_use_flag = 0;
+		_result_seq++; // even - results stable
+		SetChannelInterrupt();
+	}
 	else
 	{
 		// issue STOP
@@ -428,14 +864,14 @@ _eTPU_thread I2C_master::ProcessAck_Step2(_eTPU_matches_enabled)
 		OnMatchA(PinLow);
 		OnMatchB(PinHigh);
 		SetupMatchA(timestamp);
-		SetupMatchB(erta + _tLOW);
+		SetupMatchB(erta + _cur_tLOW);
 		_pulse_edge_next_timestamp = ertb;
 
 		// set up SDA_out for STOP
 		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
 		OnMatchA(PinLow);
 		//OnMatchB(PinHigh);
-		SetupMatchA(timestamp + _tHD_DAT);
+		SetupMatchA(timestamp + _cur_tHD_DAT);
 		//SetupMatchB(timestamp + _tLOW + _tSU_STO);
 
 		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
@@ -474,7 +910,7 @@ _eTPU_thread I2C_master::BeginStop(_eTPU_matches_enabled)
 	// wait additional time until SDA_out signal has completed the stop
 	OnMatchA(PinHigh);
 	OnMatchB(PinHigh);
-	SetupMatchA(_pulse_edge_next_timestamp + _tSU_STO);
+	SetupMatchA(_pulse_edge_next_timestamp + _cur_tSU_STO);
 	SetupMatchB(erta);
 	st_timestamp = erta;
 	// finish off SDA_out
@@ -491,13 +927,130 @@ _eTPU_thread I2C_master::FinishStop(_eTPU_matches_enabled)
 {
 	ClearMatchALatch();
 	ClearMatchBLatch();
+	// Hs-mode ends with the STOP
+	if (_hs_state == I2C_HS_ACTIVE)
+		I2C_FS_TIMING();
+	_hs_state = I2C_HS_NONE;
+	if (_retry_pending)
+		RetryCommand_fragment(); // no return
+	// disarm the timeouts
+	chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+	DisableEventHandling();
+	if (_multi_master)
+	{
+		// back to monitoring the bus for other masters
+		DisableMatch();
+		ClearAllLatches();
+		DetectAAnyEdge();
+		EnableEventHandling();
+	}
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
 	// now fully done with transfer, can issue interrupt
 	_in_use_flag = 0;
+	_result_seq++; // even - results stable
 	ClrFlag0();
 	ClrFlag1();
 	SetChannelInterrupt();
 }
 
+// entered on SCL_out channel, from FinishStop
+//
+// the current command was NACKed with retries left; issue it again from a
+// START once the bus has been free for the retry interval.  The transfer
+// timeout keeps running across retries; the byte timeout restarts.
+_eTPU_fragment I2C_master::RetryCommand_fragment()
+{
+	_retry_pending = 0;
+	if (_attempts != 0xff)
+		_attempts++;
+	_cmd_attempts++;
+
+	// setup header byte transfer and prepare for rest of message
+	_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 16;
+	_working_bit_count = 8;
+	_p_working_buf = (unsigned int8*)_p_current_cmd->p_buffer; // always points to next byte
+	_working_buf_read_write_flag = _p_current_cmd->header & 1;
+	_working_buf_size = _p_current_cmd->size;
+	_addr10_state = I2C_ADDR10_NONE;
+	if (_p_current_cmd->flags & ETPU_I2C_CMD_ADDR10)
+	{
+		// 10-bit address: the header goes out as a write, followed by the
+		// second address byte
+		_working_byte &= ~(((unsigned int24)ETPU_I2C_RW_MASK) << 16);
+		_addr10_state = I2C_ADDR10_LOW_BYTE;
+	}
+	_remaining_byte_count = _working_buf_size;
+	_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
+
+	// the STOP ended Hs-mode; enter it again with the master code
+	if (_hs_transfer)
+	{
+		_hs_state = I2C_HS_MASTER_CODE;
+		_working_byte = ((unsigned int24)_hs_master_code) << 16;
+	}
+
+	_pulse_edge_next_timestamp = tcr1 + _tBUF + _cur_retry_interval;
+	if (_p_current_cmd->flags & ETPU_I2C_CMD_RETRY_BACKOFF)
+	{
+		// the next retry of this command waits twice as long
+		if (_cur_retry_interval < 0x400000)
+			_cur_retry_interval <<= 1;
+		else
+			_cur_retry_interval = 0x7fffff; // half the TCR1 range
+	}
+	RetryStart_fragment(); // no return
+}
+// entered on SCL_out channel, from RetryCommand_fragment, or from
+// MonitorStop for a retry that waited for another master's STOP
+//
+// schedule the START of the retry at _pulse_edge_next_timestamp.  With
+// other masters on the bus, the bus is monitored until then and the START
+// is made by PulseClockIgnore, only if the bus is still free.
+_eTPU_fragment I2C_master::RetryStart_fragment()
+{
+	int24 start_trans_time = _pulse_edge_next_timestamp;
+
+	_start_flag = 1;
+	ClrFlag0();
+	ClrFlag1();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	SetupMatchA(start_trans_time); // dummy match to jive w/ chan mode
+	SetupMatchB(start_trans_time);
+
+	if (_multi_master)
+	{
+		// the STOP freed the bus; watch it for other masters until the
+		// START, which PulseClockIgnore makes if the bus is still free
+		_retry_start = 1;
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		ClearTransLatch();
+		DetectAAnyEdge();
+		EnableEventHandling();
+	}
+	else
+	{
+		// configure SCL_in channel
+		chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		ClearTransLatch();
+		EnableEventHandling();
+
+		// now, setup SDA_out
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		OnMatchA(PinLow);
+		SetupMatchA(start_trans_time);
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+	}
+	if (_byte_timeout)
+	{
+		int24 deadline = start_trans_time + _byte_timeout;
+
+		if (_transfer_timeout && ((int24)(_transfer_deadline - deadline) < 0))
+			deadline = _transfer_deadline;
+		SetupMatchA(deadline);
+	}
+}
+
 // entered on SCL_in channel, rising edge detected
 // flag 0 = 0
 // flag 1 = 1
@@ -515,7 +1068,7 @@ _eTPU_thread I2C_master::FinishRepeatedStart(_eTPU_matches_enabled)
 	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
 
 	int24 rs_timestamp;
-	rs_timestamp = _pulse_edge_next_timestamp + _tSU_STA;
+	rs_timestamp = _pulse_edge_next_timestamp + _cur_tSU_STA;
 
 	// switch to normal bit mode (PulseClock handler)
 	ClrFlag0();
@@ -543,6 +1096,405 @@ _eTPU_thread I2C_master::FinishRepeatedStartIgnore(_eTPU_matches_enabled)
 }
 
 
+// entered on SDA_in channel, match A
+// flag 0 = 0
+//
+// a byte or the whole transfer has run past its timeout, most likely because
+// a device is holding SCL low, or another master kept the bus busy; abandon
+// the transfer and, if the master was driving the bus, end it with a STOP
+// through the bus recovery (RecoverBus_fragment), which reports completion
+_eTPU_thread I2C_master::Timeout(_eTPU_matches_enabled)
+{
+	int24 bus_driven;
+
+	DisableEventHandling();
+	ClearAllLatches();
+	// a transfer (or retry) deferred for a busy bus never drove it and is
+	// simply dropped
+	bus_driven = !(_start_deferred || _retry_start);
+	_start_deferred = 0;
+	_retry_start = 0;
+	if (_multi_master && !bus_driven)
+	{
+		DetectAAnyEdge();
+		EnableEventHandling();
+	}
+
+	// cancel any pending edges and release SCL; SDA stays as it is, so it
+	// can only rise with SCL high - a STOP
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	SetPinHigh();
+	ClrFlag0();
+	ClrFlag1();
+
+	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+	DisableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+
+	chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	OnMatchA(NoChange);
+
+	_start_flag = 0;
+	if (_hs_state == I2C_HS_ACTIVE)
+		I2C_FS_TIMING();
+	_hs_state = I2C_HS_NONE;
+	_error_flags |= ETPU_I2C_MASTER_TIMEOUT;
+	if (bus_driven)
+	{
+		// releases SDA after the bus free time, clocks it free if a slave
+		// still drives it, then generates a full STOP; BUS_STUCK is added
+		// if SCL is still held low
+		_recover_then_start = 0;
+		RecoverBus_fragment(); // no return
+	}
+
+	_in_use_flag = 0;
+	_result_seq++; // even - results stable
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+	SetChannelInterrupt();
+}
+
+// entered on SDA_in channel, HSR 3
+//
+// host is done with a held bus; end it with a STOP
+_eTPU_thread I2C_master::ReleaseBus(_eTPU_matches_enabled)
+{
+	if (_bus_held)
+		ReleaseHold_fragment(); // no return
+}
+
+// entered on SDA_in channel, match A
+// flag 0 = 1
+//
+// the host did not continue or release a held bus in time
+_eTPU_thread I2C_master::HoldExpired(_eTPU_matches_enabled)
+{
+	_error_flags |= ETPU_I2C_MASTER_HOLD_TIMEOUT;
+	ReleaseHold_fragment();
+}
+// entered on SDA_in channel, with the bus held (SCL low, SDA released)
+//
+// generate the STOP the held transfer left out; FinishStop reports
+// completion as for any transfer
+_eTPU_fragment I2C_master::ReleaseHold_fragment()
+{
+	int24 timestamp;
+
+	DisableEventHandling();
+	ClearMatchALatch();
+	ClrFlag0();
+	_bus_held = 0;
+	_in_use_flag = 1;
+	_result_seq++; // odd - results now being updated
+
+	// same STOP sequence as at the end of a transfer (see ProcessAck_Step2)
+	timestamp = tcr1;
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	SetFlag0();
+	SetFlag1();
+	OnMatchA(PinLow);
+	OnMatchB(PinHigh);
+	SetupMatchA(timestamp);
+	SetupMatchB(erta + _cur_tLOW);
+	_pulse_edge_next_timestamp = ertb;
+
+	chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+	OnMatchA(PinLow);
+	SetupMatchA(timestamp + _cur_tHD_DAT);
+
+	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+	SetFlag0();
+	SetFlag1();
+	ClearTransLatch();
+	EnableEventHandling();
+}
+
+// entered on SDA_in channel, HSR 4
+//
+// abort requested; the transfer in progress (if any) is ended with a STOP
+// at the next byte boundary (see PulseClock_fragment)
+_eTPU_thread I2C_master::AbortTransfer(_eTPU_matches_enabled)
+{
+	if (_in_use_flag)
+		_abort_request = 1;
+}
+
+// entered on SDA_in channel, from PulseClock_fragment
+//
+// another master won arbitration; stop driving the bus at once and leave it
+// to the winner, whose STOP frees it again (see MonitorStop)
+_eTPU_fragment I2C_master::ArbitrationLost_fragment()
+{
+	// drop the timeouts and go back to monitoring the bus
+	DisableMatch();
+	ClearAllLatches();
+	ClrFlag0();
+	DetectAAnyEdge();
+	EnableEventHandling();
+	_bus_busy = 1;
+
+	// cancel any pending edges and let both lines go high
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	SetPinHigh();
+	ClrFlag0();
+	ClrFlag1();
+
+	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+	DisableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+
+	chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	OnMatchA(NoChange);
+	SetPinHigh();
+
+	_start_flag = 0;
+	// (normally lost on the master code, before Hs-mode)
+	if (_hs_state == I2C_HS_ACTIVE)
+		I2C_FS_TIMING();
+	_hs_state = I2C_HS_NONE;
+	_error_flags |= ETPU_I2C_MASTER_ARB_LOST;
+	_in_use_flag = 0;
+	_result_seq++; // even - results stable
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+	SetChannelInterrupt();
+}
+
+
+// multi-master bus monitoring
+// NOTE: the SDA edge is classified by the SCL level when the thread runs, so
+// it must be serviced before SCL rises after a data change (within _tLOW less
+// the data hold time of the other master); for eTPU2, could use PRSS instead
+
+// entered on SDA_in channel, transition detected with pin low
+// flag 0 = 0
+//
+// SDA falling while SCL is high is a START by another master
+_eTPU_thread I2C_master::MonitorStart(_eTPU_matches_enabled)
+{
+	ClearTransLatch();
+	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	if (IsCurrentInputPinHigh())
+		_bus_busy = 1;
+}
+
+// entered on SDA_in channel, transition detected with pin high
+// flag 0 = 0
+//
+// SDA rising while SCL is high is a STOP; issue a transfer deferred for the
+// busy bus, its START following after the bus free time
+_eTPU_thread I2C_master::MonitorStop(_eTPU_matches_enabled)
+{
+	ClearTransLatch();
+	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	if (IsCurrentInputPinHigh())
+	{
+		_bus_busy = 0;
+		if (_start_deferred)
+		{
+			_start_deferred = 0;
+			chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+			if (_retry_start)
+			{
+				_pulse_edge_next_timestamp = tcr1 + _tBUF;
+				RetryStart_fragment(); // no return
+			}
+			StartTransfer_fragment(); // no return
+		}
+	}
+}
+
+
+// entered on SDA_out channel, HSR 4
+//
+// bus recovery requested; clock out any slave holding SDA low, then STOP
+_eTPU_thread I2C_master::RecoverBus(_eTPU_matches_enabled)
+{
+	// the bus cannot be recovered underneath a transfer, while held, or
+	// while another master is using it
+	if (_in_use_flag || _bus_held || _bus_busy)
+	{
+		// set busy error, issue interrupt, & exit
+		_error_flags |= ETPU_I2C_MASTER_BUSY;
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		SetChannelInterrupt();
+		return;
+	}
+	_in_use_flag = 1;
+	_result_seq++; // odd - results now being updated
+	_recover_then_start = 0;
+	RecoverBus_fragment(); // no return
+}
+// entered on SDA_out channel, with _in_use_flag already set
+//
+// the SDA_out channel matches time the recovery; its event handling is
+// only enabled while a recovery runs
+_eTPU_fragment I2C_master::RecoverBus_fragment()
+{
+	_recovery_clocks = 0;
+	_recovery_state = I2C_RECOVERY_CLOCKING;
+	I2C_FS_TIMING();
+
+	// the recovery's own STOP is not another master's
+	if (_multi_master)
+	{
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		DetectADisable();
+		ClearTransLatch();
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	}
+
+	// release SDA and look at the bus after the bus free time
+	ClrFlag0();
+	ClearAllLatches();
+	EnableEventHandling();
+	OnMatchA(PinHigh);
+	SetupMatchA(tcr1 + _tBUF);
+}
+
+// entered on SDA_out channel, match A
+// flag 0 = 0
+//
+// SCL is high; check the bus and either clock once more or begin the STOP
+_eTPU_thread I2C_master::RecoverClock(_eTPU_matches_enabled)
+{
+	int24 timestamp;
+
+	ClearMatchALatch();
+
+	// nothing the master can do if another device holds SCL low
+	chan += (ETPU_I2C_MASTER_SCL_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+	if (!IsCurrentInputPinHigh())
+	{
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+		_error_flags |= ETPU_I2C_MASTER_BUS_STUCK;
+		_recovery_state = I2C_RECOVERY_FAILED;
+		RecoverDone_fragment(); // no return
+	}
+
+	chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_IN_OFFSET);
+	if (IsCurrentInputPinHigh())
+	{
+		// SDA is free - form a STOP
+		// SDA : --\_______/--
+		// SCL : -\_____/-----
+		timestamp = tcr1;
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(timestamp + _cur_tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		SetFlag0();
+		_recovery_state = I2C_RECOVERY_STOP_SDA_LOW;
+		OnMatchA(PinLow);
+		SetupMatchA(timestamp + _cur_tHD_DAT);
+	}
+	else if (_recovery_clocks >= ETPU_I2C_MASTER_RECOVERY_MAX_CLOCKS)
+	{
+		// slave did not let go of SDA
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+		_error_flags |= ETPU_I2C_MASTER_BUS_STUCK;
+		_recovery_state = I2C_RECOVERY_FAILED;
+		RecoverDone_fragment(); // no return
+	}
+	else
+	{
+		// one more clock pulse; check again at the end of its high time
+		_recovery_clocks++;
+		timestamp = tcr1;
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(timestamp + _cur_tLOW);
+
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		OnMatchA(NoChange);
+		SetupMatchA(timestamp + _cur_tLOW + _cur_tHIGH);
+	}
+}
+
+// entered on SDA_out channel, match A
+// flag 0 = 1
+//
+// step through the STOP, then confirm the bus is free
+_eTPU_thread I2C_master::RecoverStop(_eTPU_matches_enabled)
+{
+	ClearMatchALatch();
+	if (_recovery_state == I2C_RECOVERY_STOP_SDA_LOW)
+	{
+		// SDA low; release it once SCL has been high for the STOP setup time
+		_recovery_state = I2C_RECOVERY_STOP_SDA_HIGH;
+		_pulse_edge_next_timestamp += _cur_tSU_STO;
+		OnMatchA(PinHigh);
+		SetupMatchA(_pulse_edge_next_timestamp);
+	}
+	else if (_recovery_state == I2C_RECOVERY_STOP_SDA_HIGH)
+	{
+		// STOP complete; check the bus after the bus free time
+		_recovery_state = I2C_RECOVERY_STOP_DONE;
+		OnMatchA(NoChange);
+		SetupMatchA(_pulse_edge_next_timestamp + _tBUF);
+	}
+	else
+	{
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+		if (!IsCurrentInputPinHigh())
+		{
+			_error_flags |= ETPU_I2C_MASTER_BUS_STUCK;
+			_recovery_state = I2C_RECOVERY_FAILED;
+		}
+		chan += (ETPU_I2C_MASTER_SDA_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+		RecoverDone_fragment(); // no return
+	}
+}
+// entered on SDA_out channel
+//
+// end the recovery; go on to the requested transfer if it triggered the
+// recovery and the bus is now free, otherwise report completion
+_eTPU_fragment I2C_master::RecoverDone_fragment()
+{
+	DisableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_OUT_OFFSET);
+	if (_recover_then_start)
+	{
+		_recover_then_start = 0;
+		if (_recovery_state != I2C_RECOVERY_FAILED)
+			StartTransfer_fragment(); // no return
+	}
+	if (_multi_master)
+	{
+		chan += (ETPU_I2C_MASTER_SDA_IN_OFFSET - ETPU_I2C_MASTER_SCL_OUT_OFFSET);
+		ClearTransLatch();
+		DetectAAnyEdge();
+		chan += (ETPU_I2C_MASTER_SCL_OUT_OFFSET - ETPU_I2C_MASTER_SDA_IN_OFFSET);
+	}
+	_in_use_flag = 0;
+	_result_seq++; // even - results stable
+	SetChannelInterrupt();
+}
+
+
 // define entry table for I2C clock out channel
 // note: ETPD is a don't care, and is set to input to be compatible with
 // all MCUs
@@ -633,7 +1585,7 @@ DEFINE_ENTRY_TABLE(I2C_master, I2C_SDA_out, standard, inputpin, autocfsr)
 	ETPU_VECTOR1(1,  x,  x, x, 1,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(2,  x,  x, x, x,  x, x, Shutdown),
 	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, _Error_handler_entry),
-	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, RecoverBus),
 	ETPU_VECTOR1(5,  x,  x, x, x,  x, x, _Error_handler_entry),
 	ETPU_VECTOR1(6,  x,  x, x, x,  x, x, _Error_handler_entry),
 	ETPU_VECTOR1(7,  x,  x, x, x,  x, x, InitSDA_out),
@@ -643,10 +1595,10 @@ DEFINE_ENTRY_TABLE(I2C_master, I2C_SDA_out, standard, inputpin, autocfsr)
 	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, RecoverClock),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, RecoverStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, RecoverClock),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, RecoverStop),
 	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
@@ -670,24 +1622,24 @@ DEFINE_ENTRY_TABLE(I2C_master, I2C_SDA_in, standard, inputpin, autocfsr)
 	ETPU_VECTOR1(1,  x,  x, x, 1,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(1,  x,  x, x, 1,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(2,  x,  x, x, x,  x, x, Shutdown),
-	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, _Error_handler_entry),
-	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, ReleaseBus),
+	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, AbortTransfer),
 	ETPU_VECTOR1(5,  x,  x, x, x,  x, x, _Error_handler_entry),
 	ETPU_VECTOR1(6,  x,  x, x, x,  x, x, _Error_handler_entry),
 	ETPU_VECTOR1(7,  x,  x, x, x,  x, x, InitSDA_in),
 	ETPU_VECTOR1(0,  1,  1, 1, x,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  1,  1, 1, x,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  0, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  0, x, MonitorStart),
 	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, MonitorStop),
 	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, Timeout),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, HoldExpired),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, Timeout),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, HoldExpired),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, Timeout),
 	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, Timeout),
 	ETPU_VECTOR1(0,  0,  1, 1, 1,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  1,  0, 0, 0,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  1,  0, 0, 0,  1, x, _Error_handler_entry),
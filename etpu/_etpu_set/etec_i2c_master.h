@@ -40,10 +40,55 @@
 * repeated START sequences separating each command.  Each command in the command list
 * has the following form (total 8 bytes):
 *   ----------------------------------------------
-*   | header byte |    pointer to data buffer    |
+*   | header byte |  addr10 |  ptr to data buffer |
 *   ----------------------------------------------
-*   |   unused    |   size of transfer in bytes  |
+*   |    flags    |   size of transfer in bytes  |
 *   ----------------------------------------------
+* addr10 and flags are 0 for a plain command.  The low nibble of the flags
+* (ETPU_I2C_CMD_RETRY_MASK) is the number of times the command is retried when the
+* slave NACKs its header or a written byte: a STOP is generated and, after _tBUF +
+* _retry_interval, the command is issued again from a START, so a busy device (e.g.
+* an EEPROM mid-write) does not need the host to resubmit.  ETPU_I2C_CMD_RETRY_BACKOFF
+* doubles the interval at each retry of that command.
+* ETPU_I2C_MASTER_ACK_FAILED is only set once the retries are used up; the command
+* has then failed, and ETPU_I2C_CMD_NACK_POLICY_MASK selects whether the list goes on
+* to the next command (ETPU_I2C_CMD_NACK_CONTINUE, the original behavior) or ends
+* with a STOP (ETPU_I2C_CMD_NACK_STOP).  A failed command is never followed by a bus
+* hold under the stop policy.
+*
+* ETPU_I2C_CMD_ADDR10 in the flags selects a 10-bit slave address.  The header byte
+* is then the 11110 A9 A8 R/W first byte, and addr10 holds the second address byte
+* (A7-A0).  The header is sent as a write, followed by the second address byte; for
+* a read the driver then issues a repeated START and the header again with R/W set,
+* and reads the data.  A slave
+* addressed that way stays addressed until the STOP, so a command that follows in
+* the same list may use the short read form: a plain (not ETPU_I2C_CMD_ADDR10)
+* command with the 11110 A9 A8 1 header.
+*
+* Hs-mode: a transfer started with _hs_request set first sends _hs_master_code at
+* the F/S timing.  No device acknowledges the master code; its NACK is not an error
+* and, under multi-master, arbitration on it is as for any header.  The driver then
+* issues a repeated START, switches its working timing to the _hs_xxx profile, and
+* runs the command list at Hs timing, from the repeated START's setup time through
+* the STOP.  The F/S timing is back in place once the STOP completes (or the
+* transfer times out or loses arbitration); a held bus stays in Hs-mode, the
+* continuing transfer going straight on at Hs timing.  Both profiles are host
+* inputs the eTPU only reads: each transfer start (and bus recovery) copies the
+* profile in use into working fields, so a timing change takes effect with the
+* next transfer.  A NACK retry starts over
+* with the master code.
+*   The bit rate the eTPU can sustain is set by its thread load, not the timing
+* inputs: each bit costs a PulseClock thread on the SCL_in rising edge and a
+* PulseClockIgnore thread on the SCL_out match, both of which must complete within
+* the following SCL high time, and the 9th bit adds ProcessAck/ProcessAck_Step2.
+* Add the worst case thread lengths (see the ETEC analysis file) of the PulseClock
+* pair, plus those of any other channel at the same or higher priority, and check
+* them against _hs_tHIGH at the TCR1/system clock in use.  A dedicated engine
+* running only this master at the highest priority sustains on the order of 1 MHz
+* at a 200 MHz system clock; the full 3.4 MHz Hs rate is out of reach of a 2-thread
+* per bit design.  The eTPU cannot switch the pad driver, so a push-pull SCL (no
+* slave clock stretching, single Hs master) must be set up by the host in the pad
+* configuration; the master then drives SCL exactly as in open-drain mode.
 *
 * Basic state flow:
 *   State 1 (Idle) : totally quiescent, waiting for start transfer HSR to transition
@@ -57,14 +102,78 @@
 *           read from a slave device, writes the ACK/NACK bit.  To reduce WCTL, this
 *           state is broken into two threads.  If there are more bytes to read/write,
 *           the function returns to the PulseClock state, otherwise it moves to the
-*           states to generated a repeated START or STOP.
+*           states to generated a repeated START or STOP.  The second byte of a
+*           10-bit address, and the repeated START of a 10-bit read, are issued
+*           from here too (_addr10_state).
 *   State 4 (BeginStop) : setup the SDA output to go high while the SCL output
 *           is already high, in order to form the STOP.  Goes to FinishStop next.
 *   State 5 (FinishStop) : STOP fully complete; host can request another transfer.
-*           Returns to Idle.
+*           Returns to Idle, unless a NACKed command is to be retried, in which case
+*           its START is scheduled and the transfer continues.
 *   State 6 (FinishRepeatedStart) : sets up SCL and SDA outputs to generate the repeated
 *           START sequence.  Goes to PulseClock state next.
 *
+* Timeouts (SDA_in channel):
+*   Timeout : the SDA_in match is armed while a transfer runs, at the earlier of the
+*           byte deadline (restarted at each ACK) and the transfer deadline.  If it
+*           is reached - typically a device holding SCL low - the transfer is
+*           abandoned and ETPU_I2C_MASTER_TIMEOUT is set.  SCL is released at once
+*           and SDA left as it is; a bus recovery (RecoverBus) then releases SDA,
+*           clocks it free if needed and generates the STOP, adding
+*           ETPU_I2C_MASTER_BUS_STUCK if it fails, and issues the channel
+*           interrupt.  A transfer that timed out before its START never drove
+*           the bus and ends at once.
+*
+* Abort (SDA_in channel):
+*   AbortTransfer : entered by HSR.  Ignored when no transfer is in progress, otherwise
+*           sets a request that the next PulseClock ACK setup acts on: that byte is
+*           the last (a read byte is NACKed), no further commands are issued, and
+*           the transfer ends with a STOP as usual.  _aborted, _abort_cmd_cnt and
+*           _abort_byte_cnt report where it stopped.  A transfer aborted while its
+*           START waits (for a busy bus or a bus recovery) ends without a START.
+*
+* Bus hold (SDA_in channel):
+*   A transfer started with _hold_request set ends without a STOP: after the last
+*   ACK, SCL is left low and SDA released, _bus_held is set and the channel interrupt
+*   is issued as at the end of any transfer.  No other master can start while SCL is
+*   held.  The next start transfer request continues with a repeated START instead of
+*   a START (it may itself request a hold), or the host ends the hold with a STOP:
+*   ReleaseBus : entered by HSR; generates the STOP, ignored if the bus is not held.
+*   HoldExpired : the SDA_in match, armed at the hold for _hold_timeout if non-zero.
+*           Sets ETPU_I2C_MASTER_HOLD_TIMEOUT and generates the STOP.
+*   An aborted transfer always ends with a STOP.  Bus recovery is refused while the
+*   bus is held.
+*
+* Multi-master (SCL_in, SDA_in channels, _multi_master set):
+*   Arbitration : at each SCL rising edge of a header or written data bit that this
+*           master drove high, SDA_in is checked.  If it reads low another master has
+*           won; this master releases both lines at once, sets ETPU_I2C_MASTER_ARB_LOST
+*           and ends the transfer with the channel interrupt.  Clock synchronization
+*           relies on the existing SCL rising edge (stretch) tracking.
+*   MonitorStart/MonitorStop : while this master is not using the bus, SDA_in detects
+*           both edges.  An SDA edge with SCL high is a START (falling) or STOP
+*           (rising) of another master, and sets or clears _bus_busy.  A transfer
+*           requested while _bus_busy is deferred until the STOP, its START then
+*           following after _tBUF; a deferred transfer times out (TIMEOUT) if the bus
+*           stays busy past _transfer_timeout.  The bus is taken to be free at
+*           initialization, and a START by another master within the _tBUF before
+*           this master's own START is left to arbitration.  The bus is monitored
+*           during a NACK retry interval too; a retry whose START falls while the bus
+*           is busy waits for the STOP in the same way, and _tBUF after it.
+*           Bus recovery is refused while the bus is busy.
+*
+* Bus recovery (SDA_out channel, idle only):
+*   RecoverBus : entered by HSR, from StartTransfer when _auto_recover is set and
+*           SDA is found low, or from Timeout.  Releases SDA and checks the bus
+*           after _tBUF.
+*   RecoverClock : fails if SCL is held low.  While SDA is low, issues one SCL clock
+*           and checks again at the end of its high time, up to
+*           ETPU_I2C_MASTER_RECOVERY_MAX_CLOCKS clocks.  Once SDA is high, drives
+*           SDA low during an SCL low time to set up a STOP.
+*   RecoverStop : releases SDA _tSU_STO after SCL goes high (the STOP), then checks
+*           SDA is high after _tBUF.  An automatically triggered recovery continues
+*           with the requested transfer; otherwise the channel interrupt is issued.
+*
 * ------------
 *
 * Interfaces for the I2C class:
@@ -72,8 +181,11 @@
 *    Host Service Requests
 *
 *       HSR 2 : Shutdown (all channels)
+*       HSR 3 : Release held bus (SDA_in channel)
 *       HSR 4 : Start transfer request (SCL_out channel)
 *       HSR 4 : Latch and clear error flags (SCL_in channel)
+*       HSR 4 : Bus recovery (SDA_out channel)
+*       HSR 4 : Abort transfer (SDA_in channel)
 *       HSR 7 : Initialization (all channels)
 *
 *    Function Modes
@@ -89,6 +201,14 @@
 *          (0,1) => issue repeated START
 *          (1,1) => issue STOP
 *
+*       SDA_out channel (flag0)
+*          0 => bus recovery: clocking out SDA
+*          1 => bus recovery: generating the STOP
+*
+*       SDA_in channel (flag0)
+*          0 => match is the byte/transfer timeout; transitions are bus monitoring
+*          1 => match is the bus hold timeout
+*
 *    Data (Channel Frame)
 *
 *       Inputs
@@ -118,6 +238,38 @@
 *          unsigned int8	_cmd_cnt;
 *             The number of commands in the command buffer.  A value of 2 or mroe indicates
 *             a combined format transfer will be generated.
+*          unsigned int24	_byte_timeout;
+*             Maximum time for one byte (9 clocks, including any clock stretching), or
+*             0 for no limit.
+*          unsigned int24	_transfer_timeout;
+*             Maximum time for a complete transfer from its START, or 0 for no limit.
+*             Both timeouts must be less than half the TCR1 range.
+*          unsigned int8	_auto_recover;
+*             When non-zero, a transfer request that finds SDA held low first runs a bus
+*             recovery, and issues the transfer only if the recovery succeeds.
+*          unsigned int8	_hold_request;
+*             Set by the host before a start transfer request to end that transfer
+*             without a STOP, holding the bus.  Cleared when the transfer starts.
+*          unsigned int24	_retry_interval;
+*             Extra bus free time before a NACKed command is retried.  For a command
+*             flagged ETPU_I2C_CMD_RETRY_BACKOFF, the first retry; each further retry
+*             waits twice as long as the one before (capped at half the TCR1 range).
+*          unsigned int24	_hold_timeout;
+*             Maximum time the bus is held before a STOP is forced, or 0 for no limit.
+*             Must be less than half the TCR1 range.
+*          unsigned int8	_multi_master;
+*             When non-zero, the bus is shared with other masters: arbitration is
+*             checked and a START is deferred while another master owns the bus.
+*             Read by the initialization HSR.
+*          unsigned int24	_hs_tLOW, _hs_tHIGH, _hs_tSU_STA, _hs_tSU_STO, _hs_tHD_DAT, _hs_tr_max;
+*             Hs-mode timing profile, as the F/S inputs above.  Copied into the working
+*             timing when a transfer enters Hs-mode.
+*          unsigned int8	_hs_master_code;
+*             Master code sent before an Hs-mode transfer (ETPU_I2C_HS_MASTER_CODE or'ed
+*             with the master id).
+*          unsigned int8	_hs_request;
+*             Set by the host before a start transfer request to run that transfer in
+*             Hs-mode.  Cleared when the transfer starts.
 *
 *       Outputs
 *
@@ -130,6 +282,34 @@
 *             Set of error flags (0 if none).  This is a copy of the running _error_flags
 *             made when requested by HSR.  The HSR provides a method of coherently reading
 *             and clearing the running _error_flags variable from the host.
+*          unsigned int24	_result_seq;
+*             Result sequence counter.  Odd while a transfer is in progress (or while the
+*             error flags are being latched), even once the results (read data, error
+*             flags, _in_use_flag) are stable.  The host reads it before and after reading
+*             any set of results; if it was odd or changed, the snapshot is retried.
+*          unsigned int8	_recovery_clocks;
+*             Number of SCL clocks issued by the last bus recovery (0 if SDA was not
+*             held low).  ETPU_I2C_MASTER_BUS_STUCK is set in _error_flags if the
+*             recovery failed.
+*          unsigned int8	_aborted;
+*             Non-zero if the last transfer was ended early by an abort request.
+*          unsigned int8	_abort_cmd_cnt;
+*             Number of commands completed before the aborted one.
+*          unsigned int24	_abort_byte_cnt;
+*             Number of data bytes of the aborted command that were transferred (the
+*             last one, if written, may not have been ACKed).
+*          unsigned int8	_bus_held;
+*             Non-zero while a held transfer has left the bus held.
+*          unsigned int8	_attempts;
+*             Number of attempts made by all the commands issued in the last transfer:
+*             one per command, plus one per retry (saturating at 255).
+*          unsigned int8	_failed_cmd;
+*             Index in the command list of the first command that failed (NACKed after
+*             any retries), or ETPU_I2C_MASTER_NO_FAILED_CMD.
+*          unsigned int8	_failed_cnt;
+*             Number of commands of the last transfer that failed.
+*          unsigned int8	_bus_busy;
+*             Multi-master only: non-zero between a START and a STOP of another master.
 *
 *       Internal State
 *
@@ -144,7 +324,9 @@
 typedef struct
 {
 	unsigned int8 header;
-	unsigned int8* p_buffer;
+	unsigned int8 addr10_low;
+	unsigned int16 p_buffer;
+	unsigned int8 flags;
 	unsigned int24 size;
 } I2C_cmd;
 
@@ -174,6 +356,37 @@ private:
 
 	unsigned int24		_start_flag; // used for state control when issuing START
 
+	unsigned int24		_transfer_deadline; // TCR1 time the transfer timeout expires
+
+	unsigned int8		_recovery_state; // bus recovery progress/outcome
+	unsigned int8		_recover_then_start; // recovery triggered by StartTransfer
+
+	unsigned int8		_abort_request; // abort HSR received, not yet acted on
+
+	unsigned int8		_hold_active; // current transfer ends holding the bus
+
+	unsigned int8		_retry_pending; // current command NACKed, to be retried
+	unsigned int8		_cmd_attempts; // attempts made by the current command
+	unsigned int24		_cur_retry_interval; // wait before its next retry
+	unsigned int8		_nack_stop; // a failed command ends the list
+
+	unsigned int8		_addr10_state; // 10-bit address bytes still to be sent
+
+	unsigned int8		_arb_check; // bit being clocked was driven high (multi-master)
+	unsigned int8		_start_deferred; // transfer waiting for another master's STOP
+	unsigned int8		_retry_start; // next START is a retry's, made on a free bus
+
+	unsigned int8		_hs_transfer; // current transfer runs in Hs-mode
+	unsigned int8		_hs_state; // master code sent / Hs timing in use
+
+	// working timing: the F/S or the Hs-mode profile, whichever is in use
+	unsigned int24		_cur_tLOW;
+	unsigned int24		_cur_tHIGH;
+	unsigned int24		_cur_tSU_STA;
+	unsigned int24		_cur_tSU_STO;
+	unsigned int24		_cur_tHD_DAT;
+	unsigned int24		_cur_tr_max;
+
 public:
 
 	// user inputs
@@ -201,6 +414,33 @@ public:
 	I2C_cmd*			_p_cmd_list;
 	unsigned int8		_cmd_cnt;
 
+	// byte and transfer timeouts (0 = none)
+	unsigned int24		_byte_timeout;
+	unsigned int24		_transfer_timeout;
+
+	// run a bus recovery before a transfer if SDA is held low
+	unsigned int8		_auto_recover;
+
+	// extra bus free time before a NACKed command is retried
+	unsigned int24		_retry_interval;
+
+	// end the next transfer holding the bus (no STOP); hold timeout (0 = none)
+	unsigned int8		_hold_request;
+	unsigned int24		_hold_timeout;
+
+	// share the bus with other masters: arbitration, START/STOP monitoring
+	unsigned int8		_multi_master;
+
+	// Hs-mode timing profile and master code; run the next transfer in Hs-mode
+	unsigned int24		_hs_tLOW;
+	unsigned int24		_hs_tHIGH;
+	unsigned int24		_hs_tSU_STA;
+	unsigned int24		_hs_tSU_STO;
+	unsigned int24		_hs_tHD_DAT;
+	unsigned int24		_hs_tr_max;
+	unsigned int8		_hs_master_code;
+	unsigned int8		_hs_request;
+
 
 	// user outputs
 
@@ -208,10 +448,42 @@ public:
 	unsigned int8		_error_flags;
 	unsigned int8		_latched_error_flags;
 
+	// odd while results are being updated, even when stable
+	unsigned int24		_result_seq;
+
+	// clocks issued by the last bus recovery
+	unsigned int8		_recovery_clocks;
+
+	// where the last transfer stopped, if it was aborted
+	unsigned int8		_aborted;
+	unsigned int8		_abort_cmd_cnt;
+	unsigned int24		_abort_byte_cnt;
+
+	// a held transfer has left SCL low, awaiting continue or release
+	unsigned int8		_bus_held;
+
+	// attempts made by all commands of the transfer
+	unsigned int8		_attempts;
+
+	// first failed command (ETPU_I2C_MASTER_NO_FAILED_CMD if none), and count
+	unsigned int8		_failed_cmd;
+	unsigned int8		_failed_cnt;
+
+	// multi-master: another master owns the bus
+	unsigned int8		_bus_busy;
+
 
 	// methods/fragments
 
     _eTPU_fragment PulseClock_fragment();
+    _eTPU_fragment StartTransfer_fragment();
+    _eTPU_fragment AbortStart_fragment();
+    _eTPU_fragment RecoverBus_fragment();
+    _eTPU_fragment RecoverDone_fragment();
+    _eTPU_fragment ReleaseHold_fragment();
+    _eTPU_fragment RetryCommand_fragment();
+    _eTPU_fragment RetryStart_fragment();
+    _eTPU_fragment ArbitrationLost_fragment();
 
 	// threads
 
@@ -226,6 +498,12 @@ public:
 	_eTPU_thread StartTransfer(_eTPU_matches_enabled);
 	// host request to latch errors and clear the running error flag state
 	_eTPU_thread LatchAndClearErrorFlags(_eTPU_matches_enabled);
+	// host request to clear a stuck bus (SDA_out)
+	_eTPU_thread RecoverBus(_eTPU_matches_enabled);
+	// host request to end the current transfer early (SDA_in)
+	_eTPU_thread AbortTransfer(_eTPU_matches_enabled);
+	// host request to end a held bus with a STOP (SDA_in)
+	_eTPU_thread ReleaseBus(_eTPU_matches_enabled);
 
 	// work threads
 	_eTPU_thread PulseClock(_eTPU_matches_enabled);
@@ -237,6 +515,12 @@ public:
 	_eTPU_thread FinishStop(_eTPU_matches_enabled);
 	_eTPU_thread FinishRepeatedStart(_eTPU_matches_enabled);
 	_eTPU_thread FinishRepeatedStartIgnore(_eTPU_matches_enabled);
+	_eTPU_thread Timeout(_eTPU_matches_enabled);
+	_eTPU_thread HoldExpired(_eTPU_matches_enabled);
+	_eTPU_thread RecoverClock(_eTPU_matches_enabled);
+	_eTPU_thread RecoverStop(_eTPU_matches_enabled);
+	_eTPU_thread MonitorStart(_eTPU_matches_enabled);
+	_eTPU_thread MonitorStop(_eTPU_matches_enabled);
 
 
 	// entry tables
@@ -0,0 +1,303 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_monitor.c
+*
+* DESCRIPTION: I2C bus monitor eTPU function(s)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:  Implementation of the passive I2C bus monitor (multiple eTPU
+* functions).  See the header file etec_i2c_monitor.h for more details.
+*
+**************************************************************************/
+
+// verify proper version of compiler toolset is used
+#pragma verify_version GE, "2.01A", "use ETEC version 2.01A or newer"
+// verify this code uses no stack
+#pragma verify_memory_size STACK 0x00 bytes
+
+#include <ETpu_Std.h>
+
+// include common defintions
+#include "etpu_i2c_common.h"
+// include class declaration
+#include "etec_i2c_monitor.h"
+
+/* provide hint that channel frame base addr same on all chans touched by func */
+#pragma same_channel_frame_base I2C_monitor
+
+
+// master channel   = SCL_in
+// master channel+1 = SDA_in
+
+
+// no interrupts are generated; the host polls the ring
+
+
+// entered on SCL_in channel, HSR 7
+_eTPU_thread I2C_monitor::InitSCL_in(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	DisableOutputBuffer(); // no output
+	OnMatchA(NoChange);  // Needed so output pin does not get toggled
+	OnMatchB(NoChange);  // Needed so output pin does not get toggled
+	DetectAAnyEdge();
+	DetectBDisable();
+	SingleMatchSingleTransition();
+	EnableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	// wait for a START
+	_state = I2C_MONITOR_MODE_IDLE;
+	_working_bit_cnt = 0;
+	_working_byte = 0;
+}
+
+// entered on SDA_in channel, HSR 7
+_eTPU_thread I2C_monitor::InitSDA_in(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	DisableOutputBuffer(); // no output
+	OnMatchA(NoChange);  // Needed so output pin does not get toggled
+	OnMatchB(NoChange);  // Needed so output pin does not get toggled
+	// an edge seen while SCL is low just turns detection off until SCL rises
+	DetectAAnyEdge();
+	DetectBDisable();
+	SingleMatchSingleTransition();
+	EnableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+}
+
+// entered on all channels, HSR 2
+_eTPU_thread I2C_monitor::Shutdown(_eTPU_matches_disabled)
+{
+	DisableEventHandling();
+	DetectADisable();
+	ClearAllLatches();
+}
+
+
+// entered on SCL_in channel, rising edge
+// flag 0 = x
+// flag 1 = x
+_eTPU_thread I2C_monitor::SclRising(_eTPU_matches_disabled)
+{
+	unsigned int24 edge_time = erta;
+	ClearTransLatch();
+	// an SDA edge while SCL is high is a START or STOP
+	chan += (ETPU_I2C_MONITOR_SDA_IN_OFFSET - ETPU_I2C_MONITOR_SCL_IN_OFFSET);
+	DetectAAnyEdge();
+	ClearTransLatch();
+	if (_state == I2C_MONITOR_MODE_IDLE)
+		return; // not in a transfer
+	// read SDA_in
+	_working_byte <<= 1;
+	if (IsCurrentInputPinHigh())
+		_working_byte |= 1;
+	if (_working_bit_cnt == 0)
+		_byte_time = edge_time;
+	_working_bit_cnt++;
+	if (_working_bit_cnt == 9)
+	{
+		// 8 data bits and the ACK (low) / NACK (high) bit
+		if (_state == I2C_MONITOR_MODE_HEADER)
+			_rec_type = ETPU_I2C_MONITOR_REC_HEADER;
+		else
+			_rec_type = ETPU_I2C_MONITOR_REC_DATA;
+		if (_working_byte & 1)
+			_rec_type |= ETPU_I2C_MONITOR_REC_NACK;
+		_rec_time = _byte_time;
+		_rec_data = (_working_byte >> 1) & 0xff;
+		_rec_ack_time = edge_time;
+		_state = I2C_MONITOR_MODE_DATA;
+		_working_bit_cnt = 0;
+		_working_byte = 0;
+		AppendRecord_fragment(); // no return
+	}
+}
+
+// entered on SCL_in channel, falling edge
+// flag 0 = x
+// flag 1 = x
+_eTPU_thread I2C_monitor::SclFalling(_eTPU_matches_disabled)
+{
+	ClearTransLatch();
+	// SDA may now change freely
+	chan += (ETPU_I2C_MONITOR_SDA_IN_OFFSET - ETPU_I2C_MONITOR_SCL_IN_OFFSET);
+	DetectADisable();
+	ClearTransLatch();
+}
+
+// entered on SDA_in channel, falling edge
+// flag 0 = x
+// flag 1 = x
+_eTPU_thread I2C_monitor::FoundStart(_eTPU_matches_disabled)
+{
+	unsigned int24 edge_time = erta;
+	ClearTransLatch();
+	chan += (ETPU_I2C_MONITOR_SCL_IN_OFFSET - ETPU_I2C_MONITOR_SDA_IN_OFFSET);
+	if (CurrentInputPin == 0)
+	{
+		// a data change after SCL fell, before SclFalling ran
+		chan += (ETPU_I2C_MONITOR_SDA_IN_OFFSET - ETPU_I2C_MONITOR_SCL_IN_OFFSET);
+		DetectADisable();
+		ClearTransLatch();
+		return;
+	}
+	if (_state == I2C_MONITOR_MODE_IDLE)
+		_rec_type = ETPU_I2C_MONITOR_REC_START;
+	else
+		_rec_type = ETPU_I2C_MONITOR_REC_RSTART;
+	_state = I2C_MONITOR_MODE_HEADER;
+	_working_bit_cnt = 0;
+	_working_byte = 0;
+	_rec_time = edge_time;
+	_rec_data = 0;
+	_rec_ack_time = 0;
+	AppendRecord_fragment(); // no return
+}
+
+// entered on SDA_in channel, rising edge
+// flag 0 = x
+// flag 1 = x
+_eTPU_thread I2C_monitor::FoundStop(_eTPU_matches_disabled)
+{
+	unsigned int24 edge_time = erta;
+	ClearTransLatch();
+	chan += (ETPU_I2C_MONITOR_SCL_IN_OFFSET - ETPU_I2C_MONITOR_SDA_IN_OFFSET);
+	if (CurrentInputPin == 0)
+	{
+		// a data change after SCL fell, before SclFalling ran
+		chan += (ETPU_I2C_MONITOR_SDA_IN_OFFSET - ETPU_I2C_MONITOR_SCL_IN_OFFSET);
+		DetectADisable();
+		ClearTransLatch();
+		return;
+	}
+	// also logged without a preceding START, e.g. after joining a busy bus
+	_state = I2C_MONITOR_MODE_IDLE;
+	_working_bit_cnt = 0;
+	_working_byte = 0;
+	_rec_type = ETPU_I2C_MONITOR_REC_STOP;
+	_rec_time = edge_time;
+	_rec_data = 0;
+	_rec_ack_time = 0;
+	AppendRecord_fragment(); // no return
+}
+
+// write _rec_xxx to the ring at _ring_head, unless the ring is full
+// (may be called on either channel)
+_eTPU_fragment I2C_monitor::AppendRecord_fragment()
+{
+	I2C_monitor_record* p_rec;
+	unsigned int24 next = _ring_head + 1;
+	if (next >= _ring_size)
+		next = 0;
+	if (next == _ring_tail)
+	{
+		// the host has fallen behind; drop the record
+		_overflow_cnt++;
+	}
+	else
+	{
+		p_rec = _p_ring + _ring_head;
+		p_rec->type = (unsigned int8)_rec_type;
+		p_rec->timestamp = _rec_time;
+		p_rec->data = (unsigned int8)_rec_data;
+		p_rec->ack_time = _rec_ack_time;
+		// publish the record only once it is complete
+		_ring_head = next;
+	}
+}
+
+
+// define entry table for I2C clock in channel
+DEFINE_ENTRY_TABLE(I2C_monitor, I2C_SCL_in, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSCL_in),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, SclFalling),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, SclFalling),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, SclFalling),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, SclFalling),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, SclRising),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, SclRising),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, SclRising),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, SclRising),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+};
+
+// define entry table for I2C data in channel
+DEFINE_ENTRY_TABLE(I2C_monitor, I2C_SDA_in, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSDA_in),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, FoundStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, FoundStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, FoundStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, FoundStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, FoundStop),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, FoundStop),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, FoundStop),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, FoundStop),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+};
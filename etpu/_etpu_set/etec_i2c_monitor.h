@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_monitor.h
+*
+* DESCRIPTION: I2C bus monitor class declaration
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:
+*   This ETEC class, which consists of 2 entry tables and a number of threads,
+* provides a passive I2C bus monitor for the eTPU.  It never drives the bus; it
+* only watches the SCL and SDA wires through 2 consecutive input channels and
+* logs the traffic it decodes into a ring buffer in SDM for the host to drain.
+*
+*   base channel   ---------------- SCL
+*   base channel+1 ---------------- SDA
+*
+* Basic state flow:
+*   SDA_in edge detection is only enabled while SCL is high, which is the only
+*   time an SDA edge is a bus condition rather than a data change.
+*   SclRising : reads a data bit (header, data or ACK/NACK) and enables the SDA_in
+*           edge detection.  On the ninth bit a byte record is logged.  Bits are
+*           ignored while no transfer is in progress.
+*   SclFalling : disables the SDA_in edge detection.
+*   FoundStart : SDA falling edge while SCL is high.  Logs a START, or a repeated
+*           START if a transfer was in progress; the next byte is a header.
+*   FoundStop : SDA rising edge while SCL is high.  Logs a STOP.
+*
+*   The STOP/repeated START clock pulse is counted as the first bit of a new byte
+*   and discarded once the condition is seen, as is any byte cut short by one.
+*
+*   NOTE: the SCL level is sampled when an SDA_in thread runs, and SDA_in edge
+*   detection is enabled when the SCL rising edge thread runs.  This requires
+*   the monitor threads to be serviced within tSU;STA/tSU;STO (600 ns at
+*   400 kHz) of an SCL rising edge and within the SCL low time of a data change.
+*
+*   Records are appended at _ring_head; the host consumes them from _ring_tail.
+*   When the ring is full new records are dropped and counted in _overflow_cnt,
+*   so the records the host does see are always in order.  One slot is always
+*   left empty, so the ring holds _ring_size - 1 records.
+*
+* ------------
+*
+* Interfaces for the I2C monitor class:
+*
+*    Host Service Requests
+*
+*       HSR 2 : Shutdown (all channels)
+*       HSR 7 : Initialization (all channels)
+*
+*    Function Modes
+*
+*       FM0, FM1 not used
+*
+*    Flags
+*
+*       not used
+*
+*    Ring Records
+*
+*       I2C_monitor_record, 8 bytes each (byte offsets in etpu_i2c_common.h):
+*          type      - ETPU_I2C_MONITOR_REC_xxx; ETPU_I2C_MONITOR_REC_NACK is
+*                      or'ed into a header or data byte record that was NACKed
+*          timestamp - TCR1 at the SDA edge of a START/repeated START/STOP, or at
+*                      the first SCL rising edge of a byte
+*          data      - the header or data byte, else 0
+*          ack_time  - TCR1 at the ACK/NACK SCL rising edge of a byte, else 0
+*
+*    Data (Channel Frame)
+*
+*       Inputs
+*
+*          I2C_monitor_record*	_p_ring;
+*             The ring buffer, in SDM.  Must be 8-byte aligned.
+*          unsigned int24		_ring_size;
+*             The number of records in the ring (at least 2).
+*          unsigned int24		_ring_tail;
+*             Index of the oldest record the host has not yet consumed; updated
+*             by the host as it drains the ring.
+*
+*       Outputs
+*
+*          unsigned int24		_ring_head;
+*             Index of the next record to be written.  The ring is empty when it
+*             equals _ring_tail.  A record is complete before _ring_head moves
+*             past it.
+*          unsigned int24		_overflow_cnt;
+*             The number of records dropped because the ring was full.
+*
+*       Internal State
+*
+*          (see below)
+*
+*
+**************************************************************************/
+
+#ifndef __ETEC_I2C_MONITOR_H
+#define __ETEC_I2C_MONITOR_H
+
+typedef struct
+{
+	unsigned int8 type;
+	unsigned int24 timestamp;
+	unsigned int8 data;
+	unsigned int24 ack_time;
+} I2C_monitor_record;
+
+enum I2C_MONITOR_MODE
+{
+	I2C_MONITOR_MODE_IDLE,
+	I2C_MONITOR_MODE_HEADER,
+	I2C_MONITOR_MODE_DATA,
+};
+
+_eTPU_class I2C_monitor
+{
+	// channel frame
+
+private:
+
+	// internal state
+
+	enum I2C_MONITOR_MODE	_state;
+
+	unsigned int24		_working_byte;
+	unsigned int24		_working_bit_cnt;
+	unsigned int24		_byte_time;
+
+	// record being appended
+	unsigned int24		_rec_type;
+	unsigned int24		_rec_time;
+	unsigned int24		_rec_data;
+	unsigned int24		_rec_ack_time;
+
+public:
+
+	// user inputs
+
+	I2C_monitor_record*	_p_ring;
+	unsigned int24		_ring_size;
+	unsigned int24		_ring_tail; // updated by the host
+
+
+	// user outputs
+
+	unsigned int24		_ring_head;
+	unsigned int24		_overflow_cnt;
+
+
+	// methods/fragments
+
+	_eTPU_fragment AppendRecord_fragment();
+
+	// threads
+
+	// initialize/shutdown
+	_eTPU_thread InitSCL_in(_eTPU_matches_disabled);
+	_eTPU_thread InitSDA_in(_eTPU_matches_disabled);
+	_eTPU_thread Shutdown(_eTPU_matches_disabled);
+
+	// SCL_in threads
+	_eTPU_thread SclRising(_eTPU_matches_disabled);
+	_eTPU_thread SclFalling(_eTPU_matches_disabled);
+
+	// SDA_in threads
+	_eTPU_thread FoundStart(_eTPU_matches_disabled);
+	_eTPU_thread FoundStop(_eTPU_matches_disabled);
+
+
+	// entry tables
+
+	_eTPU_entry_table I2C_SCL_in;
+	_eTPU_entry_table I2C_SDA_in;
+};
+
+#endif
@@ -0,0 +1,655 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_multilane.c
+*
+* DESCRIPTION: I2C multi-lane master eTPU function(s)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:  Implementation of the I2C master that clocks several SDA lanes
+* from one SCL (multiple eTPU functions).  See the header file
+* etec_i2c_multilane.h for more details.
+*
+**************************************************************************/
+
+// verify proper version of compiler toolset is used
+#pragma verify_version GE, "2.01A", "use ETEC version 2.01A or newer"
+// verify this code uses no stack
+#pragma verify_memory_size STACK 0x00 bytes
+
+#include <ETpu_Std.h>
+
+// include common defintions
+#include "etpu_i2c_common.h"
+// include class declaration
+#include "etec_i2c_multilane.h"
+
+/* provide hint that channel frame base addr same on all chans touched by func */
+#pragma same_channel_frame_base I2C_multilane
+
+
+// in this I2C solution, the channels are defined as follows:
+// base channel             = SCL_out
+// base channel + 1         = SCL_in
+// base channel + 2 + 2 * n = SDA_out of lane n
+// base channel + 3 + 2 * n = SDA_in of lane n
+
+// every SCL_in thread runs on the rising edge of a clock and schedules the
+// next falling and rising edges, along with the SDA change of every lane
+// between them; the lane loops run on the channels of lane 0 upwards
+
+// set up a command for transfer, starting with its header
+#define I2C_ML_LOAD_CMD() \
+	_p_working_buf = _p_current_cmd->p_buffer; \
+	_working_buf_size = _p_current_cmd->size; \
+	_remaining_byte_count = _working_buf_size; \
+	_write_stride = 0; \
+	if (_p_current_cmd->flags & ETPU_I2C_CMD_LANE_DATA) \
+		_write_stride = _lane_stride; \
+	_read_write_flag = ETPU_I2C_WRITE_MESSAGE; \
+	_working_bit_mask = 0x80; \
+	_cmd_lane_nack = 0;
+
+// entered on SCL_in, at a rising edge; account for clock stretching
+#define I2C_ML_SCL_RISEN() \
+	ClearTransLatch(); \
+	if (erta - _pulse_edge_next_timestamp > _tr_max) \
+		_pulse_edge_next_timestamp = erta;
+
+// on SCL_out; schedule the falling edge high_time after the rising edge, and
+// the next rising edge, and note when the SDA lanes may change
+#define I2C_ML_CLOCK_CYCLE(high_time, sda_timestamp) \
+	SetupMatchA(_pulse_edge_next_timestamp + (high_time)); \
+	sda_timestamp = erta + _tHD_DAT; \
+	SetupMatchB(erta + _tLOW); \
+	_pulse_edge_next_timestamp = ertb;
+
+
+// entered on SCL_out channel, HSR 7
+_eTPU_thread I2C_multilane::InitSCL_out(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	EnableOutputBuffer();
+	SetPinHigh();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	DetectADisable();
+	DetectBDisable();
+	MatchBOrderedSingleTransition();
+	DisableEventHandling(); // the clock is serviced on SCL_in
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	_in_use_flag = 0;
+}
+
+// entered on SCL_in channel, HSR 7
+_eTPU_thread I2C_multilane::InitSCL_in(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	DisableOutputBuffer(); // no output
+	OnMatchA(NoChange);  // Needed so output pin does not get toggled
+	OnMatchB(NoChange);  // Needed so output pin does not get toggled
+	DetectARisingEdge(); // one thread per clock, and clock stretching support
+	DetectBDisable();
+	SingleMatchSingleTransition();
+	DisableEventHandling(); // enabled while a transfer is in progress
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+}
+
+// entered on SDA_out channels, HSR 7
+_eTPU_thread I2C_multilane::InitSDA_out(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	EnableOutputBuffer();
+	SetPinHigh();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	DetectADisable();
+	DetectBDisable();
+	EitherMatchNonBlockingSingleTransition();
+	DisableEventHandling(); // only enabled on lane 0 for the end of the STOP
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+}
+
+// entered on SDA_in channels, HSR 7
+_eTPU_thread I2C_multilane::InitSDA_in(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	DisableOutputBuffer(); // no output
+	OnMatchA(NoChange);  // Needed so output pin does not get toggled
+	OnMatchB(NoChange);  // Needed so output pin does not get toggled
+	DetectADisable();
+	DetectBDisable();
+	SingleMatchSingleTransition();
+	DisableEventHandling(); // sampled from the SCL_in threads
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+}
+
+// entered on all channels, HSR 2
+_eTPU_thread I2C_multilane::Shutdown(_eTPU_matches_disabled)
+{
+	DisableEventHandling();
+	SetPinHigh();
+	DisableOutputBuffer();
+}
+
+// entered on SCL_out channel, HSR 4
+//
+// message transfer requested; issue a START on every lane and set up the first
+// header bit
+_eTPU_thread I2C_multilane::StartTransfer(_eTPU_matches_enabled)
+{
+	// SDA : ----\_______
+	// SCL : --------\___
+
+	int24 start_trans_time;
+	int24 sda_timestamp;
+	unsigned int8 base_chan;
+	unsigned int8 header;
+	unsigned int8 lane;
+
+	// the host interface does not start a transfer while one is in progress
+	if (_in_use_flag)
+		return;
+	_in_use_flag = 1;
+	_lane_nack = 0;
+
+	_p_current_cmd = _p_cmd_list;
+	_cmd_sent_cnt = 0;
+	I2C_ML_LOAD_CMD();
+	header = _p_current_cmd->header;
+
+	// SDA falls after the bus free time, SCL after tHIGH more
+	base_chan = chan - ETPU_I2C_MULTILANE_SCL_OUT_OFFSET;
+	start_trans_time = tcr1 + _tBUF;
+	ClearAllLatches();
+	OnMatchA(PinLow);
+	OnMatchB(PinHigh);
+	_pulse_edge_next_timestamp = start_trans_time;
+	I2C_ML_CLOCK_CYCLE(_tHIGH, sda_timestamp);
+
+	// the rising edges on SCL_in drive the transfer from here
+	chan = base_chan + ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+	ClrFlag0();
+	ClrFlag1();
+	ClearTransLatch();
+	EnableEventHandling();
+
+	// every lane: the START on match A; the first header bit on match B, the
+	// rest of the bits on match A again
+	chan = base_chan + ETPU_I2C_MULTILANE_SDA_OUT_OFFSET;
+	lane = 0;
+	do
+	{
+		_lane_byte[lane] = header;
+		ClearAllLatches();
+		OnMatchA(PinLow);
+		SetupMatchA(start_trans_time);
+		OnMatchB(PinLow);
+		if (header & 0x80)
+			OnMatchB(PinHigh);
+		SetupMatchB(sda_timestamp);
+		chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+	} while (++lane < _lane_cnt);
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 0
+// flag 1 = 0
+//
+// a header or data bit is being clocked; sample it on every lane if reading,
+// and set up the next bit, or after the eighth bit the ACK slot
+_eTPU_thread I2C_multilane::DataBit(_eTPU_matches_enabled)
+{
+	int24 sda_timestamp;
+	unsigned int8 base_chan;
+	unsigned int8 lane;
+	unsigned int8 lane_bit;
+
+	I2C_ML_SCL_RISEN();
+	base_chan = chan - ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+
+	if (_read_write_flag == ETPU_I2C_READ_MESSAGE)
+	{
+		// read bit now, on every lane!
+		chan = base_chan + ETPU_I2C_MULTILANE_SDA_IN_OFFSET;
+		lane = 0;
+		do
+		{
+			if (IsCurrentInputPinHigh())
+				_lane_byte[lane] |= _working_bit_mask;
+			chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+		} while (++lane < _lane_cnt);
+	}
+
+	chan = base_chan + ETPU_I2C_MULTILANE_SCL_OUT_OFFSET;
+	I2C_ML_CLOCK_CYCLE(_tHIGH, sda_timestamp);
+
+	chan = base_chan + ETPU_I2C_MULTILANE_SDA_OUT_OFFSET;
+	lane = 0;
+	lane_bit = 1;
+	if (_working_bit_mask == 1)
+	{
+		// all 8 bits clocked; the ACK slot is next
+		chan = base_chan + ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+		SetFlag0();
+		chan = base_chan + ETPU_I2C_MULTILANE_SDA_OUT_OFFSET;
+		if (_read_write_flag == ETPU_I2C_READ_MESSAGE)
+		{
+			unsigned int8* p_buf = _p_working_buf;
+
+			// save off the newly read bytes; ACK on every lane that is still
+			// addressed, unless this was the last byte
+			do
+			{
+				*p_buf = _lane_byte[lane];
+				p_buf += _lane_stride;
+				OnMatchA(PinHigh);
+				if (_remaining_byte_count && !(_cmd_lane_nack & lane_bit))
+					OnMatchA(PinLow);
+				SetupMatchA(sda_timestamp);
+				lane_bit <<= 1;
+				chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+			} while (++lane < _lane_cnt);
+			_p_working_buf++;
+		}
+		else
+		{
+			// put out high so we can read the acks from the receiving slaves
+			do
+			{
+				OnMatchA(PinHigh);
+				SetupMatchA(sda_timestamp);
+				chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+			} while (++lane < _lane_cnt);
+		}
+	}
+	else
+	{
+		_working_bit_mask >>= 1;
+		// a read leaves SDA released
+		if (_read_write_flag == ETPU_I2C_WRITE_MESSAGE)
+		{
+			do
+			{
+				OnMatchA(PinHigh);
+				if (!(_cmd_lane_nack & lane_bit) && !(_lane_byte[lane] & _working_bit_mask))
+					OnMatchA(PinLow);
+				SetupMatchA(sda_timestamp);
+				lane_bit <<= 1;
+				chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+			} while (++lane < _lane_cnt);
+		}
+	}
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 1
+// flag 1 = 0
+//
+// ninth clock of a byte; check the ACKs, then on to the next data byte,
+// repeated START or STOP
+_eTPU_thread I2C_multilane::AckBit(_eTPU_matches_enabled)
+{
+	int24 sda_timestamp;
+	unsigned int8 base_chan;
+	unsigned int8 lane;
+	unsigned int8 lane_bit;
+
+	I2C_ML_SCL_RISEN();
+	base_chan = chan - ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+	ClrFlag0();
+
+	// note : as for the I2C master, only care about the ack if NOT the last
+	// byte written (or the header)
+	if ((_read_write_flag == ETPU_I2C_WRITE_MESSAGE) &&
+		(_remaining_byte_count || !_working_buf_size))
+	{
+		// read the acks; a lane that NACKs is released for the rest of the
+		// command
+		chan = base_chan + ETPU_I2C_MULTILANE_SDA_IN_OFFSET;
+		lane = 0;
+		lane_bit = 1;
+		do
+		{
+			if (IsCurrentInputPinHigh())
+				_cmd_lane_nack |= lane_bit;
+			lane_bit <<= 1;
+			chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+		} while (++lane < _lane_cnt);
+		_lane_nack |= _cmd_lane_nack;
+		// nothing left to transfer once every lane has NACKed
+		if (_cmd_lane_nack == (unsigned int8)(lane_bit - 1))
+			_remaining_byte_count = 0;
+	}
+
+	chan = base_chan + ETPU_I2C_MULTILANE_SCL_OUT_OFFSET;
+	I2C_ML_CLOCK_CYCLE(_tHIGH, sda_timestamp);
+
+	chan = base_chan + ETPU_I2C_MULTILANE_SDA_OUT_OFFSET;
+	lane = 0;
+	lane_bit = 1;
+	if (_remaining_byte_count)
+	{
+		// first bit of the next data byte
+		_remaining_byte_count--;
+		_read_write_flag = _p_current_cmd->header & ETPU_I2C_RW_MASK;
+		_working_bit_mask = 0x80;
+		if (_read_write_flag == ETPU_I2C_WRITE_MESSAGE)
+		{
+			unsigned int8* p_buf = _p_working_buf;
+
+			do
+			{
+				_lane_byte[lane] = *p_buf;
+				p_buf += _write_stride;
+				OnMatchA(PinHigh);
+				if (!(_cmd_lane_nack & lane_bit) && !(_lane_byte[lane] & 0x80))
+					OnMatchA(PinLow);
+				SetupMatchA(sda_timestamp);
+				lane_bit <<= 1;
+				chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+			} while (++lane < _lane_cnt);
+			_p_working_buf++;
+		}
+		else
+		{
+			// release SDA after the ACK; the bytes are sampled in from 0
+			do
+			{
+				_lane_byte[lane] = 0;
+				OnMatchA(PinHigh);
+				SetupMatchA(sda_timestamp);
+				chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+			} while (++lane < _lane_cnt);
+		}
+	}
+	else if (++_cmd_sent_cnt < _cmd_cnt)
+	{
+		// repeated START: SDA goes high while SCL is low, and falls tSU_STA
+		// into the next SCL high time (see RepeatedStart)
+		// SDA : _/------\____
+		// SCL : ___/--------\_
+		_p_current_cmd++;
+		I2C_ML_LOAD_CMD();
+		do
+		{
+			OnMatchA(PinHigh);
+			SetupMatchA(sda_timestamp);
+			OnMatchB(PinLow);
+			SetupMatchB(_pulse_edge_next_timestamp + _tSU_STA);
+			chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+		} while (++lane < _lane_cnt);
+		chan = base_chan + ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+		SetFlag1();
+	}
+	else
+	{
+		// STOP: SDA goes low while SCL is low, and rises tSU_STO into the
+		// next SCL high time (see BeginStop)
+		// SDA : \______/--
+		// SCL : ___/------
+		do
+		{
+			OnMatchA(PinLow);
+			SetupMatchA(sda_timestamp);
+			chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+		} while (++lane < _lane_cnt);
+		chan = base_chan + ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+		SetFlag0();
+		SetFlag1();
+	}
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 0
+// flag 1 = 1
+//
+// SCL high for a repeated START; SDA falls tSU_STA from now, then the header
+// of the next command follows
+_eTPU_thread I2C_multilane::RepeatedStart(_eTPU_matches_enabled)
+{
+	int24 sda_timestamp;
+	unsigned int8 base_chan;
+	unsigned int8 header;
+	unsigned int8 lane;
+
+	I2C_ML_SCL_RISEN();
+	base_chan = chan - ETPU_I2C_MULTILANE_SCL_IN_OFFSET;
+	ClrFlag1();
+
+	chan = base_chan + ETPU_I2C_MULTILANE_SCL_OUT_OFFSET;
+	I2C_ML_CLOCK_CYCLE(_tSU_STA + _tHIGH, sda_timestamp);
+
+	header = _p_current_cmd->header;
+	chan = base_chan + ETPU_I2C_MULTILANE_SDA_OUT_OFFSET;
+	lane = 0;
+	do
+	{
+		_lane_byte[lane] = header;
+		OnMatchA(PinLow);
+		if (header & 0x80)
+			OnMatchA(PinHigh);
+		SetupMatchA(sda_timestamp);
+		chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+	} while (++lane < _lane_cnt);
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 1
+// flag 1 = 1
+//
+// SCL high for the STOP; SCL stays high, SDA rises tSU_STO from now on every
+// lane
+_eTPU_thread I2C_multilane::BeginStop(_eTPU_matches_enabled)
+{
+	unsigned int8 lane;
+
+	I2C_ML_SCL_RISEN();
+	ClrFlag0();
+	ClrFlag1();
+	DisableEventHandling(); // no more clocks
+
+	// the lane 0 SDA match completes the transfer (FinishStop); the match
+	// latches left by the data bits are cleared first
+	chan += (ETPU_I2C_MULTILANE_SDA_OUT_OFFSET - ETPU_I2C_MULTILANE_SCL_IN_OFFSET);
+	ClearAllLatches();
+	EnableEventHandling();
+	lane = 0;
+	do
+	{
+		OnMatchA(PinHigh);
+		SetupMatchA(_pulse_edge_next_timestamp + _tSU_STO);
+		chan += ETPU_I2C_MULTILANE_LANE_CHANNELS;
+	} while (++lane < _lane_cnt);
+}
+
+// entered on lane 0 SDA_out channel, match A
+//
+// exactly coincides with when SDA_out goes high to complete the STOP
+_eTPU_thread I2C_multilane::FinishStop(_eTPU_matches_enabled)
+{
+	DisableEventHandling();
+	ClearAllLatches();
+	// now fully done with transfer, can issue interrupt
+	_in_use_flag = 0;
+	chan += (ETPU_I2C_MULTILANE_SCL_OUT_OFFSET - ETPU_I2C_MULTILANE_SDA_OUT_OFFSET);
+	SetChannelInterrupt();
+}
+
+
+// define entry table for I2C clock out channel
+// note: ETPD is a don't care, and is set to input to be compatible with
+// all MCUs
+DEFINE_ENTRY_TABLE(I2C_multilane, I2C_SCL_out, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, StartTransfer),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSCL_out),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+};
+
+// define entry table for I2C clock in channel
+DEFINE_ENTRY_TABLE(I2C_multilane, I2C_SCL_in, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSCL_in),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, DataBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, AckBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, RepeatedStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, BeginStop),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, DataBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, AckBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, RepeatedStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, BeginStop),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+};
+
+// define entry table for I2C data out channels
+// note: ETPD is a don't care, and is set to input to be compatible with
+// all MCUs
+DEFINE_ENTRY_TABLE(I2C_multilane, I2C_SDA_out, standard, inputpin, autocfsr)
+{
+	//           HSR LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR1(1,  x,  x, x, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(2,  x,  x, x, x,  x, x, Shutdown),
+	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(5,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(6,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(7,  x,  x, x, x,  x, x, InitSDA_out),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  1, x, _Error_handler_entry),
+};
+
+// define entry table for I2C data in channels
+DEFINE_ENTRY_TABLE(I2C_multilane, I2C_SDA_in, standard, inputpin, autocfsr)
+{
+	//           HSR LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR1(1,  x,  x, x, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(2,  x,  x, x, x,  x, x, Shutdown),
+	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(5,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(6,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(7,  x,  x, x, x,  x, x, InitSDA_in),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  1, x, _Error_handler_entry),
+};
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_multilane.h
+*
+* DESCRIPTION: I2C multi-lane master (one SCL, several SDA lines) class
+* declaration
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:
+*   This ETEC class, which consists of 4 entry tables and a number of threads,
+* provides an I2C master that clocks several SDA lines ("lanes") from one SCL
+* line, in lockstep.  Each lane is a separate I2C bus segment with its own
+* devices, typically identical devices at the same address; one transfer
+* reaches all of them in the time of one, with one set of clock threads.
+*
+*   base channel     --------\______ SCL (shared by all lanes)
+*   base channel+1   --------/
+*   base channel+2   --------\______ SDA lane 0
+*   base channel+3   --------/
+*   base channel+4   --------\______ SDA lane 1
+*   base channel+5   --------/
+*   ...                               up to ETPU_I2C_MULTILANE_MAX_LANES lanes
+*
+* Lane 0 is wired as the I2C master's SDA pair.  The output drivers are open
+* drain, as for the I2C master.
+*
+* The command list is that of the I2C master (I2C_cmd layout), shared by all
+* lanes: every lane sends the same header bytes and transfers the same number
+* of bytes.  Data is per lane:
+*   - read data is stored for lane n at p_buffer + n * _lane_stride.
+*   - write data is taken from p_buffer for every lane, or, when the command
+*     flags include ETPU_I2C_CMD_LANE_DATA, for lane n from
+*     p_buffer + n * _lane_stride.
+* 7-bit addressing only; the retry, NACK policy and 10-bit flags are ignored.
+*
+* ACKs are kept per lane.  A lane whose device NACKs (the header, or a written
+* byte other than the last, as for the I2C master) is released for the rest of
+* that command - its SDA is left high, and read bytes come back as 0xff - and
+* its bit is set in _lane_nack; the other lanes carry on.  The command is cut
+* short only once every lane has NACKed.
+*
+*   It takes one thread per SCL clock, on the SCL_in rising edge, which samples
+* every lane and schedules the next SCL cycle and the SDA changes of every lane.
+* The thread length grows with the number of lanes (a loop over the SDA
+* channels); it must complete within tHIGH of the rising edge.  SCL_in also
+* provides clock stretching support, as for the I2C master (_tr_max).
+*
+* Basic state flow (SCL_in rising edge):
+*   DataBit : samples a read bit on every lane, or puts out the next written
+*           bit; after the eighth bit stores read bytes and sets up the ACK slot.
+*   AckBit : ninth clock; samples the ACKs of a written byte, then sets up the
+*           next data byte, the repeated START for the next command, or the STOP.
+*   RepeatedStart : SCL high for the repeated START; SDA falls after tSU_STA
+*           (scheduled by AckBit) and the first header bit follows.
+*   BeginStop : SCL high for the STOP; SDA rises after tSU_STO.
+*   FinishStop : (lane 0 SDA_out match A) SDA has risen; the transfer is complete.
+*
+*   As in the I2C master, tHIGH is also used as the START hold time.
+*
+* ------------
+*
+* Interfaces for the I2C multi-lane class:
+*
+*    Host Service Requests
+*
+*       HSR 2 : Shutdown (all channels)
+*       HSR 4 : Start transfer (SCL_out channel)
+*       HSR 7 : Initialization (all channels)
+*
+*    Function Modes
+*
+*       FM0, FM1 not used
+*
+*    Flags
+*
+*       SCL_in, flag 0 / flag 1 : 0/0 data bit, 1/0 ACK slot, 0/1 repeated START,
+*       1/1 STOP
+*
+*    Interrupts
+*
+*       SCL_out : the transfer is complete (SDA has risen for the STOP)
+*
+*    Data (Channel Frame)
+*
+*       Inputs
+*
+*          unsigned int24		_tLOW;
+*          unsigned int24		_tHIGH;
+*          unsigned int24		_tBUF;
+*          unsigned int24		_tSU_STA;
+*          unsigned int24		_tSU_STO;
+*          unsigned int24		_tHD_DAT;
+*          unsigned int24		_tr_max;
+*             Bus timing in TCR1 counts, as for the I2C master.
+*
+*          I2C_multilane_cmd*	_p_cmd_list;
+*          unsigned int8		_cmd_cnt;
+*             The command list and its length (at least 1), as for the I2C
+*             master.
+*          unsigned int8		_lane_cnt;
+*             The number of lanes, 1 to ETPU_I2C_MULTILANE_MAX_LANES.  Read at
+*             each start transfer request.
+*          unsigned int24		_lane_stride;
+*             The distance in bytes between the buffers of consecutive lanes.
+*
+*       Outputs
+*
+*          unsigned int8		_in_use_flag;
+*             Non-zero from the start transfer HSR until the STOP completes.  A
+*             start transfer HSR issued while it is set is ignored.
+*          unsigned int8		_lane_nack;
+*             Bit n set if lane n NACKed during the last transfer.
+*
+*       Internal State
+*
+*          (see below)
+*
+*
+**************************************************************************/
+
+#ifndef __ETEC_I2C_MULTILANE_H
+#define __ETEC_I2C_MULTILANE_H
+
+typedef struct
+{
+	unsigned int8 header;
+	unsigned int8* p_buffer;
+	unsigned int8 flags;
+	unsigned int24 size;
+} I2C_multilane_cmd;
+
+_eTPU_class I2C_multilane
+{
+	// channel frame
+
+private:
+
+	// internal state
+
+	unsigned int8		_working_bit_mask; // bit on the bus being clocked
+	unsigned int8		_read_write_flag; // current byte read/write flag
+	unsigned int24		_remaining_byte_count;
+	unsigned int24		_working_buf_size;
+	unsigned int8*		_p_working_buf;
+	unsigned int24		_write_stride; // 0, or _lane_stride for per-lane data
+	I2C_multilane_cmd*	_p_current_cmd;
+	unsigned int8		_cmd_sent_cnt;
+	unsigned int8		_cmd_lane_nack; // lanes NACKed during the current command
+
+	// one working byte per lane
+	unsigned int8		_lane_byte[ETPU_I2C_MULTILANE_MAX_LANES];
+
+	unsigned int24		_pulse_edge_next_timestamp;
+
+public:
+
+	// user inputs
+
+	unsigned int24		_tLOW;
+	unsigned int24		_tHIGH;
+	unsigned int24		_tBUF;
+	unsigned int24		_tSU_STA;
+	unsigned int24		_tSU_STO;
+	unsigned int24		_tHD_DAT;
+	unsigned int24		_tr_max;
+
+	I2C_multilane_cmd*	_p_cmd_list;
+	unsigned int8		_cmd_cnt;
+
+	unsigned int8		_lane_cnt;
+	unsigned int24		_lane_stride;
+
+
+	// user outputs
+
+	unsigned int8		_in_use_flag;
+	unsigned int8		_lane_nack;
+
+
+	// threads
+
+	// initialize/shutdown
+	_eTPU_thread InitSCL_out(_eTPU_matches_disabled);
+	_eTPU_thread InitSCL_in(_eTPU_matches_disabled);
+	_eTPU_thread InitSDA_out(_eTPU_matches_disabled);
+	_eTPU_thread InitSDA_in(_eTPU_matches_disabled);
+	_eTPU_thread Shutdown(_eTPU_matches_disabled);
+
+	// SCL_out threads
+	_eTPU_thread StartTransfer(_eTPU_matches_enabled);
+
+	// SCL_in threads
+	_eTPU_thread DataBit(_eTPU_matches_enabled);
+	_eTPU_thread AckBit(_eTPU_matches_enabled);
+	_eTPU_thread RepeatedStart(_eTPU_matches_enabled);
+	_eTPU_thread BeginStop(_eTPU_matches_enabled);
+
+	// SDA_out threads (lane 0)
+	_eTPU_thread FinishStop(_eTPU_matches_enabled);
+
+
+	// entry tables
+
+	_eTPU_entry_table I2C_SCL_out;
+	_eTPU_entry_table I2C_SCL_in;
+	_eTPU_entry_table I2C_SDA_out;
+	_eTPU_entry_table I2C_SDA_in;
+};
+
+#endif
@@ -0,0 +1,1234 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_node.c
+*
+* DESCRIPTION: I2C node (combined master and slave) eTPU function(s)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:  Implementation of the I2C node (multiple eTPU functions).
+* See the header file etec_i2c_node.h for more details.
+*
+**************************************************************************/
+
+// verify proper version of compiler toolset is used
+#pragma verify_version GE, "2.01A", "use ETEC version 2.01A or newer"
+// verify this code uses no stack
+#pragma verify_memory_size STACK 0x00 bytes
+
+#include <ETpu_Std.h>
+
+// include common defintions
+#include "etpu_i2c_common.h"
+// include class declaration
+#include "etec_i2c_node.h"
+
+/* provide hint that channel frame base addr same on all chans touched by func */
+#pragma same_channel_frame_base I2C_node
+
+
+// in this I2C solution, the channels are defined as follows:
+// base channel     = SCL_out
+// base channel + 1 = SCL_in
+// base channel + 2 = SDA_out
+// base channel + 3 = SDA_in
+
+// the master role threads are those of the I2C master (etec_i2c_master.c),
+// the slave role threads those of the I2C slave (etec_i2c_slave.c); see
+// there for the details of each state
+
+
+// entered on SCL_out channel, HSR 7
+_eTPU_thread I2C_node::InitSCL_out(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	EnableOutputBuffer();
+	SetPinHigh();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	DetectADisable();
+	DetectBDisable();
+	MatchBOrderedSingleTransition();
+	EnableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	_master_active = 0;
+	_start_deferred = 0;
+}
+
+// entered on SCL_in channel, HSR 7
+_eTPU_thread I2C_node::InitSCL_in(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	DisableOutputBuffer(); // no output
+	OnMatchA(NoChange);  // Needed so output pin does not get toggled
+	OnMatchB(NoChange);  // Needed so output pin does not get toggled
+	DetectAAnyEdge();
+	DetectBDisable();
+	SingleMatchSingleTransition();
+	EnableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	// start in the slave role: detect idle
+	_state = I2C_NODE_MODE_FIND_IDLE;
+	_idle_detect = 0;
+	erta = tcr1 + _tBUF;
+	WriteErtAToMatchAAndEnable();
+}
+
+// entered on SDA_out channel, HSR 7
+_eTPU_thread I2C_node::InitSDA_out(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	EnableOutputBuffer();
+	SetPinHigh();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	DetectADisable();
+	DetectBDisable();
+	EitherMatchNonBlockingSingleTransition();
+	DisableEventHandling(); // "handled" by SCL_out/SCL_in channels instead
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+}
+
+// entered on SDA_in channel, HSR 7
+_eTPU_thread I2C_node::InitSDA_in(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	DisableOutputBuffer(); // no output
+	OnMatchA(NoChange);  // Needed so output pin does not get toggled
+	OnMatchB(NoChange);  // Needed so output pin does not get toggled
+	DetectAAnyEdge();
+	DetectBDisable();
+	SingleMatchSingleTransition();
+	EnableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	// detect idle
+	_state = I2C_NODE_MODE_FIND_IDLE;
+	_idle_detect = 0;
+	erta = tcr1 + _tBUF;
+	WriteErtAToMatchAAndEnable();
+}
+
+// entered on all channels, HSR 2
+_eTPU_thread I2C_node::Shutdown(_eTPU_matches_disabled)
+{
+	DisableEventHandling();
+	SetPinHigh();
+	DisableOutputBuffer();
+}
+
+// entered on SCL_in channel, HSR 4
+_eTPU_thread I2C_node::LatchAndClearErrorFlags(_eTPU_matches_enabled)
+{
+	// bracket the two-field update with the result sequence counter; if a
+	// transfer is in progress the counter is already odd and is left as is
+	unsigned int24 seq = _result_seq;
+	_result_seq = seq | 1;
+	_latched_error_flags = _error_flags;
+	_error_flags = 0;
+	if ((seq & 1) == 0)
+		_result_seq = seq + 2;
+}
+
+
+// SCL_in dispatch: the master role owns the SCL_in threads from the START
+// it issues until its STOP (or a lost arbitration), the slave role otherwise
+
+// entered on SCL_in channel, transition detected
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_thread I2C_node::PulseClock_TransferStart(_eTPU_matches_enabled)
+{
+	if (_master_active)
+		PulseClock_fragment(); // no return
+	TransferStart_SCL_fragment();
+}
+
+// entered on SCL_in channel, transition detected
+// flag 0 = 1
+// flag 1 = 0
+_eTPU_thread I2C_node::ProcessAck_DataBit(_eTPU_matches_enabled)
+{
+	if (_master_active)
+		ProcessAck_fragment(); // no return
+	DataBitReady_fragment();
+}
+
+// entered on SCL_in channel, transition detected
+// flag 0 = 0
+// flag 1 = 1
+_eTPU_thread I2C_node::RepeatedStart_OutputBit(_eTPU_matches_enabled)
+{
+	if (_master_active)
+		FinishRepeatedStart_fragment(); // no return
+	OutputDataBit_fragment();
+}
+
+// entered on SCL_in channel, transition detected
+// flag 0 = 1
+// flag 1 = 1
+_eTPU_thread I2C_node::BeginStop_HandleAck(_eTPU_matches_enabled)
+{
+	if (_master_active)
+		BeginStop_fragment(); // no return
+	HandleAck_fragment();
+}
+
+
+// master role
+
+// entered on SCL_out channel, HSR 4
+//
+// message transfer requested; issue a START to begin the transfer process,
+// once the bus is idle
+_eTPU_thread I2C_node::StartTransfer(_eTPU_matches_enabled)
+{
+	// need to make sure a transfer is not in progress
+	if (_in_use_flag)
+	{
+		// set busy error, issue interrupt, & exit
+		_error_flags |= ETPU_I2C_MASTER_BUSY;
+		SetChannelInterrupt();
+		return;
+	}
+	_in_use_flag = 1;
+	_result_seq++; // odd - results now being updated
+	_arb_lost = 0;
+
+	if (_state != I2C_NODE_MODE_IDLE)
+	{
+		// the bus is in use, or not yet found idle; the START waits until it
+		// is (see FoundStop, IdleDetectPass)
+		_start_deferred = 1;
+		return;
+	}
+	StartTransfer_fragment(); // no return
+}
+// entered on SCL_out channel, with _in_use_flag already set and the bus idle
+_eTPU_fragment I2C_node::StartTransfer_fragment()
+{
+	// need to pulse SDA low, bringing SCL low during SDA low pulse
+	// SDA : ----\_______/--
+	// SCL : --------\______
+
+	int24 start_trans_time;
+
+	_master_active = 1;
+	_start_deferred = 0;
+	_p_current_cmd = _p_cmd_list;
+	_cmd_sent_cnt = 0;
+	_arb_check = 0;
+
+	// setup header byte transfer and prepare for rest of message
+	_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 16;
+	_working_bit_count = 8;
+	_p_working_buf = _p_current_cmd->p_buffer; // always points to next byte
+	_working_buf_read_write_flag = _p_current_cmd->header & 1;
+	_working_buf_size = _p_current_cmd->size;
+	_remaining_byte_count = _working_buf_size;
+	_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
+	_start_flag = 1;
+
+	// setup transfer start after (_tbuf) time
+	start_trans_time = tcr1 + _tBUF;
+
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	SetupMatchA(start_trans_time); // dummy match to jive w/ chan mode
+	SetupMatchB(start_trans_time);
+	_pulse_edge_next_timestamp = start_trans_time;
+
+	// configure SCL_in channel for the master role (clock synch/stretching
+	// support); the slave role's idle detection is no longer needed
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	DetectARisingEdge();
+
+	// this node's own START/STOP are not watched for
+	chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	ClrFlag0();
+	DetectADisable();
+
+	// now, setup SDA_out
+	chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	OnMatchA(PinLow);
+	SetupMatchA(start_trans_time);
+}
+
+// entered on SCL_in channel (rising edge), or from PulseClockIgnore
+//
+// set up one clock cycle
+// handler gets called at start of each high pulse of clock signal
+_eTPU_fragment I2C_node::PulseClock_fragment()
+{
+	ClearTransLatch();
+	if (_working_bit_count == 0)
+		SetFlag0(); // go to setup ack mode
+	if (erta - _pulse_edge_next_timestamp > _tr_max)
+		_pulse_edge_next_timestamp = erta;
+	// arbitration: a bit this node drove high must read back high at the
+	// rising edge, otherwise another master is driving SDA low
+	if (_arb_check)
+	{
+		_arb_check = 0;
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		if (!IsCurrentInputPinHigh())
+			ArbitrationLost_fragment(); // no return
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	}
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+	// issue one clock pulse cycle
+	// also set up bit read or write, and see if we need to prep next byte
+
+	// if all bits processed, set up for ack processing
+	if (_working_bit_count == 0)
+	{
+		int24 bit_timestamp;
+
+		SetFlag0(); // go to setup ack mode
+
+		// setup clock cyle
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(_pulse_edge_next_timestamp + _tHIGH);
+		bit_timestamp = erta;
+		SetupMatchB(erta + _tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// process the final bit and/or prepare ack
+		if (_read_write_flag == ETPU_I2C_WRITE_MESSAGE)
+		{
+			// make sure we put out high so we can read ack from receiving slave
+			chan += ETPU_I2C_NODE_SDA_OUT_OFFSET;
+			OnMatchA(PinHigh);
+			SetupMatchA(bit_timestamp + _tHD_DAT);
+		}
+		else
+		{
+			// first, set up ack
+			chan += ETPU_I2C_NODE_SDA_OUT_OFFSET;
+			OnMatchA(PinHigh); // default to nack (last byte of read)
+			if (_remaining_byte_count)
+				OnMatchA(PinLow); // ack
+			SetupMatchA(bit_timestamp + _tHD_DAT);
+
+			// next, get last bit of read
+			chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SDA_OUT_OFFSET);
+
+			// read bit now!
+			_working_byte <<= 1;
+			if (IsCurrentInputPinHigh())
+				_working_byte |= 1;
+		}
+	}
+	else
+	{
+		int24 bit_timestamp;
+
+		_working_bit_count--;
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(_pulse_edge_next_timestamp + _tHIGH);
+		bit_timestamp = erta;
+		SetupMatchB(erta + _tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// setup bit read/write
+		if (_read_write_flag == ETPU_I2C_WRITE_MESSAGE)
+		{
+			chan += ETPU_I2C_NODE_SDA_OUT_OFFSET;
+			_working_byte <<= 1;
+			OnMatchA(PinLow);
+			if (CC.C)
+			{
+				OnMatchA(PinHigh);
+				_arb_check = 1;
+			}
+			SetupMatchA(bit_timestamp + _tHD_DAT);
+		}
+		else
+		{
+			chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+
+			// read bit now!
+			_working_byte <<= 1;
+			if (IsCurrentInputPinHigh())
+				_working_byte |= 1;
+		}
+	}
+}
+// entered on SCL_out channel, match B creating rising edge
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_thread I2C_node::PulseClockIgnore(_eTPU_matches_enabled)
+{
+	ClearAllLatches();
+	if (_start_flag)
+	{
+		unsigned int24 tmp = erta;
+		_start_flag = 0;
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+		erta = tmp;
+		PulseClock_fragment(); // no return
+	}
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 1
+// flag 1 = 0
+//
+// setup ack clock cyle
+// this handler gets called at start of ack high clock cycle
+_eTPU_fragment I2C_node::ProcessAck_fragment()
+{
+	ClearTransLatch();
+	if (erta - _pulse_edge_next_timestamp > _tr_max)
+		_pulse_edge_next_timestamp = erta;
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+
+	// note : only care about ack val if NOT the last byte (or header byte)
+	if ((_read_write_flag == ETPU_I2C_WRITE_MESSAGE) &&
+		(_remaining_byte_count || !_working_buf_size))
+	{
+		// read the ack
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+		if (IsCurrentInputPinHigh())
+		{
+			// make sure the transfer is stopped by zeroing byte count; the
+			// list goes on with the next command
+			_remaining_byte_count = 0;
+			_error_flags |= ETPU_I2C_MASTER_ACK_FAILED;
+		}
+		chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	}
+	else if (_read_write_flag == ETPU_I2C_READ_MESSAGE)
+		// save off newly read byte
+		*_p_working_buf++ = (unsigned int8)_working_byte;
+	LinkToChannel(chan);
+}
+// entered on SCL_out channel, link request
+//
+// complete the ACK/NACK processing
+_eTPU_thread I2C_node::ProcessAck_Step2(_eTPU_matches_enabled)
+{
+	int24 timestamp;
+	ClearLSRLatch();
+
+	timestamp = _pulse_edge_next_timestamp + _tHIGH;
+
+	// on to next byte or repeated START or STOP
+	if (_remaining_byte_count)
+	{
+		// setup the first clock pulse of the next byte
+		ClrFlag0();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(erta + _tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		_read_write_flag = _working_buf_read_write_flag;
+		chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+		if (_read_write_flag == ETPU_I2C_WRITE_MESSAGE)
+		{
+			_working_byte = *_p_working_buf << 17;
+			OnMatchA(PinLow);
+			if (CC.C)
+			{
+				OnMatchA(PinHigh);
+				_arb_check = 1;
+			}
+			SetupMatchA(timestamp + _tHD_DAT);
+			_p_working_buf++;
+		}
+		else
+		{
+			// make sure SDA_out goes high
+			OnMatchA(PinHigh);
+			SetupMatchA(timestamp + _tHD_DAT);
+		}
+
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_OUT_OFFSET);
+		ClrFlag0();
+
+		_remaining_byte_count--;
+		_working_bit_count = 7; // 7 because one bit will have already gone out/in
+	}
+	else if (++_cmd_sent_cnt < _cmd_cnt)
+	{
+		// combined format; issue repeated start and set up to read/write
+		// next buffer
+
+		// set flags to go to FinishRepeatedStart state next
+		ClrFlag0();
+		SetFlag1();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(erta + _tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// make sure SDA_out goes high
+		chan += ETPU_I2C_NODE_SDA_OUT_OFFSET;
+		OnMatchA(PinHigh);
+		SetupMatchA(timestamp + _tHD_DAT);
+
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_OUT_OFFSET);
+		ClrFlag0();
+		SetFlag1();
+
+		// setup header & message for the next transfer
+		_p_current_cmd++;
+		_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 16;
+		_working_bit_count = 8;
+		_p_working_buf = _p_current_cmd->p_buffer; // always points to next byte
+		_working_buf_read_write_flag = _p_current_cmd->header & 1;
+		_working_buf_size = _p_current_cmd->size;
+		_remaining_byte_count = _working_buf_size;
+		_read_write_flag = ETPU_I2C_WRITE_MESSAGE;
+	}
+	else
+	{
+		// issue STOP
+		// set up SCL_out for STOP
+		SetFlag1();
+		DisableEventHandling();
+		OnMatchA(PinLow);
+		OnMatchB(PinHigh);
+		SetupMatchA(timestamp);
+		SetupMatchB(erta + _tLOW);
+		_pulse_edge_next_timestamp = ertb;
+
+		// set up SDA_out for STOP
+		chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+		OnMatchA(PinLow);
+		SetupMatchA(timestamp + _tHD_DAT);
+
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_OUT_OFFSET);
+		SetFlag1();
+	}
+}
+// entered on SCL_out channel, match B completion
+// flag 0 = 1
+// flag 1 = 0
+_eTPU_thread I2C_node::ProcessAckIgnore(_eTPU_matches_enabled)
+{
+	ClearAllLatches();
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 1
+// flag 1 = 1
+//
+// create the end of transfer STOP
+_eTPU_fragment I2C_node::BeginStop_fragment()
+{
+	unsigned int24 st_timestamp;
+
+	DisableEventHandling();
+	ClearTransLatch();
+	ClrFlag0();
+	ClrFlag1();
+	_pulse_edge_next_timestamp = erta;
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+
+	// STOP will be done within _tSU_STO
+	ClearMatchALatch();
+	ClearMatchBLatch();
+	EnableEventHandling();
+
+	// wait additional time until SDA_out signal has completed the stop
+	OnMatchA(PinHigh);
+	OnMatchB(PinHigh);
+	SetupMatchA(_pulse_edge_next_timestamp + _tSU_STO);
+	SetupMatchB(erta);
+	st_timestamp = erta;
+	// finish off SDA_out
+	chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+	OnMatchA(PinHigh);
+	SetupMatchA(st_timestamp);
+}
+// entered on SCL_out channel, match B complete
+// flag 0 = 1
+// flag 1 = 1
+//
+// exactly coincides with when SDA_out pin goes high to complete STOP; the bus
+// is idle, and goes back to the slave role
+_eTPU_thread I2C_node::FinishStop(_eTPU_matches_enabled)
+{
+	ClearMatchALatch();
+	ClearMatchBLatch();
+	ClrFlag0();
+	ClrFlag1();
+	_master_active = 0;
+	_state = I2C_NODE_MODE_IDLE;
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+	DetectAFallingEdge();
+	ClearTransLatch();
+	EnableEventHandling();
+	chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+	DetectAFallingEdge();
+	ClearTransLatch();
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	// now fully done with transfer, can issue interrupt
+	_in_use_flag = 0;
+	_result_seq++; // even - results stable
+	SetChannelInterrupt();
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 0
+// flag 1 = 1
+//
+// create a repeated START
+// entered when SCL_out goes high at beginning of the repeated start.  Sets up
+// SDA_out to go low to generated the start, with next thread being a normal
+// clock pulse / data bit
+_eTPU_fragment I2C_node::FinishRepeatedStart_fragment()
+{
+	int24 rs_timestamp;
+
+	ClearTransLatch();
+	ClrFlag0();
+	ClrFlag1();
+	_pulse_edge_next_timestamp = erta;
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+
+	rs_timestamp = _pulse_edge_next_timestamp + _tSU_STA;
+
+	// switch to normal bit mode (PulseClock handler)
+	ClrFlag0();
+	ClrFlag1();
+
+	// extend SCL_out high pulse
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	SetupMatchA(rs_timestamp); // dummy match to jive w/ chan mode
+	SetupMatchB(rs_timestamp);
+	_pulse_edge_next_timestamp = rs_timestamp;
+	_start_flag = 1;
+
+	// now, setup SDA_out
+	chan += ETPU_I2C_NODE_SDA_OUT_OFFSET;
+	OnMatchA(PinLow);
+	SetupMatchA(rs_timestamp);
+}
+// entered on SCL_out channel, match B complete
+// flag 0 = 0
+// flag 1 = 1
+_eTPU_thread I2C_node::FinishRepeatedStartIgnore(_eTPU_matches_enabled)
+{
+	ClearAllLatches();
+}
+
+// entered on SDA_in channel, from PulseClock_fragment
+//
+// another master won arbitration; stop driving the bus at once and hand the
+// SCL_in threads to the slave role, which follows the rest of the transfer
+_eTPU_fragment I2C_node::ArbitrationLost_fragment()
+{
+	// cancel any pending edges and let both lines go high
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	SetPinHigh();
+	ClrFlag0();
+	ClrFlag1();
+
+	chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+	DisableMatch();
+	ClearAllLatches();
+	OnMatchA(NoChange);
+	SetPinHigh();
+
+	_start_flag = 0;
+	_master_active = 0;
+	_arb_lost = 1;
+	_in_use_flag = 0;
+	_result_seq++; // even - results stable
+	chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SDA_OUT_OFFSET);
+	SetChannelInterrupt();
+
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SCL_OUT_OFFSET);
+	ClrFlag0();
+	ClrFlag1();
+	if (_remaining_byte_count != _working_buf_size)
+	{
+		// lost in a data byte: the winner is addressing the same device;
+		// sit the rest of the transfer out
+		erta = tcr1;
+		IdleDetectFail_SCL_fragment(); // no return
+	}
+
+	// lost in a header: the bits clocked so far (the last one a 0) are the
+	// winner's header, which may address this node - go on receiving it
+	_state = I2C_NODE_MODE_WRITE_HEADER;
+	_working_byte = ((unsigned int24)(_p_current_cmd->header)) >> (_working_bit_count + 1);
+	_slave_bit_cnt = 7 - _working_bit_count;
+	_slave_byte_cnt = 0;
+	_last_ack = 0;
+	SetFlag0();
+	DataBitReady_fragment(); // no return
+}
+
+
+// slave role
+
+// IDLE detection code
+// NOTE: for eTPU2, could use PRSS in order to work properly under greater latency conditions
+
+// entered on SCL_in and SDA_in channels, on match A completion with pin high
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_thread I2C_node::IdleDetectPass_SDA(_eTPU_matches_enabled)
+{
+	ClearMatchALatch();
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	IdleDetectPass();
+}
+_eTPU_thread I2C_node::IdleDetectPass_SCL(_eTPU_matches_enabled)
+{
+	ClearMatchALatch();
+	IdleDetectPass();
+}
+// chan must be on SLC_IN when this is called
+_eTPU_fragment I2C_node::IdleDetectPass()
+{
+	_idle_detect++;
+	if (_idle_detect >= 2)
+	{
+		// if both SDA and SCL idle detected, move to IDLE state
+		_state = I2C_NODE_MODE_IDLE;
+		DetectAFallingEdge();
+		ClearTransLatch();
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		DetectAFallingEdge();
+		ClearTransLatch();
+		// a transfer requested while the bus was not idle can start now
+		if (_start_deferred)
+		{
+			chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+			StartTransfer_fragment(); // no return
+		}
+	}
+}
+
+// entered on SDA_in channel, on match A completion with pin low
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_thread I2C_node::IdleDetectFail_SDA(_eTPU_matches_enabled)
+{
+	IdleDetectFail_SDA_fragment();
+}
+_eTPU_fragment I2C_node::IdleDetectFail_SDA_fragment()
+{
+	unsigned int24 tmp;
+	ClearMatchALatch();
+	_state = I2C_NODE_MODE_FIND_IDLE;
+	_idle_detect = 0;
+	erta += _tBUF;
+	WriteErtAToMatchAAndEnable();
+	DetectAAnyEdge();
+	tmp = erta;
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	erta = tmp;
+	ClearMatchALatch();
+	WriteErtAToMatchAAndEnable();
+	DetectAAnyEdge();
+}
+
+// entered on SCL_in channel, on match A completion with pin low
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_thread I2C_node::IdleDetectFail_SCL(_eTPU_matches_enabled)
+{
+	IdleDetectFail_SCL_fragment();
+}
+_eTPU_fragment I2C_node::IdleDetectFail_SCL_fragment()
+{
+	unsigned int24 tmp;
+	ClearMatchALatch();
+	_state = I2C_NODE_MODE_FIND_IDLE;
+	_idle_detect = 0;
+	erta += _tBUF;
+	WriteErtAToMatchAAndEnable();
+	DetectAAnyEdge();
+	tmp = erta;
+	chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+	erta = tmp;
+	ClearMatchALatch();
+	WriteErtAToMatchAAndEnable();
+	DetectAAnyEdge();
+}
+
+
+// entered on SDA_in channel, falling edge detected
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_thread I2C_node::TransferStart_SDA(_eTPU_matches_enabled)
+{
+	DisableMatch();
+	DetectADisable();
+	ClearTransLatch();
+	ClearMatchALatch();
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	if ((CurrentInputPin == 0) || (_state != I2C_NODE_MODE_IDLE))
+		IdleDetectFail_SCL_fragment(); // no return
+	_state = I2C_NODE_MODE_START_SDA_LOW;
+}
+
+// entered on SCL_in channel, falling edge detected
+// flag 0 = 0
+// flag 1 = 0
+_eTPU_fragment I2C_node::TransferStart_SCL_fragment()
+{
+	ClearTransLatch();
+	DisableMatch();
+	ClearMatchALatch();
+	if (_state != I2C_NODE_MODE_START_SDA_LOW)
+	{
+		if (_state == I2C_NODE_MODE_IDLE)
+			// only set invalid start error if in idle mode
+			_error_flags |= ETPU_I2C_SLAVE_INVALID_START;
+		IdleDetectFail_SCL_fragment(); // no return
+	}
+	DetectARisingEdge();
+	_last_ack = 0; // clear last ack status
+	_state = I2C_NODE_MODE_WRITE_HEADER;
+	_slave_bit_cnt = 0;
+	_slave_byte_cnt = 0;
+	_working_byte = 0;
+	SetFlag0();
+}
+
+// entered on SCL_in channel, rising edge detected
+// flag 0 = 1
+// flag 1 = 0
+_eTPU_fragment I2C_node::DataBitReady_fragment()
+{
+	ClearTransLatch();
+	if (_state == I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP)
+		DetectAFallingEdge();
+	else if (_state == I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP2)
+	{
+		_state = I2C_NODE_MODE_WRITE_BYTE;
+		DetectARisingEdge();
+		// end detect on SDA_in chan
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		DetectADisable();
+		ClrFlag0();
+		ClearTransLatch();
+		return;
+	}
+	chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET); // switch to SDA_in
+	// read SDA_in
+	_working_byte <<= 1;
+	if (IsCurrentInputPinHigh())
+		_working_byte |= 1;
+	_slave_bit_cnt++;
+	if (_state == I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP)
+	{
+		SetFlag0();
+		DetectAAnyEdge();
+		ClearTransLatch();
+		_state = I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP2;
+	}
+	if (_slave_bit_cnt == 8)
+	{
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET); // switch to SCL_in
+		DetectAFallingEdge();
+		if (_state == I2C_NODE_MODE_WRITE_HEADER)
+		{
+			// need to set for ack next, if the address matches this address
+			if (((_working_byte & _address_mask) == _address) ||
+				(!_working_byte && _accept_general_call)) // also handle general call, if configured to accept
+			{
+				// provide ACK as this node is the recipient of this message
+				SetFlag1();
+				_state = I2C_NODE_MODE_ACK_OUT;
+				_slave_result_seq++; // odd - results now being updated
+				_header = (unsigned int8)_working_byte;
+				_read_write_message = _working_byte & ETPU_I2C_RW_MASK;
+				if (_read_write_message)
+				{
+					_p_working_buf = _read_buffer;
+					_read_size = _read_buffer_size;
+				}
+				else
+					_p_working_buf = _write_buffer;
+			}
+			else if (_working_byte == 0x01) // START byte
+			{
+				SetFlag1();
+				_slave_result_seq++; // odd - results now being updated
+				_header = (unsigned int8)_working_byte;
+				_read_write_message = 1; // "read"
+				_state = I2C_NODE_MODE_ACK_IN; // will get a NACK, which will trigger search for STOP/rSTART
+			}
+			else
+			{
+				// need to ignore this message; it is destined for some other slave
+				ClrFlag0();
+				// start up IDLE detection
+				IdleDetectFail_SCL_fragment(); // no return
+			}
+		}
+		else // _state == I2C_NODE_MODE_WRITE_BYTE
+		{
+			if (++_slave_byte_cnt <= _write_buffer_size)
+				*_p_working_buf++ = (unsigned int8)_working_byte;
+			else
+				_error_flags |= ETPU_I2C_SLAVE_BUFFER_OVERFLOW; // set error, but keep processing
+			// provide ACK as this node is the recipient of this message
+			SetFlag1();
+			_state = I2C_NODE_MODE_ACK_OUT;
+		}
+	}
+}
+
+// entered on SCL_in channel (falling edge, but rising on FIND_STOP check)
+// flag 0 = 0
+// flag 1 = 1
+_eTPU_fragment I2C_node::OutputDataBit_fragment()
+{
+	ClearTransLatch();
+	if (_state == I2C_NODE_MODE_READ_FIND_STOP)
+	{
+		DetectAFallingEdge();
+		_state = I2C_NODE_MODE_READ_FIND_STOP2;
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		SetFlag0();
+		DetectAAnyEdge();
+		ClearTransLatch();
+		return;
+	}
+	else if (_state == I2C_NODE_MODE_READ_FIND_STOP2)
+	{
+		_error_flags |= ETPU_I2C_SLAVE_STOP_FAILED;
+		_slave_result_seq++; // even - transfer aborted, results stable
+		ClrFlag1();
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		ClrFlag0();
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+		SetChannelInterrupt(); // from SCL_in channel
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		// re-start IDLE detection
+		IdleDetectFail_SDA_fragment(); // no return
+	}
+	chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+	_working_byte <<= 1;
+	if (CC.C)
+		SetPinHigh();
+	else
+		SetPinLow();
+	_slave_bit_cnt++;
+	if (_slave_bit_cnt == 9)
+	{
+		// prepare to read ACK
+		chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_OUT_OFFSET);
+		SetFlag0();
+		_state = I2C_NODE_MODE_ACK_IN;
+		DetectARisingEdge();
+	}
+}
+
+// entered on SCL_in channel
+//   rising edge: I2C_NODE_MODE_ACK_OUT or I2C_NODE_MODE_ACK_COMPLETE
+//   falling edge: I2C_NODE_MODE_ACK_COMPLETE
+// flag 0 = 1
+// flag 1 = 1
+_eTPU_fragment I2C_node::HandleAck_fragment()
+{
+	ClearTransLatch();
+	if (_state == I2C_NODE_MODE_ACK_OUT)
+	{
+		chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		SetPinLow();
+		_state = I2C_NODE_MODE_ACK_COMPLETE;
+	}
+	else if (_state == I2C_NODE_MODE_ACK_IN)
+	{
+		// NOTE: if NACK received, then a STOP or repeated START is expected
+		DetectAFallingEdge();
+		chan += (ETPU_I2C_NODE_SDA_IN_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		_last_ack = CurrentInputPin;
+		_state = I2C_NODE_MODE_ACK_COMPLETE;
+	}
+	else // if (_state == I2C_NODE_MODE_ACK_COMPLETE)
+	{
+		if (_read_write_message == ETPU_I2C_WRITE_MESSAGE)
+		{
+			DetectARisingEdge();
+			ClrFlag1();
+			_state = I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP; // check for STOP/START
+			_slave_bit_cnt = 0;
+			_working_byte = 0;
+			chan += (ETPU_I2C_NODE_SDA_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+			SetPinHigh();
+		}
+		else
+		{
+			ClrFlag0();
+			if (_last_ack) // NACK detected
+			{
+				// if in READ mode and just got a NACK, then a STOP or repeated START is expected next
+				DetectARisingEdge();
+				_state = I2C_NODE_MODE_READ_FIND_STOP;
+				return;
+			}
+			else
+			{
+				_state = I2C_NODE_MODE_READ_BYTE;
+				// go right to setup for first bit...
+				_slave_bit_cnt = 0;
+				if (++_slave_byte_cnt <= _read_size)
+					_working_byte = (((unsigned int24)(*_p_working_buf++)) << 16) | 0x8000;
+				else
+				{
+					_working_byte = 0x8000; // do not interfere with ACK/NACK from master; just return 0
+					_error_flags |= ETPU_I2C_SLAVE_BUFFER_OVERFLOW; // set error, but keep processing
+				}
+				OutputDataBit_fragment(); // no return
+			}
+		}
+	}
+}
+
+// entered on SDA_in channel, rising edge
+// flag 0 = 1
+// flag 1 = 0
+_eTPU_thread I2C_node::FoundStop(_eTPU_matches_enabled)
+{
+	// STOP detected
+	ClrFlag0();
+	_byte_cnt = _slave_byte_cnt;
+	_slave_result_seq++; // even - results stable
+	SetChannelInterrupt(); // from SDA_in channel
+	DetectAFallingEdge();
+	ClearTransLatch();
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	ClrFlag0();
+	ClrFlag1();
+	if (CurrentInputPin == 0)
+	{
+		_error_flags |= ETPU_I2C_SLAVE_STOP_FAILED;
+		IdleDetectFail_SCL_fragment(); // no return
+	}
+	_state = I2C_NODE_MODE_IDLE;
+	DetectAFallingEdge();
+	ClearTransLatch();
+	// a transfer requested while the bus was busy can start now
+	if (_start_deferred)
+	{
+		chan += (ETPU_I2C_NODE_SCL_OUT_OFFSET - ETPU_I2C_NODE_SCL_IN_OFFSET);
+		StartTransfer_fragment(); // no return
+	}
+}
+
+// entered on SDA_in channel, falling edge
+// flag 0 = 1
+// flag 1 = 0
+_eTPU_thread I2C_node::FoundRepeatedStart(_eTPU_matches_enabled)
+{
+	// repeated START detected
+	ClrFlag0();
+	DetectADisable();
+	ClearTransLatch();
+	_byte_cnt = _slave_byte_cnt;
+	_slave_result_seq++; // even - results stable
+	SetChannelInterrupt(); // from SDA_in channel
+	chan += (ETPU_I2C_NODE_SCL_IN_OFFSET - ETPU_I2C_NODE_SDA_IN_OFFSET);
+	ClrFlag0();
+	ClrFlag1();
+	if (CurrentInputPin == 0)
+	{
+		_error_flags |= ETPU_I2C_SLAVE_INVALID_START;
+		IdleDetectFail_SCL_fragment(); // no return
+	}
+	_state = I2C_NODE_MODE_START_SDA_LOW;
+	DetectAFallingEdge();
+}
+
+
+// define entry table for I2C clock out channel
+// note: ETPD is a don't care, and is set to input to be compatible with
+// all MCUs
+DEFINE_ENTRY_TABLE(I2C_node, I2C_SCL_out, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, StartTransfer),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSCL_out),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, ProcessAck_Step2),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, ProcessAck_Step2),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, PulseClockIgnore),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, ProcessAckIgnore),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, FinishRepeatedStartIgnore),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, FinishStop),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, PulseClockIgnore),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, ProcessAckIgnore),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, FinishRepeatedStartIgnore),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, FinishStop),
+};
+
+// define entry table for I2C clock in channel
+DEFINE_ENTRY_TABLE(I2C_node, I2C_SCL_in, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, LatchAndClearErrorFlags),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSCL_in),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, IdleDetectFail_SCL),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, IdleDetectPass_SCL),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, PulseClock_TransferStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, ProcessAck_DataBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, RepeatedStart_OutputBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, BeginStop_HandleAck),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, PulseClock_TransferStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, ProcessAck_DataBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, RepeatedStart_OutputBit),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, BeginStop_HandleAck),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, PulseClock_TransferStart),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, PulseClock_TransferStart),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+};
+
+// define entry table for I2C data out channel
+// note: ETPD is a don't care, and is set to input to be compatible with
+// all MCUs
+DEFINE_ENTRY_TABLE(I2C_node, I2C_SDA_out, standard, inputpin, autocfsr)
+{
+	//           HSR LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR1(1,  x,  x, x, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(2,  x,  x, x, x,  x, x, Shutdown),
+	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(5,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(6,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(7,  x,  x, x, x,  x, x, InitSDA_out),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  1, x, _Error_handler_entry),
+};
+
+// define entry table for I2C data in channel
+DEFINE_ENTRY_TABLE(I2C_node, I2C_SDA_in, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSDA_in),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, IdleDetectFail_SDA),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, IdleDetectPass_SDA),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, TransferStart_SDA),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, FoundRepeatedStart),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, TransferStart_SDA),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, FoundStop),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, TransferStart_SDA),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, TransferStart_SDA),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, _Error_handler_entry),
+};
@@ -0,0 +1,339 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_node.h
+*
+* DESCRIPTION: I2C node (combined master and slave) class declaration
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:
+*   This ETEC class, which consists of 4 entry tables and a number of threads,
+* provides an I2C device that is both a master and an addressable slave, on
+* one group of 4 channels - e.g. a node of a multi-master system, or an SMBus
+* host that also receives host notify messages.  Running an I2C master and an
+* I2C slave on the same wires takes 8 channels; the node needs 4, and no
+* function swapping (re-initialization) between the two roles.
+*
+*   base channel   --------\______ SCL
+*   base channel+1 --------/
+*   base channel+2 --------\______ SDA
+*   base channel+3 --------/
+*
+* The channel layout is that of the I2C master.  The output drivers are open
+* drain, as for the I2C master and slave.
+*
+* Roles:
+*   Slave (default) : the node idles as an I2C slave - idle detection, START
+*           and address detection, and the write/read transfer states are those
+*           of the I2C slave (etec_i2c_slave.c).  A message for another device is
+*           sat out until the bus is idle again; a START byte is NACKed and the
+*           repeated START that follows is watched for, as by the I2C slave.
+*   Master : a start transfer request (HSR) switches the node to master
+*           behavior once the bus is idle: at once if it is, otherwise when the
+*           current transfer's STOP is seen (or the bus has been found idle for
+*           _tBUF).  The transfer states are those of the I2C master
+*           (etec_i2c_master.c), with arbitration always checked: a bit driven
+*           high must read back high.  The STOP hands the bus back to the slave
+*           role.
+*
+*   Arbitration lost : the node releases SCL and SDA at once and reports the
+*           loss (_arb_lost, SCL_out interrupt).  Lost in a header, the node
+*           takes the bits sent so far as received and goes on as a slave, so a
+*           winner addressing this node is answered; lost in a data byte, the
+*           node sits the rest of the transfer out.
+*
+* The SCL_in channel serves both roles on the same flag states; its threads
+* dispatch on _master_active.
+*
+* Simplifications against the I2C master: no 10-bit addressing, Hs-mode,
+* retries/NACK policy, bus hold, bus recovery, abort or timeouts.  Against the
+* I2C slave: 7-bit address only, no Hs-mode master code handling, no data-wait
+* mode (read data must be ready).
+*
+* ------------
+*
+* Interfaces for the I2C node class:
+*
+*    Host Service Requests
+*
+*       HSR 2 : Shutdown (all channels)
+*       HSR 4 : Start transfer (SCL_out channel)
+*       HSR 4 : Latch and clear error flags (SCL_in channel)
+*       HSR 7 : Initialization (all channels)
+*
+*    Function Modes
+*
+*       FM0, FM1 not used
+*
+*    Flags
+*
+*       SCL_in channel. (flag0,flag1)
+*          (0,0) => master: clock a bit; slave: idle, or detecting idle
+*          (1,0) => master: ACK slot; slave: read a data bit
+*          (0,1) => master: repeated START; slave: output a data bit
+*          (1,1) => master: STOP; slave: handle the ACK/NACK bit
+*       SCL_out channel: as SCL_in, for the master role
+*       SDA_in channel (flag0,flag1)
+*          (0,x) => everything else
+*          (1,x) => detect STOP or repeated START (slave role)
+*
+*    Interrupts
+*
+*       SCL_out : master transfer complete, arbitration lost, or start transfer
+*                 request refused (busy)
+*       SDA_in : slave transfer complete (STOP or repeated START)
+*       SCL_in : slave transfer aborted (invalid STOP) - check error flags
+*
+*    Data (Channel Frame)
+*
+*       Inputs
+*
+*          unsigned int24	_tLOW;
+*          unsigned int24	_tHIGH;
+*          unsigned int24	_tSU_STA;
+*          unsigned int24	_tSU_STO;
+*          unsigned int24	_tHD_DAT;
+*          unsigned int24	_tr_max;
+*             Master bus timing in TCR1 counts, as for the I2C master.
+*          unsigned int24	_tBUF;
+*             The minimum time between transfers: the master's bus free time
+*             before a START, and the slave's bus idle detection time.
+*          I2C_node_cmd*	_p_cmd_list;
+*          unsigned int8	_cmd_cnt;
+*             The command list (I2C_cmd layout, 7-bit headers, flags ignored)
+*             and its length (at least 1), as for the I2C master.
+*          unsigned int8	_address;
+*          unsigned int8	_address_mask;
+*          unsigned int24	_accept_general_call;
+*          unsigned int24	_read_buffer_size;
+*          unsigned int24	_write_buffer_size;
+*          unsigned int8*	_read_buffer;
+*          unsigned int8*	_write_buffer;
+*             Slave address and buffers, as for the I2C slave.
+*
+*       Outputs
+*
+*          unsigned int8	_in_use_flag;
+*             Non-zero from the start transfer HSR until the master transfer
+*             completes or loses arbitration, including any wait for the bus.
+*          unsigned int8	_arb_lost;
+*             Set if the last master transfer lost arbitration.
+*          unsigned int8	_error_flags;
+*          unsigned int8	_latched_error_flags;
+*             Running and latched error flags of both roles (the master errors
+*             ETPU_I2C_MASTER_ACK_FAILED/BUSY, the slave errors
+*             ETPU_I2C_SLAVE_*), as for the I2C master and slave.
+*          unsigned int24	_result_seq;
+*             Master result sequence counter, as for the I2C master; also
+*             brackets the latch and clear error flags HSR.
+*          unsigned int24	_header;
+*          unsigned int24	_byte_cnt;
+*             Header and byte count of the last slave transfer, as for the I2C
+*             slave.
+*          unsigned int24	_slave_result_seq;
+*             Slave result sequence counter (the I2C slave's _result_seq).
+*
+*       Internal State
+*
+*          (see below)
+*
+*
+**************************************************************************/
+
+#ifndef __ETEC_I2C_NODE_H
+#define __ETEC_I2C_NODE_H
+
+enum I2C_NODE_SLAVE_MODE
+{
+	I2C_NODE_MODE_FIND_IDLE,
+	I2C_NODE_MODE_IDLE,
+	I2C_NODE_MODE_START_SDA_LOW,
+	I2C_NODE_MODE_WRITE_HEADER,
+	I2C_NODE_MODE_WRITE_BYTE,
+	I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP,
+	I2C_NODE_MODE_WRITE_BYTE_CHECK_STOP2,
+	I2C_NODE_MODE_READ_BYTE,
+	I2C_NODE_MODE_READ_FIND_STOP,
+	I2C_NODE_MODE_READ_FIND_STOP2,
+	I2C_NODE_MODE_ACK_OUT,
+	I2C_NODE_MODE_ACK_IN,
+	I2C_NODE_MODE_ACK_COMPLETE,
+};
+
+typedef struct
+{
+	unsigned int8 header;
+	unsigned int8* p_buffer;
+	unsigned int8 flags;
+	unsigned int24 size;
+} I2C_node_cmd;
+
+_eTPU_class I2C_node
+{
+	// channel frame
+
+private:
+
+	// internal state, both roles
+
+	enum I2C_NODE_SLAVE_MODE	_state; // slave role bus state
+	unsigned int24		_working_byte;
+	unsigned int8*		_p_working_buf;
+	unsigned int8		_master_active; // master role owns the SCL_in threads
+	unsigned int8		_start_deferred; // transfer waiting for the bus to be idle
+
+	// internal state, slave role
+
+	unsigned int24		_slave_bit_cnt;
+	unsigned int24		_slave_byte_cnt;
+	unsigned int24		_read_write_message;
+	unsigned int24		_last_ack;
+	unsigned int24		_idle_detect;
+	unsigned int24		_read_size; // size of the buffer being read from
+
+	// internal state, master role
+
+	unsigned int24		_working_bit_count;
+	unsigned int8		_read_write_flag; // current byte read/write flag
+	// used for timing of the clock, this timestamp will take into
+	// account clock stretching if necessary
+	unsigned int24		_pulse_edge_next_timestamp;
+
+	I2C_node_cmd*		_p_current_cmd;
+	unsigned int8		_cmd_sent_cnt;
+	unsigned int24		_remaining_byte_count;
+	unsigned int24		_working_buf_size;
+	unsigned int8		_working_buf_read_write_flag;
+
+	unsigned int24		_start_flag; // used for state control when issuing START
+	unsigned int8		_arb_check; // bit being clocked was driven high
+
+public:
+
+	// user inputs
+
+	// master timing parameters
+	unsigned int24		_tLOW;
+	unsigned int24		_tHIGH; // note: also used as the START hold time
+	unsigned int24		_tSU_STA;
+	unsigned int24		_tSU_STO;
+	unsigned int24		_tHD_DAT;
+	unsigned int24		_tr_max; // maximum rise time
+
+	// min time between transfers; also the slave's bus idle detection time
+	unsigned int24		_tBUF;
+
+	// master commands
+	I2C_node_cmd*		_p_cmd_list;
+	unsigned int8		_cmd_cnt;
+
+	// slave address settings
+	unsigned int8		_address;
+	unsigned int8		_address_mask;
+	unsigned int24		_accept_general_call;
+
+	// slave max buffer sizes and buffer pointers (read/write nomeclature is
+	// from the remote master's perspective)
+	unsigned int24		_read_buffer_size;
+	unsigned int24		_write_buffer_size;
+	unsigned int8*		_read_buffer;
+	unsigned int8*		_write_buffer;
+
+
+	// user outputs
+
+	// master role
+	unsigned int8		_in_use_flag;
+	unsigned int8		_arb_lost;
+
+	unsigned int8		_error_flags;
+	unsigned int8		_latched_error_flags;
+
+	// odd while results are being updated, even when stable
+	unsigned int24		_result_seq;
+
+	// slave role
+	unsigned int24		_header;
+	unsigned int24		_byte_cnt;
+	unsigned int24		_slave_result_seq;
+
+
+	// methods/fragments
+
+	// master role
+	_eTPU_fragment StartTransfer_fragment();
+	_eTPU_fragment PulseClock_fragment();
+	_eTPU_fragment ProcessAck_fragment();
+	_eTPU_fragment FinishRepeatedStart_fragment();
+	_eTPU_fragment BeginStop_fragment();
+	_eTPU_fragment ArbitrationLost_fragment();
+	// slave role
+	_eTPU_fragment IdleDetectPass();
+	_eTPU_fragment IdleDetectFail_SCL_fragment();
+	_eTPU_fragment IdleDetectFail_SDA_fragment();
+	_eTPU_fragment TransferStart_SCL_fragment();
+	_eTPU_fragment DataBitReady_fragment();
+	_eTPU_fragment OutputDataBit_fragment();
+	_eTPU_fragment HandleAck_fragment();
+
+	// threads
+
+	// initialize/shutdown
+	_eTPU_thread InitSCL_out(_eTPU_matches_disabled);
+	_eTPU_thread InitSCL_in(_eTPU_matches_disabled);
+	_eTPU_thread InitSDA_out(_eTPU_matches_disabled);
+	_eTPU_thread InitSDA_in(_eTPU_matches_disabled);
+	_eTPU_thread Shutdown(_eTPU_matches_disabled);
+
+	// host request to perform a transfer (SCL_out)
+	_eTPU_thread StartTransfer(_eTPU_matches_enabled);
+	// host request to latch errors and clear the running error flag state
+	_eTPU_thread LatchAndClearErrorFlags(_eTPU_matches_enabled);
+
+	// SCL_out threads (master role)
+	_eTPU_thread PulseClockIgnore(_eTPU_matches_enabled);
+	_eTPU_thread ProcessAck_Step2(_eTPU_matches_enabled);
+	_eTPU_thread ProcessAckIgnore(_eTPU_matches_enabled);
+	_eTPU_thread FinishRepeatedStartIgnore(_eTPU_matches_enabled);
+	_eTPU_thread FinishStop(_eTPU_matches_enabled);
+
+	// SCL_in threads, master role / slave role
+	_eTPU_thread PulseClock_TransferStart(_eTPU_matches_enabled);
+	_eTPU_thread ProcessAck_DataBit(_eTPU_matches_enabled);
+	_eTPU_thread RepeatedStart_OutputBit(_eTPU_matches_enabled);
+	_eTPU_thread BeginStop_HandleAck(_eTPU_matches_enabled);
+
+	// SCL_in threads (slave role)
+	_eTPU_thread IdleDetectPass_SCL(_eTPU_matches_enabled);
+	_eTPU_thread IdleDetectFail_SCL(_eTPU_matches_enabled);
+
+	// SDA_in threads (slave role)
+	_eTPU_thread IdleDetectPass_SDA(_eTPU_matches_enabled);
+	_eTPU_thread IdleDetectFail_SDA(_eTPU_matches_enabled);
+	_eTPU_thread TransferStart_SDA(_eTPU_matches_enabled);
+	_eTPU_thread FoundStop(_eTPU_matches_enabled);
+	_eTPU_thread FoundRepeatedStart(_eTPU_matches_enabled);
+
+
+	// entry tables
+
+	_eTPU_entry_table I2C_SCL_out;
+	_eTPU_entry_table I2C_SCL_in;
+	_eTPU_entry_table I2C_SDA_out;
+	_eTPU_entry_table I2C_SDA_in;
+};
+
+#endif
@@ -48,6 +48,17 @@
 // master channel+3 = SDA_out
 
 
+// data-wait hold states (_hold_state)
+#define I2C_SLAVE_HOLD_NONE			0
+#define I2C_SLAVE_HOLD_WAITING		1
+#define I2C_SLAVE_HOLD_TIMED_OUT	2
+
+// 10-bit address match states (_addr10_state)
+#define I2C_ADDR10_NONE				0
+#define I2C_ADDR10_LOW_BYTE			1 // header matched, second address byte next
+#define I2C_ADDR10_SELECTED			2 // addressed until the STOP (short read form)
+
+
 // interrupts
 // if from SCL_in, it is a request to the host to (optionally) update the read buffer in wait-
 //    for-data mode.  In data-ready mode, this interrupt is not generated.  However, it may also
@@ -71,6 +82,7 @@ _eTPU_thread I2C_slave::InitSCL_in(_eTPU_matches_disabled)
 	// detect idle
 	_state = I2C_SLAVE_MODE_FIND_IDLE;
 	_idle_detect = 0;
+	_addr10_state = I2C_ADDR10_NONE;
 	erta = tcr1 + _tBUF;
 	WriteErtAToMatchAAndEnable();
 }
@@ -86,10 +98,11 @@ _eTPU_thread I2C_slave::InitSCL_out(_eTPU_matches_disabled)
 	DetectADisable();
 	DetectBDisable();
 	SingleMatchSingleTransition();
-	DisableEventHandling();
+	DisableEventHandling(); // enabled only while a data-wait hold is timed
 	ClearAllLatches();
 	ClrFlag0();
 	ClrFlag1();
+	_hold_state = I2C_SLAVE_HOLD_NONE;
 }
 
 // entered on SDA_in channel, HSR 7
@@ -141,9 +154,21 @@ _eTPU_thread I2C_slave::Shutdown(_eTPU_matches_disabled)
 // entered on SCL_out channel, HSR 4
 _eTPU_thread I2C_slave::ReadDataReady(_eTPU_matches_enabled)
 {
+	if (_hold_state == I2C_SLAVE_HOLD_NONE)
+		return; // no data request outstanding
+	_host_latency = tcr1 - _hold_start;
+	if (_hold_state == I2C_SLAVE_HOLD_TIMED_OUT)
+	{
+		// too late - the fallback data has already been served
+		_hold_state = I2C_SLAVE_HOLD_NONE;
+		return;
+	}
+	_hold_state = I2C_SLAVE_HOLD_NONE;
+	DisableEventHandling(); // cancel the hold timeout
 	// get the new buffer ready
 	_working_bit_cnt = 0;
 	_p_working_buf = _read_buffer;
+	_read_size = _read_buffer_size;
 	_working_byte = (((unsigned int24)(*_p_working_buf++)) << 16) | 0x8000;
 	// data ready, quit holding off master (go high after data hold time)
 	OnMatchA(PinHigh);
@@ -154,11 +179,40 @@ _eTPU_thread I2C_slave::ReadDataReady(_eTPU_matches_enabled)
 	OutputDataBit_fragment();
 }
 
+// entered on SCL_out channel, match A (data-wait hold timeout)
+// flag 0 = x
+// flag 1 = x
+_eTPU_thread I2C_slave::HoldTimeout(_eTPU_matches_enabled)
+{
+	// the host did not supply the read data in time; serve the fallback
+	// buffer instead so that the bus is not held any longer
+	DisableEventHandling();
+	_hold_state = I2C_SLAVE_HOLD_TIMED_OUT;
+	_error_flags |= ETPU_I2C_SLAVE_HOLD_TIMEOUT;
+	_working_bit_cnt = 0;
+	_p_working_buf = _fallback_buffer;
+	_read_size = _fallback_buffer_size;
+	_working_byte = (((unsigned int24)(*_p_working_buf++)) << 16) | 0x8000;
+	// release the master (go high after data setup time)
+	OnMatchA(PinHigh);
+	erta = tcr1 + _tSU_DAT;
+	ClearMatchALatch();
+	WriteErtAToMatchAAndEnable();
+	chan += (ETPU_I2C_SLAVE_SCL_IN_OFFSET - ETPU_I2C_SLAVE_SCL_OUT_OFFSET);
+	OutputDataBit_fragment();
+}
+
 // entered on SCL_in channel, HSR 4
 _eTPU_thread I2C_slave::LatchAndClearErrorFlags(_eTPU_matches_enabled)
 {
+	// bracket the two-field update with the result sequence counter; if a
+	// transfer is in progress the counter is already odd and is left as is
+	unsigned int24 seq = _result_seq;
+	_result_seq = seq | 1;
 	_latched_error_flags = _error_flags;
 	_error_flags = 0;
+	if ((seq & 1) == 0)
+		_result_seq = seq + 2;
 }
 
 
@@ -258,6 +312,7 @@ _eTPU_thread I2C_slave::TransferStart_SDA(_eTPU_matches_enabled)
 		IdleDetectFail_SCL_fragment(); // no return
 	//_start_timestamp = erta;
 	_state = I2C_SLAVE_MODE_START_SDA_LOW;
+	_addr10_state = I2C_ADDR10_NONE;
 }
 
 // entered on SCL_in channel, falling edge detected
@@ -323,22 +378,40 @@ _eTPU_thread I2C_slave::DataBitReady(_eTPU_matches_enabled)
 		if (_state == I2C_SLAVE_MODE_WRITE_HEADER)
 		{
 			// need to set for ack next, if the address matches this address
-			if (((_working_byte & _address_mask) == _address) ||
+			if (_address_10bit && ((_working_byte & _address_mask) == _address) &&
+				!(_working_byte & ETPU_I2C_RW_MASK))
+			{
+				// first byte of a 10-bit address; ACK it, the second byte
+				// decides whether this slave is the recipient
+				SetFlag1();
+				_state = I2C_SLAVE_MODE_ACK_OUT;
+				_addr10_state = I2C_ADDR10_LOW_BYTE;
+				_addr10_header = (unsigned int8)_working_byte;
+				_read_write_message = ETPU_I2C_WRITE_MESSAGE;
+			}
+			else if ((((_working_byte & _address_mask) == _address) &&
+				(!_address_10bit || (_addr10_state == I2C_ADDR10_SELECTED))) ||
 				(!_working_byte && _accept_general_call)) // also handle general call, if configured to accept
 			{
 				// provide ACK as this slave is the recipient of this message
 				SetFlag1();
 				_state = I2C_SLAVE_MODE_ACK_OUT;
+				_result_seq++; // odd - results now being updated
 				_header = (unsigned int8)_working_byte;
 				_read_write_message = _working_byte & ETPU_I2C_RW_MASK;
 				if (_read_write_message)
+				{
 					_p_working_buf = _read_buffer;
+					_read_size = _read_buffer_size;
+				}
 				else
 					_p_working_buf = _write_buffer;
 			}
-			else if (_working_byte == 0x01) // START byte
+			else if ((_working_byte == 0x01) || // START byte, or Hs-mode master code
+				((_working_byte & ~ETPU_I2C_HS_MASTER_ID_MASK) == ETPU_I2C_HS_MASTER_CODE))
 			{
 				SetFlag1();
+				_result_seq++; // odd - results now being updated
 				_header = (unsigned int8)_working_byte;
 				_read_write_message = 1; // "read"
 				_state = I2C_SLAVE_MODE_ACK_IN; // will get a NACK, which will trigger search for STOP/rSTART
@@ -346,6 +419,29 @@ _eTPU_thread I2C_slave::DataBitReady(_eTPU_matches_enabled)
 			else
 			{
 				// need to ignore this message; it is destined for some other slave
+				_addr10_state = I2C_ADDR10_NONE;
+				ClrFlag0();
+				// start up IDLE detection
+				IdleDetectFail_SCL_fragment(); // no return
+			}
+		}
+		else if (_addr10_state == I2C_ADDR10_LOW_BYTE)
+		{
+			// second byte of a 10-bit address (A7-A0)
+			if ((unsigned int8)_working_byte == _address_low)
+			{
+				// provide ACK as this slave is the recipient of this message
+				SetFlag1();
+				_state = I2C_SLAVE_MODE_ACK_OUT;
+				_addr10_state = I2C_ADDR10_SELECTED;
+				_result_seq++; // odd - results now being updated
+				_header = _addr10_header;
+				_p_working_buf = _write_buffer;
+			}
+			else
+			{
+				// destined for some other 10-bit slave
+				_addr10_state = I2C_ADDR10_NONE;
 				ClrFlag0();
 				// start up IDLE detection
 				IdleDetectFail_SCL_fragment(); // no return
@@ -387,6 +483,7 @@ _eTPU_fragment I2C_slave::OutputDataBit_fragment()
 	else if (_state == I2C_SLAVE_MODE_READ_FIND_STOP2)
 	{
 		_error_flags |= ETPU_I2C_SLAVE_STOP_FAILED;
+		_result_seq++; // even - transfer aborted, results stable
 		ClrFlag1();
 		chan += (ETPU_I2C_SLAVE_SDA_IN_OFFSET - ETPU_I2C_SLAVE_SCL_IN_OFFSET);
 		ClrFlag0();
@@ -437,14 +534,26 @@ _eTPU_thread I2C_slave::HandleAck(_eTPU_matches_enabled)
 	else // if (_state == I2C_SLAVE_MODE_ACK_COMPLETE)
 	{
 		// if in wait for data mode, hold SCL low...
-		// note: do no hold on START byte
-		if ((FunctionMode0 == ETPU_I2C_SLAVE_DATA_WAIT_FM0) && !_working_byte_cnt && _read_write_message && (_header != 0x01))
+		// note: do no hold on START byte or master code
+		if ((FunctionMode0 == ETPU_I2C_SLAVE_DATA_WAIT_FM0) && !_working_byte_cnt && _read_write_message && (_header != 0x01) &&
+			((_header & ~ETPU_I2C_HS_MASTER_ID_MASK) != ETPU_I2C_HS_MASTER_CODE))
 		{
 			// interrupt only generated in data-wait mode, on SCL_in channel
 			// host must fill data buffer and issue a "data ready" host service request
 			SetChannelInterrupt(); // interrupt the CPU on read as it needs to update the read data buffer and release SCL
 			chan += (ETPU_I2C_SLAVE_SCL_OUT_OFFSET - ETPU_I2C_SLAVE_SCL_IN_OFFSET);
 			SetPinLow();
+			_hold_state = I2C_SLAVE_HOLD_WAITING;
+			_hold_start = tcr1;
+			if (_hold_timeout)
+			{
+				// bound the hold; the pin stays low on the timeout match
+				OnMatchA(NoChange);
+				erta = tcr1 + _hold_timeout;
+				ClearMatchALatch();
+				EnableEventHandling();
+				WriteErtAToMatchAAndEnable();
+			}
 			chan += (ETPU_I2C_SLAVE_SCL_IN_OFFSET - ETPU_I2C_SLAVE_SCL_OUT_OFFSET);
 		}
 		if (_read_write_message == ETPU_I2C_WRITE_MESSAGE)
@@ -472,7 +581,7 @@ _eTPU_thread I2C_slave::HandleAck(_eTPU_matches_enabled)
 				_state = I2C_SLAVE_MODE_READ_BYTE;
 				// go right to setup for first bit...
 				_working_bit_cnt = 0;
-				if (++_working_byte_cnt <= _read_buffer_size)
+				if (++_working_byte_cnt <= _read_size)
 					_working_byte = (((unsigned int24)(*_p_working_buf++)) << 16) | 0x8000;
 				else
 				{
@@ -492,8 +601,14 @@ _eTPU_thread I2C_slave::FoundStop(_eTPU_matches_enabled)
 {
 	// STOP detected
 	ClrFlag0();
-	_byte_cnt = _working_byte_cnt;
-	SetChannelInterrupt(); // from SDA_in channel
+	// nothing to report if only the first byte of a 10-bit address was seen
+	if (_addr10_state != I2C_ADDR10_LOW_BYTE)
+	{
+		_byte_cnt = _working_byte_cnt;
+		_result_seq++; // even - results stable
+		SetChannelInterrupt(); // from SDA_in channel
+	}
+	_addr10_state = I2C_ADDR10_NONE;
 	DetectAFallingEdge();
 	ClearTransLatch();
 	chan += (ETPU_I2C_SLAVE_SCL_IN_OFFSET - ETPU_I2C_SLAVE_SDA_IN_OFFSET);
@@ -518,8 +633,14 @@ _eTPU_thread I2C_slave::FoundRepeatedStart(_eTPU_matches_enabled)
 	ClrFlag0();
 	DetectADisable();
 	ClearTransLatch();
-	_byte_cnt = _working_byte_cnt;
-	SetChannelInterrupt(); // from SDA_in channel
+	if (_addr10_state == I2C_ADDR10_LOW_BYTE)
+		_addr10_state = I2C_ADDR10_NONE; // 10-bit address cut short
+	else
+	{
+		_byte_cnt = _working_byte_cnt;
+		_result_seq++; // even - results stable
+		SetChannelInterrupt(); // from SDA_in channel
+	}
 	chan += (ETPU_I2C_SLAVE_SCL_IN_OFFSET - ETPU_I2C_SLAVE_SDA_IN_OFFSET);
 	ClrFlag0();
 	ClrFlag1();
@@ -594,10 +715,10 @@ DEFINE_ENTRY_TABLE(I2C_slave, I2C_SCL_out, standard, inputpin, autocfsr)
 	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, _Error_handler_entry),
-	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, HoldTimeout),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, HoldTimeout),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, HoldTimeout),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, HoldTimeout),
 	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
 	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
@@ -46,7 +46,12 @@
 *           If this is the first bit of a data word, it also preps for a STOP and
 *           repeated START check (next state could be FoundStop or FoundRepeatedStart).
 *           If it is the last bit of a data byte do an address check, and if there is a
-*           match go to the HandleAck state, else go to IdleDetect.
+*           match go to the HandleAck state, else go to IdleDetect.  A 10-bit address
+*           is checked over the header and the first data byte (_addr10_state).  A
+*           START byte or an Hs-mode master code is NACKed, and the slave goes on to
+*           look for the STOP or repeated START that follows; it reports as a transfer
+*           with that header and no data.  The Hs-mode part is then received as usual,
+*           provided the slave threads keep up with the Hs clock.
 *   State 5 (OutputDataBit) : entered on a falling edge of the SCL line (exception - 
 *           rising edge if a STOP or repeated START is expected).  It outputs the next
 *           bit on the SDA line.  If it is on the last bit, the state transitions to
@@ -83,9 +88,18 @@
 *                 received from the master.
 *             1 : read requests are to be serviced by the host; the eTPU slave
 *                 driver will hold the clock signal low until the host has filled
-*                 the read data buffer.
+*                 the read data buffer (or until _hold_timeout expires, see below).
 *       FM1 not used
 *
+*    Data-wait hold timeout (SCL_out channel)
+*
+*       When _hold_timeout is non-zero, the hold of SCL in data-wait mode is
+*       bounded by a match A on the SCL_out channel (event handling is enabled
+*       only while the hold is timed).  If the host has not issued the read data
+*       ready HSR when it expires, the slave serves _fallback_buffer instead,
+*       releases SCL and sets ETPU_I2C_SLAVE_HOLD_TIMEOUT.  A data ready HSR
+*       that arrives after the timeout only updates _host_latency.
+*
 *    Flags
 *
 *       SCL_in channel. (flag0,flag1)
@@ -108,6 +122,15 @@
 *             with _address.  In almost all cases the R/W bit should be masked off, so this
 *             value may typically be 0xfe.  If a slave device with address 0x5X needs to be 
 *             supported, then _address_mask would be 0x50.
+*          unsigned int8	_address_10bit;
+*             If non-zero the slave has a 10-bit address.  _address/_address_mask then
+*             match the first header byte (11110 A9 A8, typically with mask 0xfe) and
+*             _address_low must match the second byte (A7-A0) of a write.  The slave stays
+*             addressed until the next STOP, so it also accepts the repeated-START read
+*             form (the first header byte alone, R/W set).  _header reports the first
+*             header byte.
+*          unsigned int8	_address_low;
+*             The second address byte (A7-A0) of a 10-bit slave address.
 *          unsigned int24	_accept_general_call;
 *             If 0, then the general call adress is ignored, otherwise it is accepted and
 *             the message received.
@@ -128,6 +151,14 @@
 *             is ready.  MUST include SDA rise time (tSU_DAT + tr).
 *          unsigned int24	_tBUF;
 *             The minimum time between transfers.  Used to detect a bus idle condition.
+*          unsigned int24	_hold_timeout;
+*             Maximum time SCL is held low waiting for read data in wait-for-read-data
+*             mode, in TCR1 counts.  0 means wait indefinitely.
+*          unsigned int8*	_fallback_buffer;
+*             Buffer from which read data is pulled when the hold times out.  Must hold
+*             at least one byte if _hold_timeout is used.
+*          unsigned int24	_fallback_buffer_size;
+*             Size of _fallback_buffer; reads past it are handled as for _read_buffer.
 *
 *       Outputs
 *
@@ -146,6 +177,16 @@
 *             Set of error flags (0 if none).  This is a copy of the running _error_flags
 *             made when requested by HSR.  The HSR provides a method of coherently reading
 *             and clearing the running _error_flags variable from the host.
+*          unsigned int24	_result_seq;
+*             Result sequence counter.  Odd from the time a transfer addressed to this
+*             slave is accepted until its STOP or repeated START (or while the error flags
+*             are being latched), even once _header, _byte_cnt, the write buffer and the
+*             error flags are stable.  The host reads it before and after reading any set
+*             of results; if it was odd or changed, the snapshot is retried.
+*          unsigned int24	_host_latency;
+*             TCR1 counts from the last read data request (SCL_in interrupt) until the
+*             host's read data ready HSR, including one that arrived after a hold
+*             timeout.
 *
 *       Internal State
 *
@@ -193,8 +234,14 @@ private:
 	unsigned int24		_last_ack;
 
 	unsigned int24		_idle_detect;
+	unsigned int24		_read_size; // size of the buffer being read from
+	unsigned int24		_hold_state;
+	unsigned int24		_hold_start;
 	//unsigned int24		_start_timestamp;
 
+	unsigned int8		_addr10_state; // progress of a 10-bit address match
+	unsigned int8		_addr10_header; // first byte of the 10-bit address
+
 public:
 
 	// user inputs
@@ -202,6 +249,8 @@ public:
 	// slave address settings
 	unsigned int8		_address;
 	unsigned int8		_address_mask;
+	unsigned int8		_address_10bit;
+	unsigned int8		_address_low;
 	unsigned int24		_accept_general_call;
 
 	// max buffer sizes
@@ -215,6 +264,11 @@ public:
 	unsigned int24		_tSU_DAT; // data setup time
 	unsigned int24		_tBUF;    // minimum bus quiesence to be considered in IDLE
 
+	// data-wait mode hold timeout (0 = none) and the data served on expiry
+	unsigned int24		_hold_timeout;
+	unsigned int8*		_fallback_buffer;
+	unsigned int24		_fallback_buffer_size;
+
 
 	// user outputs
 
@@ -224,6 +278,12 @@ public:
 	unsigned int8		_error_flags;
 	unsigned int8		_latched_error_flags;
 
+	// odd while results are being updated, even when stable
+	unsigned int24		_result_seq;
+
+	// time taken by the host to answer the last read data request
+	unsigned int24		_host_latency;
+
 
 	// methods/fragments
 
@@ -243,6 +303,8 @@ public:
 
 	// host request indicating read data has been loaded (SCL_out)
 	_eTPU_thread ReadDataReady(_eTPU_matches_enabled);
+	// read data was not supplied in time (SCL_out)
+	_eTPU_thread HoldTimeout(_eTPU_matches_enabled);
 	// host request to latch errors and clear the running error flag state
 	_eTPU_thread LatchAndClearErrorFlags(_eTPU_matches_enabled);
 
@@ -0,0 +1,372 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_ufm.c
+*
+* DESCRIPTION: I2C write-only push-pull transmitter eTPU function(s)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:  Implementation of the write-only, Ultra Fast-mode style I2C
+* transmitter (multiple eTPU functions).  See the header file etec_i2c_ufm.h
+* for more details.
+*
+**************************************************************************/
+
+// verify proper version of compiler toolset is used
+#pragma verify_version GE, "2.01A", "use ETEC version 2.01A or newer"
+// verify this code uses no stack
+#pragma verify_memory_size STACK 0x00 bytes
+
+#include <ETpu_Std.h>
+
+// include common defintions
+#include "etpu_i2c_common.h"
+// include class declaration
+#include "etec_i2c_ufm.h"
+
+/* provide hint that channel frame base addr same on all chans touched by func */
+#pragma same_channel_frame_base I2C_ufm
+
+
+// in this I2C solution, the channels are defined as follows:
+// base channel     = SCL_out
+// base channel + 1 = SDA_out
+
+// every SCL_out thread runs on the rising edge of a clock and schedules the
+// next falling and rising edges, along with the SDA change between them
+
+
+// entered on SCL_out channel, HSR 7
+_eTPU_thread I2C_ufm::InitSCL_out(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	EnableOutputBuffer();
+	SetPinHigh();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	DetectADisable();
+	DetectBDisable();
+	MatchBOrderedSingleTransition();
+	EnableEventHandling();
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+	_in_use_flag = 0;
+}
+
+// entered on SDA_out channel, HSR 7
+_eTPU_thread I2C_ufm::InitSDA_out(_eTPU_matches_disabled)
+{
+	DisableMatch(); // end any pending matches
+	EnableOutputBuffer();
+	SetPinHigh();
+	OnMatchA(NoChange);
+	OnMatchB(NoChange);
+	DetectADisable();
+	DetectBDisable();
+	EitherMatchNonBlockingSingleTransition();
+	DisableEventHandling(); // only enabled for the end of the STOP
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+}
+
+// entered on all channels, HSR 2
+_eTPU_thread I2C_ufm::Shutdown(_eTPU_matches_disabled)
+{
+	DisableEventHandling();
+	SetPinHigh();
+	DisableOutputBuffer();
+}
+
+// entered on SCL_out channel, HSR 4
+//
+// message transfer requested; issue a START and set up the first header bit
+_eTPU_thread I2C_ufm::StartTransfer(_eTPU_matches_enabled)
+{
+	// SDA : ----\_______
+	// SCL : --------\___
+
+	int24 start_trans_time;
+	int24 bit_timestamp;
+
+	// the host interface does not start a transfer while one is in progress
+	if (_in_use_flag)
+		return;
+	_in_use_flag = 1;
+
+	_p_current_cmd = _p_cmd_list;
+	_cmd_sent_cnt = 0;
+	_p_working_buf = _p_current_cmd->p_buffer; // always points to next byte
+	_remaining_byte_count = _p_current_cmd->size;
+
+	// SDA falls after the bus free time, SCL after tHIGH more
+	start_trans_time = tcr1 + _tBUF;
+	ClrFlag0();
+	ClrFlag1();
+	ClearAllLatches();
+	OnMatchA(PinLow);
+	OnMatchB(PinHigh);
+	SetupMatchA(start_trans_time + _tHIGH);
+	bit_timestamp = erta;
+	SetupMatchB(erta + _tLOW);
+	_pulse_edge_next_timestamp = ertb;
+
+	// the START on match A; the first header bit on match B, the rest of the
+	// bits on match A again
+	chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+	OnMatchA(PinLow);
+	SetupMatchA(start_trans_time);
+	_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 17;
+	OnMatchB(PinLow);
+	if (CC.C)
+		OnMatchB(PinHigh);
+	SetupMatchB(bit_timestamp + _tHD_DAT);
+	_working_bit_count = 7; // 7 because one bit will have already gone out
+}
+
+// entered on SCL_out channel, match B (SCL rising)
+// flag 0 = 0
+// flag 1 = 0
+//
+// put out the next bit of a header or data byte, or the ACK slot bit
+_eTPU_thread I2C_ufm::DataBit(_eTPU_matches_enabled)
+{
+	int24 bit_timestamp;
+
+	ClearAllLatches();
+	SetupMatchA(_pulse_edge_next_timestamp + _tHIGH);
+	bit_timestamp = erta;
+	SetupMatchB(erta + _tLOW);
+	_pulse_edge_next_timestamp = ertb;
+
+	if (_working_bit_count == 0)
+	{
+		// all 8 bits out; nothing reads the ACK slot, SDA is driven high
+		SetFlag0();
+		chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+		OnMatchA(PinHigh);
+	}
+	else
+	{
+		_working_bit_count--;
+		chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+		_working_byte <<= 1;
+		OnMatchA(PinLow);
+		if (CC.C)
+			OnMatchA(PinHigh);
+	}
+	SetupMatchA(bit_timestamp + _tHD_DAT);
+}
+
+// entered on SCL_out channel, match B (SCL rising)
+// flag 0 = 1
+// flag 1 = 0
+//
+// ninth clock of a byte; on to the next data byte, repeated START or STOP
+_eTPU_thread I2C_ufm::AckBit(_eTPU_matches_enabled)
+{
+	int24 bit_timestamp;
+
+	ClearAllLatches();
+	SetupMatchA(_pulse_edge_next_timestamp + _tHIGH);
+	bit_timestamp = erta;
+	SetupMatchB(erta + _tLOW);
+	_pulse_edge_next_timestamp = ertb;
+
+	if (_remaining_byte_count)
+	{
+		// first bit of the next data byte
+		ClrFlag0();
+		_remaining_byte_count--;
+		_working_bit_count = 7; // 7 because one bit will have already gone out
+		chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+		_working_byte = *_p_working_buf << 17;
+		OnMatchA(PinLow);
+		if (CC.C)
+			OnMatchA(PinHigh);
+		SetupMatchA(bit_timestamp + _tHD_DAT);
+		_p_working_buf++;
+	}
+	else if (++_cmd_sent_cnt < _cmd_cnt)
+	{
+		// repeated START: SDA goes high while SCL is low, and falls tSU_STA
+		// into the next SCL high time (see RepeatedStart)
+		// SDA : _/------\____
+		// SCL : ___/--------\_
+		ClrFlag0();
+		SetFlag1();
+		_p_current_cmd++;
+		_p_working_buf = _p_current_cmd->p_buffer;
+		_remaining_byte_count = _p_current_cmd->size;
+		chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+		OnMatchA(PinHigh);
+		SetupMatchA(bit_timestamp + _tHD_DAT);
+		OnMatchB(PinLow);
+		SetupMatchB(_pulse_edge_next_timestamp + _tSU_STA);
+	}
+	else
+	{
+		// STOP: SDA goes low while SCL is low, and rises tSU_STO into the
+		// next SCL high time (see BeginStop)
+		// SDA : \______/--
+		// SCL : ___/------
+		SetFlag1();
+		chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+		OnMatchA(PinLow);
+		SetupMatchA(bit_timestamp + _tHD_DAT);
+	}
+}
+
+// entered on SCL_out channel, match B (SCL rising)
+// flag 0 = 0
+// flag 1 = 1
+//
+// SCL high for a repeated START; SDA falls tSU_STA from now, then the header
+// of the next command follows
+_eTPU_thread I2C_ufm::RepeatedStart(_eTPU_matches_enabled)
+{
+	int24 bit_timestamp;
+
+	ClearAllLatches();
+	ClrFlag1();
+	SetupMatchA(_pulse_edge_next_timestamp + _tSU_STA + _tHIGH);
+	bit_timestamp = erta;
+	SetupMatchB(erta + _tLOW);
+	_pulse_edge_next_timestamp = ertb;
+
+	chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+	_working_byte = ((unsigned int24)(_p_current_cmd->header)) << 17;
+	OnMatchA(PinLow);
+	if (CC.C)
+		OnMatchA(PinHigh);
+	SetupMatchA(bit_timestamp + _tHD_DAT);
+	_working_bit_count = 7; // 7 because one bit will have already gone out
+}
+
+// entered on SCL_out channel, match B (SCL rising)
+// flag 0 = 1
+// flag 1 = 1
+//
+// SCL high for the STOP; SCL stays high, SDA rises tSU_STO from now
+_eTPU_thread I2C_ufm::BeginStop(_eTPU_matches_enabled)
+{
+	ClearAllLatches();
+	ClrFlag0();
+	ClrFlag1();
+
+	// the SDA match completes the transfer (FinishStop); the match latches
+	// left by the data bits are cleared first
+	chan += (ETPU_I2C_UFM_SDA_OUT_OFFSET - ETPU_I2C_UFM_SCL_OUT_OFFSET);
+	ClearAllLatches();
+	EnableEventHandling();
+	OnMatchA(PinHigh);
+	SetupMatchA(_pulse_edge_next_timestamp + _tSU_STO);
+}
+
+// entered on SDA_out channel, match A
+//
+// exactly coincides with when SDA_out goes high to complete the STOP
+_eTPU_thread I2C_ufm::FinishStop(_eTPU_matches_enabled)
+{
+	DisableEventHandling();
+	ClearAllLatches();
+	// now fully done with transfer, can issue interrupt
+	_in_use_flag = 0;
+	chan += (ETPU_I2C_UFM_SCL_OUT_OFFSET - ETPU_I2C_UFM_SDA_OUT_OFFSET);
+	SetChannelInterrupt();
+}
+
+
+// define entry table for I2C clock out channel
+// note: ETPD is a don't care, and is set to input to be compatible with
+// all MCUs
+DEFINE_ENTRY_TABLE(I2C_ufm, I2C_SCL_out, alternate, inputpin, autocfsr)
+{
+	//           HSR    LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 0,  1, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  0, x, Shutdown),
+	ETPU_VECTOR2(2,3,   x,  x, x, 1,  1, x, Shutdown),
+	ETPU_VECTOR3(1,4,5, x,  x, x, x,  x, x, StartTransfer),
+	ETPU_VECTOR2(6,7,   x,  x, x, x,  x, x, InitSCL_out),
+	ETPU_VECTOR1(0,     1,  0, 0, 0,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     1,  0, 0, 1,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 0, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 0,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 0, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  0, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  0, 1, 1,  1, 1, _Error_handler_entry),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 0, DataBit),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 0, AckBit),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  0, 1, RepeatedStart),
+	ETPU_VECTOR1(0,     x,  1, 1, 0,  1, 1, BeginStop),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 0, DataBit),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 0, AckBit),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  0, 1, RepeatedStart),
+	ETPU_VECTOR1(0,     x,  1, 1, 1,  1, 1, BeginStop),
+};
+
+// define entry table for I2C data out channel
+// note: ETPD is a don't care, and is set to input to be compatible with
+// all MCUs
+DEFINE_ENTRY_TABLE(I2C_ufm, I2C_SDA_out, standard, inputpin, autocfsr)
+{
+	//           HSR LSR M1 M2 PIN F0 F1 vector
+	ETPU_VECTOR1(1,  x,  x, x, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(1,  x,  x, x, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(2,  x,  x, x, x,  x, x, Shutdown),
+	ETPU_VECTOR1(3,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(4,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(5,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(6,  x,  x, x, x,  x, x, _Error_handler_entry),
+	ETPU_VECTOR1(7,  x,  x, x, x,  x, x, InitSDA_out),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  0, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  0, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 0,  1, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  0, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 0, 1,  1, x, FinishStop),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  0,  1, 1, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 0,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 0, 1,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  0, 1, x,  1, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  0, x, _Error_handler_entry),
+	ETPU_VECTOR1(0,  1,  1, 0, x,  1, x, _Error_handler_entry),
+};
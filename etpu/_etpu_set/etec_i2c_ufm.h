@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright (C) 2015 ASH WARE, Inc.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the Eclipse Public License v1.0
+ * which accompanies this distribution, and is available at
+ * http://www.eclipse.org/legal/epl-v10.html
+ *
+ * Contributors:
+ *     ASH WARE, Inc. - initial implementation
+ *******************************************************************************/
+
+/**************************************************************************
+* FILE NAME: etec_i2c_ufm.h
+*
+* DESCRIPTION: I2C write-only push-pull transmitter (Ultra Fast-mode style)
+* class declaration
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial Release.
+*
+* Description:
+*   This ETEC class, which consists of 2 entry tables and a number of threads,
+* provides a write-only, Ultra Fast-mode style I2C transmitter for the eTPU.
+* Unlike the I2C master it never reads the bus back: it has only the two output
+* channels, SCL and SDA, and both lines are always driven.
+*
+*   base channel   ---------------- SCL_out (USCL)
+*   base channel+1 ---------------- SDA_out (USDA)
+*
+*   The pads must be configured push-pull (not open-drain) by the host; the eTPU
+* drives both levels and never releases the lines while the function runs.
+* With no SCL_in or SDA_in there is no clock stretching, no arbitration and no
+* ACK: the ninth clock of each byte is sent with SDA high, as in UFm.
+*
+*   It takes one thread per SCL clock (on its rising edge), where the I2C master
+* takes two, plus the ACK link; as all edges are scheduled ahead, each thread
+* only has to be serviced within tHIGH of its rising edge.  A late thread
+* stretches the clock rather than corrupting the data.
+*
+* Basic state flow (SCL_out match B, rising SCL edge):
+*   DataBit : puts out the next data bit, or after the last one the high ACK
+*           slot bit.
+*   AckBit : ninth clock; sets up the first bit of the next data byte, the
+*           repeated START for the next command, or the STOP.
+*   RepeatedStart : SCL high for the repeated START; SDA falls after tSU_STA
+*           (scheduled by AckBit) and the first header bit follows.
+*   BeginStop : SCL high for the STOP; SDA rises after tSU_STO.
+*   FinishStop : (SDA_out match A) SDA has risen; the transfer is complete.
+*
+*   As in the I2C master, tHIGH is also used as the START hold time.
+*
+* ------------
+*
+* Interfaces for the I2C UFm class:
+*
+*    Host Service Requests
+*
+*       HSR 2 : Shutdown (all channels)
+*       HSR 4 : Start transfer (SCL_out channel)
+*       HSR 7 : Initialization (all channels)
+*
+*    Function Modes
+*
+*       FM0, FM1 not used
+*
+*    Flags
+*
+*       SCL_out, flag 0 / flag 1 : 0/0 data bit, 1/0 ACK slot, 0/1 repeated START,
+*       1/1 STOP
+*
+*    Interrupts
+*
+*       SCL_out : the transfer is complete (SDA has risen for the STOP)
+*
+*    Data (Channel Frame)
+*
+*       Inputs
+*
+*          unsigned int24		_tLOW;
+*          unsigned int24		_tHIGH;
+*          unsigned int24		_tBUF;
+*          unsigned int24		_tSU_STA;
+*          unsigned int24		_tSU_STO;
+*          unsigned int24		_tHD_DAT;
+*             Bus timing in TCR1 counts, as for the I2C master.
+*
+*          I2C_ufm_cmd*			_p_cmd_list;
+*             The list of commands that make up a transfer, each sent after a
+*             START or repeated START.  The layout is that of the I2C master's
+*             I2C_cmd, so the same command words can be used; the flags are
+*             ignored, the header is sent as given (UFm devices only take
+*             writes) and the size counts data bytes from p_buffer.
+*          unsigned int8		_cmd_cnt;
+*             The number of commands in the list (at least 1).
+*
+*       Outputs
+*
+*          unsigned int8		_in_use_flag;
+*             Non-zero from the start transfer HSR until the STOP completes.  A
+*             start transfer HSR issued while it is set is ignored.
+*
+*       Internal State
+*
+*          (see below)
+*
+*
+**************************************************************************/
+
+#ifndef __ETEC_I2C_UFM_H
+#define __ETEC_I2C_UFM_H
+
+typedef struct
+{
+	unsigned int8 header;
+	unsigned int8* p_buffer;
+	unsigned int8 flags;
+	unsigned int24 size;
+} I2C_ufm_cmd;
+
+_eTPU_class I2C_ufm
+{
+	// channel frame
+
+private:
+
+	// internal state
+
+	unsigned int24		_working_bit_count;
+	unsigned int24		_working_byte;
+	unsigned int24		_remaining_byte_count;
+	unsigned int8*		_p_working_buf;
+	I2C_ufm_cmd*		_p_current_cmd;
+	unsigned int8		_cmd_sent_cnt;
+
+	int24				_pulse_edge_next_timestamp;
+
+public:
+
+	// user inputs
+
+	unsigned int24		_tLOW;
+	unsigned int24		_tHIGH;
+	unsigned int24		_tBUF;
+	unsigned int24		_tSU_STA;
+	unsigned int24		_tSU_STO;
+	unsigned int24		_tHD_DAT;
+
+	I2C_ufm_cmd*		_p_cmd_list;
+	unsigned int8		_cmd_cnt;
+
+
+	// user outputs
+
+	unsigned int8		_in_use_flag;
+
+
+	// threads
+
+	// initialize/shutdown
+	_eTPU_thread InitSCL_out(_eTPU_matches_disabled);
+	_eTPU_thread InitSDA_out(_eTPU_matches_disabled);
+	_eTPU_thread Shutdown(_eTPU_matches_disabled);
+
+	// SCL_out threads
+	_eTPU_thread StartTransfer(_eTPU_matches_enabled);
+	_eTPU_thread DataBit(_eTPU_matches_enabled);
+	_eTPU_thread AckBit(_eTPU_matches_enabled);
+	_eTPU_thread RepeatedStart(_eTPU_matches_enabled);
+	_eTPU_thread BeginStop(_eTPU_matches_enabled);
+
+	// SDA_out threads
+	_eTPU_thread FinishStop(_eTPU_matches_enabled);
+
+
+	// entry tables
+
+	_eTPU_entry_table I2C_SCL_out;
+	_eTPU_entry_table I2C_SDA_out;
+};
+
+#endif
@@ -39,6 +39,12 @@
 #define ETPU_I2C_MASTER_START_TRANSFER_HSR	4 // SCL_out channel (master)
 #define ETPU_I2C_SLAVE_DATA_READY			4 // SCL_out channel (slave)
 #define ETPU_I2C_LATCH_CLEAR_ERRORS_HSR		4 // SCL_in channel (master & slave)
+#define ETPU_I2C_MASTER_BUS_RECOVERY_HSR	4 // SDA_out channel (master)
+#define ETPU_I2C_MASTER_ABORT_HSR			4 // SDA_in channel (master)
+#define ETPU_I2C_MASTER_RELEASE_BUS_HSR		3 // SDA_in channel (master)
+#define ETPU_I2C_UFM_START_TRANSFER_HSR		4 // SCL_out channel (UFm transmitter)
+#define ETPU_I2C_MULTILANE_START_TRANSFER_HSR	4 // SCL_out channel (multi-lane master)
+#define ETPU_I2C_NODE_START_TRANSFER_HSR	4 // SCL_out channel (master+slave node)
 
 ///////////////////////////////////
 // function modes
@@ -71,19 +77,90 @@
 #define ETPU_I2C_SLAVE_SCL_OUT_OFFSET	1
 #define ETPU_I2C_SLAVE_SDA_IN_OFFSET	2
 #define ETPU_I2C_SLAVE_SDA_OUT_OFFSET	3
+// I2C bus monitor channel layout
+#define ETPU_I2C_MONITOR_CHANNELS_USED	2
+#define ETPU_I2C_MONITOR_SCL_IN_OFFSET	0
+#define ETPU_I2C_MONITOR_SDA_IN_OFFSET	1
+// I2C UFm (write-only push-pull) transmitter channel layout
+#define ETPU_I2C_UFM_CHANNELS_USED		2
+#define ETPU_I2C_UFM_SCL_OUT_OFFSET		0
+#define ETPU_I2C_UFM_SDA_OUT_OFFSET		1
+// I2C multi-lane master channel layout; lane n uses the SDA pair at the
+// offsets below plus n * ETPU_I2C_MULTILANE_LANE_CHANNELS (lane 0 is wired
+// as the I2C master)
+#define ETPU_I2C_MULTILANE_MAX_LANES		8
+#define ETPU_I2C_MULTILANE_LANE_CHANNELS	2
+#define ETPU_I2C_MULTILANE_CHANNELS_USED(lanes)	(2 + (lanes) * ETPU_I2C_MULTILANE_LANE_CHANNELS)
+#define ETPU_I2C_MULTILANE_SCL_OUT_OFFSET	0
+#define ETPU_I2C_MULTILANE_SCL_IN_OFFSET	1
+#define ETPU_I2C_MULTILANE_SDA_OUT_OFFSET	2
+#define ETPU_I2C_MULTILANE_SDA_IN_OFFSET	3
+// I2C node (combined master and slave) channel layout; same as the master,
+// ETPU_I2C_CHANNELS_USED channels
+#define ETPU_I2C_NODE_SCL_OUT_OFFSET	0
+#define ETPU_I2C_NODE_SCL_IN_OFFSET		1
+#define ETPU_I2C_NODE_SDA_OUT_OFFSET	2
+#define ETPU_I2C_NODE_SDA_IN_OFFSET		3
 
 // transfer type (last bit of header byte)
 #define ETPU_I2C_RW_MASK			0x01
 #define ETPU_I2C_READ_MESSAGE		0x01
 #define ETPU_I2C_WRITE_MESSAGE		0x00
 
+// transfer command flags (byte 4 of a command)
+#define ETPU_I2C_CMD_RETRY_MASK		0x0f // times a NACKed command is retried
+#define ETPU_I2C_CMD_NACK_POLICY_MASK	0x10 // once retries are used up:
+#define ETPU_I2C_CMD_NACK_CONTINUE	0x00 //   go on to the next command
+#define ETPU_I2C_CMD_NACK_STOP		0x10 //   end the command list with a STOP
+#define ETPU_I2C_CMD_ADDR10			0x20 // 10-bit address; A7-A0 in the addr10 byte
+#define ETPU_I2C_CMD_LANE_DATA		0x40 // multi-lane master: per-lane write data
+#define ETPU_I2C_CMD_RETRY_BACKOFF	0x80 // each retry waits twice the interval of the last
+
+// 10-bit addressing: the first header byte is 11110 A9 A8 R/W
+#define ETPU_I2C_ADDR10_HEADER		0xf0
+#define ETPU_I2C_ADDR10_HEADER_MASK	0xf8
+#define ETPU_I2C_ADDR10_MAX			0x3ff
+
+// Hs-mode: the master code sent at F/S speed is 00001 X X X (X = master id)
+#define ETPU_I2C_HS_MASTER_CODE		0x08
+#define ETPU_I2C_HS_MASTER_ID_MASK	0x07
+
+// _failed_cmd when no command of the last transfer failed
+#define ETPU_I2C_MASTER_NO_FAILED_CMD	0xff
+
+// bus recovery: maximum number of SCL clocks issued to free SDA - enough
+// for a slave to finish shifting out a byte and its ACK bit
+#define ETPU_I2C_MASTER_RECOVERY_MAX_CLOCKS	9
+
+// bus monitor ring records (I2C_monitor_record, big-endian SDM)
+#define ETPU_I2C_MONITOR_REC_SIZE		8
+#define ETPU_I2C_MONITOR_REC_TYPE_OFFSET	0 // 8-bit
+#define ETPU_I2C_MONITOR_REC_TIME_OFFSET	1 // 24-bit TCR1
+#define ETPU_I2C_MONITOR_REC_DATA_OFFSET	4 // 8-bit
+#define ETPU_I2C_MONITOR_REC_ACK_TIME_OFFSET	5 // 24-bit TCR1
+// bus monitor record types
+#define ETPU_I2C_MONITOR_REC_START	0x01
+#define ETPU_I2C_MONITOR_REC_RSTART	0x02 // repeated START
+#define ETPU_I2C_MONITOR_REC_STOP	0x03
+#define ETPU_I2C_MONITOR_REC_HEADER	0x04 // data = header byte
+#define ETPU_I2C_MONITOR_REC_DATA	0x05 // data = data byte
+#define ETPU_I2C_MONITOR_REC_TYPE_MASK	0x7f
+#define ETPU_I2C_MONITOR_REC_NACK	0x80 // or'ed into a NACKed header/data record
+
 // errors
 #define ETPU_I2C_MASTER_ACK_FAILED		0x1
 #define ETPU_I2C_MASTER_BUSY			0x2
+#define ETPU_I2C_MASTER_BUS_STUCK		0x4
+#define ETPU_I2C_MASTER_TIMEOUT			0x8
+// I2C master only: the node keeps its master and slave errors in one byte,
+// so it does not use these
+#define ETPU_I2C_MASTER_ARB_LOST		0x10
+#define ETPU_I2C_MASTER_HOLD_TIMEOUT	0x20
 
 #define ETPU_I2C_SLAVE_INVALID_START	0x10
 #define ETPU_I2C_SLAVE_BUFFER_OVERFLOW	0x20
 #define ETPU_I2C_SLAVE_STOP_FAILED		0x40
+#define ETPU_I2C_SLAVE_HOLD_TIMEOUT		0x80
 
 
 // enable/disable parameter checks in the host interface code
@@ -86,7 +86,9 @@ extern const uint32_t fs_etpu_c_code_start;
 *          -# Copy initial values of global variables to data RAM
 *
 * @param   p_etpu_config - This is the structure used to initialize the eTPU
-* @param   *code - This is a pointer to an image of the eTPU code.
+* @param   *code - This is a pointer to an image of the eTPU code, or 0 if
+*          code RAM is known to already hold it (e.g. verified after a warm
+*          reset), in which case the code load is skipped.
 * @param   code_size - This is the size of the eTPU code in bytes.
 * @param   *globals - This is a pointer to the global eTPU data that needs
 *          to be initialized.
@@ -141,24 +143,27 @@ uint32_t fs_etpu_init_ext(
    * the code memory any unused locations must be set to zero. */
   eTPU->ECR_A.B.MDIS = 1;    /* stop eTPU_A */
   eTPU->ECR_B.B.MDIS = 1;    /* stop eTPU_B */
-  eTPU->MCR.B.VIS = 1;       /* enable CPU writes to eTPU code memory */
-
-  x = 0;
-  while(x < 5)
+  if(code != 0)
   {
-    if(eTPU->MCR.B.VIS == 1) break;
-    x++;
-  }
+    eTPU->MCR.B.VIS = 1;       /* enable CPU writes to eTPU code memory */
+
+    x = 0;
+    while(x < 5)
+    {
+      if(eTPU->MCR.B.VIS == 1) break;
+      x++;
+    }
 
-  if(x > 4) return (FS_ETPU_ERROR_VIS_BIT_NOT_SET);
+    if(x > 4) return (FS_ETPU_ERROR_VIS_BIT_NOT_SET);
 
-  /* Copy microcode */
-  code_end = fs_memcpy32_ext((uint32_t*)code_start, code, code_size);
+    /* Copy microcode */
+    code_end = fs_memcpy32_ext((uint32_t*)code_start, code, code_size);
 
-  /* Clear rest of program memory */
-  fs_memset32_ext(code_end, 0, unused_code_ram);
+    /* Clear rest of program memory */
+    fs_memset32_ext(code_end, 0, unused_code_ram);
 
-  eTPU->MCR.B.VIS = 0;    /* disable CPU writes to eTPU code memory */
+    eTPU->MCR.B.VIS = 0;    /* disable CPU writes to eTPU code memory */
+  }
 
   /* Configure MISC */
   eTPU->MISCCMPR.R = p_etpu_config->misc; /*write MISC value before enabled in MCR */
@@ -9,6 +9,9 @@
 * ---   -----------  ----------    ---------------------                 
 * 1.0     J Diener   01/Dec/11     Initial version.     
 * 2.0     J Diener   04/Sep/20     Modernize API.
+* 2.1     J Diener   19/Oct/26     Add SDM buffer pool with free/reuse.
+*                                  Add channel group placement service.
+*                                  Add non-blocking shutdown.
 *
 **************************************************************************/
 
@@ -17,20 +20,331 @@
 #include "etpu_i2c_common.h"
 
 
+// per-module SDM buffer pool; a free block holds the link to the next
+// free block of its class in its first word.  The class of each carved
+// block is kept on the host, indexed by the block's offset in the arena,
+// so a free is checked against what was actually allocated
+struct aw_etpu_i2c_pool
+{
+	uint8_t* p_base;  // start of the arena, 0 if no pool
+	uint8_t* p_carve; // next byte not yet handed out to any class
+	uint8_t* p_end;   // one past the end of the arena
+	uint8_t* free_list[ETPU_I2C_POOL_CLASS_CNT];
+	// per ETPU_I2C_POOL_MIN_BLOCK of the arena: 0 if no block starts
+	// there, otherwise the block's class + 1, with
+	// ETPU_I2C_POOL_BLOCK_FREE set while it is on a free list
+	uint8_t block_class[ETPU_I2C_POOL_MAX_SIZE / ETPU_I2C_POOL_MIN_BLOCK];
+	struct aw_etpu_i2c_pool_stats stats;
+};
+
+#define ETPU_I2C_POOL_BLOCK_FREE	0x80
+
+static struct aw_etpu_i2c_pool aw_etpu_i2c_pools[2]; // eTPU-AB, eTPU-C
+
+static struct aw_etpu_i2c_pool* aw_etpu_i2c_get_pool(
+    ETPU_MODULE em)
+{
+	return &aw_etpu_i2c_pools[(em == EM_AB) ? 0 : 1];
+}
+
+// size class of a request; ETPU_I2C_POOL_CLASS_CNT if too large for the pool
+// (the loop is bounded by the class count, so this is constant time)
+static uint32_t aw_etpu_i2c_pool_class(
+    uint32_t byte_size)
+{
+	uint32_t cls = 0;
+	uint32_t block_size = ETPU_I2C_POOL_MIN_BLOCK;
+	while ((block_size < byte_size) && (cls < ETPU_I2C_POOL_CLASS_CNT))
+	{
+		block_size <<= 1;
+		cls++;
+	}
+	return cls;
+}
+
+
 // returned buffer ptr is in host data space (not eTPU-relative space)
 int32_t aw_etpu_i2c_allocate_buffer(
     ETPU_MODULE em,
     uint32_t byte_size,
     uint8_t** buf_ptr)
 {
+	struct aw_etpu_i2c_pool* p_pool = aw_etpu_i2c_get_pool(em);
+	uint8_t* p_block;
+	uint32_t cls;
+	uint32_t block_size;
 #ifdef ETPU_I2C_PARAMETER_CHECK
 	if (!buf_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
 
-	*buf_ptr = (uint8_t*)fs_etpu_malloc_ext(em, byte_size);
-	if (buf_ptr == 0)
-		return (FS_ETPU_ERROR_MALLOC);
+	if (!p_pool->p_base)
+	{
+		// no pool, permanent allocation
+		*buf_ptr = (uint8_t*)fs_etpu_malloc_ext(em, byte_size);
+		if (*buf_ptr == 0)
+			return (FS_ETPU_ERROR_MALLOC);
+		return 0;
+	}
+
+	*buf_ptr = 0;
+	cls = aw_etpu_i2c_pool_class(byte_size);
+	if (cls >= ETPU_I2C_POOL_CLASS_CNT)
+	{
+		p_pool->stats.fail_cnt++;
+		return FS_ETPU_ERROR_MALLOC;
+	}
+	block_size = ETPU_I2C_POOL_MIN_BLOCK << cls;
+	p_block = p_pool->free_list[cls];
+	if (p_block)
+	{
+		// reuse a released block of this class
+		p_pool->free_list[cls] = *(uint8_t**)p_block;
+		p_pool->stats.free_bytes -= block_size;
+		p_pool->stats.free_block_cnt[cls]--;
+	}
+	else if (block_size <= (uint32_t)(p_pool->p_end - p_pool->p_carve))
+	{
+		// carve a new block from the arena
+		p_block = p_pool->p_carve;
+		p_pool->p_carve += block_size;
+		p_pool->stats.uncarved_bytes -= block_size;
+	}
+	else
+	{
+		p_pool->stats.fail_cnt++;
+		return FS_ETPU_ERROR_MALLOC;
+	}
+	p_pool->block_class[(p_block - p_pool->p_base) / ETPU_I2C_POOL_MIN_BLOCK] = (uint8_t)(cls + 1);
+	p_pool->stats.used_bytes += block_size;
+	if (p_pool->stats.used_bytes > p_pool->stats.peak_used_bytes)
+		p_pool->stats.peak_used_bytes = p_pool->stats.used_bytes;
+	*buf_ptr = p_block;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_pool_init(
+    ETPU_MODULE em,
+    uint32_t arena_size)
+{
+	struct aw_etpu_i2c_pool* p_pool = aw_etpu_i2c_get_pool(em);
+	uint8_t* p_arena;
+	uint32_t cls;
+	uint32_t i;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (arena_size < ETPU_I2C_POOL_MIN_BLOCK)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	// the class record only covers ETPU_I2C_POOL_MAX_SIZE
+	if (arena_size > ETPU_I2C_POOL_MAX_SIZE)
+		return FS_ETPU_ERROR_VALUE;
+
+	// fs_etpu_malloc_ext rounds up to 8 bytes, the smallest block size
+	arena_size = (arena_size + 7) & ~7u;
+	p_arena = (uint8_t*)fs_etpu_malloc_ext(em, (uint16_t)arena_size);
+	if (p_arena == 0)
+		return FS_ETPU_ERROR_MALLOC;
+
+	p_pool->p_base = p_arena;
+	p_pool->p_carve = p_arena;
+	p_pool->p_end = p_arena + arena_size;
+	for (cls = 0; cls < ETPU_I2C_POOL_CLASS_CNT; cls++)
+	{
+		p_pool->free_list[cls] = 0;
+		p_pool->stats.free_block_cnt[cls] = 0;
+	}
+	for (i = 0; i < arena_size / ETPU_I2C_POOL_MIN_BLOCK; i++)
+		p_pool->block_class[i] = 0;
+	p_pool->stats.arena_bytes = arena_size;
+	p_pool->stats.uncarved_bytes = arena_size;
+	p_pool->stats.used_bytes = 0;
+	p_pool->stats.peak_used_bytes = 0;
+	p_pool->stats.free_bytes = 0;
+	p_pool->stats.fail_cnt = 0;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_free_buffer(
+    ETPU_MODULE em,
+    uint8_t* buf_ptr,
+    uint32_t byte_size)
+{
+	struct aw_etpu_i2c_pool* p_pool = aw_etpu_i2c_get_pool(em);
+	uint32_t index;
+	uint32_t cls;
+	uint32_t block_size;
+
+	if (!p_pool->p_base)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	// must be an allocated block carved from this pool; a bad free would
+	// corrupt the free lists, so this is checked unconditionally
+	if ((buf_ptr < p_pool->p_base) || (buf_ptr >= p_pool->p_carve) ||
+		((buf_ptr - p_pool->p_base) & (ETPU_I2C_POOL_MIN_BLOCK - 1)))
+		return FS_ETPU_ERROR_VALUE;
+	index = (buf_ptr - p_pool->p_base) / ETPU_I2C_POOL_MIN_BLOCK;
+	cls = p_pool->block_class[index];
+	if ((cls == 0) || (cls & ETPU_I2C_POOL_BLOCK_FREE))
+		return FS_ETPU_ERROR_VALUE;
+	cls--;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (aw_etpu_i2c_pool_class(byte_size) != cls)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	p_pool->block_class[index] |= ETPU_I2C_POOL_BLOCK_FREE;
+	block_size = ETPU_I2C_POOL_MIN_BLOCK << cls;
+	*(uint8_t**)buf_ptr = p_pool->free_list[cls];
+	p_pool->free_list[cls] = buf_ptr;
+	p_pool->stats.free_bytes += block_size;
+	p_pool->stats.free_block_cnt[cls]++;
+	p_pool->stats.used_bytes -= block_size;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_pool_get_stats(
+    ETPU_MODULE em,
+    struct aw_etpu_i2c_pool_stats* stats_ptr)
+{
+	struct aw_etpu_i2c_pool* p_pool = aw_etpu_i2c_get_pool(em);
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!stats_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	if (!p_pool->p_base)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	*stats_ptr = p_pool->stats;
+	return 0;
+}
+
+
+// placement bookkeeping per engine
+struct aw_etpu_i2c_engine
+{
+	uint32_t registered;
+	uint32_t free_mask; // bit n set if engine channel n is free
+	uint32_t load;
+	uint32_t max_load;  // 0 if no limit
+};
+
+static struct aw_etpu_i2c_engine aw_etpu_i2c_engines[ETPU_I2C_ENGINE_CNT];
+
+#define ETPU_I2C_GROUP_MASK		((1u << ETPU_I2C_CHANNELS_USED) - 1)
+
+// lowest free group on the engine, or -1 if none
+static int32_t aw_etpu_i2c_find_group(
+    uint32_t free_mask)
+{
+	int32_t chan;
+	for (chan = 0; chan <= 32 - ETPU_I2C_CHANNELS_USED; chan++)
+		if (((free_mask >> chan) & ETPU_I2C_GROUP_MASK) == ETPU_I2C_GROUP_MASK)
+			return chan;
+	return -1;
+}
+
+
+int32_t aw_etpu_i2c_place_add_engine(
+    uint32_t engine,
+    uint32_t free_channel_mask,
+    uint32_t max_load)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (engine >= ETPU_I2C_ENGINE_CNT)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	aw_etpu_i2c_engines[engine].registered = 1;
+	aw_etpu_i2c_engines[engine].free_mask = free_channel_mask;
+	aw_etpu_i2c_engines[engine].load = 0;
+	aw_etpu_i2c_engines[engine].max_load = max_load;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_place(
+    uint32_t load,
+    ETPU_MODULE* em_ptr,
+    uint8_t* base_chan_ptr)
+{
+	struct aw_etpu_i2c_engine* p_engine;
+	struct aw_etpu_i2c_engine* p_best = 0;
+	int32_t best_chan = 0;
+	int32_t chan;
+	uint32_t engine;
+	uint32_t best_engine = 0;
+	uint32_t over_budget = 0;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!em_ptr || !base_chan_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	for (engine = 0; engine < ETPU_I2C_ENGINE_CNT; engine++)
+	{
+		p_engine = &aw_etpu_i2c_engines[engine];
+		if (!p_engine->registered)
+			continue;
+		chan = aw_etpu_i2c_find_group(p_engine->free_mask);
+		if (chan < 0)
+			continue;
+		if (p_engine->max_load && (p_engine->load + load > p_engine->max_load))
+		{
+			over_budget = 1;
+			continue;
+		}
+		if (!p_best || (p_engine->load < p_best->load))
+		{
+			p_best = p_engine;
+			best_engine = engine;
+			best_chan = chan;
+		}
+	}
+	if (!p_best)
+		return over_budget ? FS_ETPU_ERROR_TIMING : FS_ETPU_ERROR_MALLOC;
+
+	p_best->free_mask &= ~(ETPU_I2C_GROUP_MASK << best_chan);
+	p_best->load += load;
+	*em_ptr = (best_engine == ETPU_I2C_ENGINE_C) ? EM_C : EM_AB;
+	*base_chan_ptr = (uint8_t)((best_engine == ETPU_I2C_ENGINE_B) ? best_chan + 64 : best_chan);
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_unplace(
+    ETPU_MODULE em,
+    uint8_t base_chan_num,
+    uint32_t load)
+{
+	struct aw_etpu_i2c_engine* p_engine;
+	uint32_t group_mask;
+
+	if (em != EM_AB)
+		p_engine = &aw_etpu_i2c_engines[ETPU_I2C_ENGINE_C];
+	else if (base_chan_num >= 64)
+		p_engine = &aw_etpu_i2c_engines[ETPU_I2C_ENGINE_B];
+	else
+		p_engine = &aw_etpu_i2c_engines[ETPU_I2C_ENGINE_A];
+	group_mask = ETPU_I2C_GROUP_MASK << (base_chan_num & 31);
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	// the group must have been placed
+	if (!p_engine->registered || ((base_chan_num & 31) > 32 - ETPU_I2C_CHANNELS_USED) ||
+		(p_engine->free_mask & group_mask) || (load > p_engine->load))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	p_engine->free_mask |= group_mask;
+	p_engine->load -= load;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_place_get_load(
+    uint32_t engine,
+    uint32_t* load_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if ((engine >= ETPU_I2C_ENGINE_CNT) || !load_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	*load_ptr = aw_etpu_i2c_engines[engine].load;
 	return 0;
 }
 
@@ -76,3 +390,214 @@ int32_t aw_etpu_i2c_shutdown(
 
 	return 0;
 }
+
+
+// the channel frame is located once per call; fields are then read
+// directly through the host-space frame pointer
+static uint32_t aw_etpu_i2c_seq_read_24(
+    volatile uint8_t* p_frame,
+    uint32_t offset)
+{
+	return 0x00ffffff & *(volatile uint32_t*)(p_frame + offset - 1);
+}
+
+
+int32_t aw_etpu_i2c_seq_begin(
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint32_t seq_offset,
+    uint32_t* seq_ptr)
+{
+	uint32_t seq;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+		return FS_ETPU_ERROR_VALUE;
+	if (!seq_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	seq = aw_etpu_i2c_seq_read_24((volatile uint8_t*)fs_etpu_get_cpba_ext(em, channel), seq_offset);
+	*seq_ptr = seq;
+	if (seq & 1)
+		return FS_ETPU_ERROR_NOT_READY; // update in progress
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_seq_retry(
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint32_t seq_offset,
+    uint32_t seq)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	if (aw_etpu_i2c_seq_read_24((volatile uint8_t*)fs_etpu_get_cpba_ext(em, channel), seq_offset) != seq)
+		return FS_ETPU_ERROR_NOT_READY;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_seq_read_fields(
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint32_t seq_offset,
+    struct aw_etpu_i2c_seq_field* fields,
+    uint32_t field_cnt)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	return aw_etpu_i2c_seq_read_frame((volatile uint8_t*)fs_etpu_get_cpba_ext(em, channel),
+		seq_offset, fields, field_cnt, 0);
+}
+
+
+int32_t aw_etpu_i2c_seq_read_frame(
+    volatile uint8_t* p_frame,
+    uint32_t seq_offset,
+    struct aw_etpu_i2c_seq_field* fields,
+    uint32_t field_cnt,
+    struct aw_etpu_i2c_seq_copy* p_copy)
+{
+	uint32_t seq;
+	uint32_t tries;
+	uint32_t size;
+	uint32_t i;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (field_cnt && !fields)
+		return FS_ETPU_ERROR_VALUE;
+	for (i = 0; i < field_cnt; i++)
+		if ((fields[i].width != 8) && (fields[i].width != 24))
+			return FS_ETPU_ERROR_VALUE;
+	if (p_copy && ((p_copy->size && (!p_copy->src || !p_copy->dest)) ||
+		((p_copy->limit_field != ETPU_I2C_SEQ_NO_LIMIT) && (p_copy->limit_field >= field_cnt))))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	for (tries = 0; tries < ETPU_I2C_SEQ_READ_RETRIES; tries++)
+	{
+		seq = aw_etpu_i2c_seq_read_24(p_frame, seq_offset);
+		if (seq & 1)
+			continue; // update in progress
+		for (i = 0; i < field_cnt; i++)
+		{
+			if (fields[i].width == 8)
+				fields[i].value = p_frame[fields[i].offset];
+			else
+				fields[i].value = aw_etpu_i2c_seq_read_24(p_frame, fields[i].offset);
+		}
+		if (p_copy)
+		{
+			size = p_copy->size;
+			if ((p_copy->limit_field != ETPU_I2C_SEQ_NO_LIMIT) && (fields[p_copy->limit_field].value < size))
+				size = fields[p_copy->limit_field].value;
+			for (i = 0; i < size; i++)
+				p_copy->dest[i] = p_copy->src[i];
+		}
+		if (aw_etpu_i2c_seq_read_24(p_frame, seq_offset) == seq)
+			return 0;
+	}
+	return FS_ETPU_ERROR_NOT_READY;
+}
+
+
+int32_t aw_etpu_i2c_shutdown_start(
+    struct aw_etpu_i2c_shutdown_t *p_shutdown,
+    uint32_t quiesce)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_shutdown)
+		return FS_ETPU_ERROR_VALUE;
+	if (!p_shutdown->chan_cnt ||
+		(((p_shutdown->channel + p_shutdown->chan_cnt) > 32) && (p_shutdown->channel < 64)) ||
+		((p_shutdown->channel + p_shutdown->chan_cnt) > 96))
+		return FS_ETPU_ERROR_VALUE;
+	if ((p_shutdown->state == ETPU_I2C_SHUTDOWN_WAIT) || (p_shutdown->state == ETPU_I2C_SHUTDOWN_PENDING))
+		return FS_ETPU_ERROR_NOT_READY; // already under way
+#endif
+	p_shutdown->quiesce = quiesce;
+	p_shutdown->state = ETPU_I2C_SHUTDOWN_WAIT;
+	// issue the HSRs now if nothing is in the way
+	aw_etpu_i2c_shutdown_poll(p_shutdown);
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_shutdown_poll(
+    struct aw_etpu_i2c_shutdown_t *p_shutdown)
+{
+    volatile struct eTPU_struct * eTPU;
+	uint8_t channel;
+	uint32_t i;
+	ETPU_MODULE em;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_shutdown)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	channel = p_shutdown->channel;
+	em = p_shutdown->em;
+    if (em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+    }
+
+	switch (p_shutdown->state)
+	{
+	case ETPU_I2C_SHUTDOWN_WAIT:
+		for (i = 0; i < p_shutdown->chan_cnt; i++)
+		{
+			if (eTPU->CHAN[channel+i].HSRR.R)
+				return FS_ETPU_ERROR_NOT_READY;
+		}
+		if (p_shutdown->quiesce &&
+			(aw_etpu_i2c_seq_read_24((volatile uint8_t*)fs_etpu_get_cpba_ext(em, channel), p_shutdown->seq_offset) & 1))
+			return FS_ETPU_ERROR_NOT_READY; // transfer in progress
+		for (i = 0; i < p_shutdown->chan_cnt; i++)
+			eTPU->CHAN[channel+i].HSRR.R = ETPU_I2C_SHUTDOWN_HSR;
+		p_shutdown->state = ETPU_I2C_SHUTDOWN_PENDING;
+		return FS_ETPU_ERROR_NOT_READY;
+	case ETPU_I2C_SHUTDOWN_PENDING:
+		for (i = 0; i < p_shutdown->chan_cnt; i++)
+		{
+			if (eTPU->CHAN[channel+i].HSRR.R)
+				return FS_ETPU_ERROR_NOT_READY;
+		}
+		for (i = 0; i < p_shutdown->chan_cnt; i++)
+			fs_etpu_disable_ext(em, channel+i );
+		p_shutdown->state = ETPU_I2C_SHUTDOWN_DONE;
+		return 0;
+	case ETPU_I2C_SHUTDOWN_DONE:
+		return 0;
+	default:
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	}
+}
+
+
+int32_t aw_etpu_i2c_shutdown_step(
+    struct aw_etpu_i2c_shutdown_t *p_shutdown,
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint8_t chan_cnt)
+{
+	int32_t err_code;
+
+	if (p_shutdown->state == ETPU_I2C_SHUTDOWN_IDLE)
+	{
+		p_shutdown->em = em;
+		p_shutdown->channel = channel;
+		p_shutdown->chan_cnt = chan_cnt;
+		p_shutdown->seq_offset = 0;
+		err_code = aw_etpu_i2c_shutdown_start(p_shutdown, 0);
+		if (err_code)
+			return err_code;
+	}
+	return aw_etpu_i2c_shutdown_poll(p_shutdown);
+}
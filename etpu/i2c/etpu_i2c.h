@@ -9,6 +9,10 @@
 * ---   -----------  ----------    ---------------------                 
 * 1.0     J Diener   01/Dec/11     Initial version.     
 * 2.0     J Diener   04/Sep/20     Modernize API.
+* 2.1     J Diener   19/Oct/26     Add SDM buffer pool with free/reuse.
+*                                  Add channel group placement service.
+*                                  Add channel frame image helpers.
+*                                  Add non-blocking shutdown.
 *
 **************************************************************************/
 
@@ -21,10 +25,97 @@
 extern "C" {
 #endif
 
+/* Maximum number of attempts the sequence-counter read helpers make at
+ * obtaining a stable snapshot before giving up with FS_ETPU_ERROR_NOT_READY.
+ * A transfer in progress keeps the counter odd for its full duration, so
+ * this only needs to cover a few eTPU thread updates. */
+#ifndef ETPU_I2C_SEQ_READ_RETRIES
+#define ETPU_I2C_SEQ_READ_RETRIES	8
+#endif
+
+/* Describes one channel frame field to be read as part of a coherent
+ * snapshot with aw_etpu_i2c_seq_read_fields(). */
+struct aw_etpu_i2c_seq_field
+{
+    /* offset - the _CPBA8_xxx or _CPBA24_xxx offset of the field */
+    uint32_t offset;
+    /* width - 8 or 24 (bits) */
+    uint32_t width;
+    /* value - the value read is returned here */
+    uint32_t value;
+};
+
+/* Describes an SDM buffer to be copied as part of the same coherent
+ * snapshot by aw_etpu_i2c_seq_read_frame(). */
+struct aw_etpu_i2c_seq_copy
+{
+    /* src - host address of the buffer in SDM */
+    const volatile uint8_t* src;
+    /* dest - where the bytes are copied to */
+    uint8_t* dest;
+    /* size - the most bytes copied */
+    uint32_t size;
+    /* limit_field - index of a field in the snapshot whose value further
+     *		limits the copy (e.g. a byte count), or ETPU_I2C_SEQ_NO_LIMIT */
+    uint32_t limit_field;
+};
+#define ETPU_I2C_SEQ_NO_LIMIT	0xffffffff
+
+/* Build a channel frame image in host RAM so that it can be written to SDM
+ * in one burst with fs_memcpy32_ext().  image is a zeroed uint32_t array
+ * of _FRAME_SIZE_xxx_ / 4 words and offset a _CPBA24_xxx_ or _CPBA8_xxx_
+ * offset from etpu_set_defines.h.  SDM is big-endian: a 24-bit field
+ * occupies the low 3 bytes of its word, which may share the top byte
+ * with an 8-bit field. */
+#define AW_ETPU_I2C_FRAME_SET_24(image, offset, value) \
+	((image)[((offset) - 1) >> 2] |= ((uint32_t)(value) & 0x00ffffff))
+#define AW_ETPU_I2C_FRAME_SET_8(image, offset, value) \
+	((image)[(offset) >> 2] |= ((uint32_t)(uint8_t)(value) << (8 * (3 - ((offset) & 3)))))
+
+/* SDM buffer pool size classes: blocks of 8, 16, 32 ... bytes, up to
+ * ETPU_I2C_POOL_MAX_BLOCK.  Requests are rounded up to the next class. */
+#ifndef ETPU_I2C_POOL_CLASS_CNT
+#define ETPU_I2C_POOL_CLASS_CNT		8
+#endif
+#define ETPU_I2C_POOL_MIN_BLOCK		8
+#define ETPU_I2C_POOL_MAX_BLOCK		(ETPU_I2C_POOL_MIN_BLOCK << (ETPU_I2C_POOL_CLASS_CNT - 1))
+/* largest arena aw_etpu_i2c_pool_init() accepts; the host keeps one byte
+ * per ETPU_I2C_POOL_MIN_BLOCK of it to record the class of each block */
+#ifndef ETPU_I2C_POOL_MAX_SIZE
+#define ETPU_I2C_POOL_MAX_SIZE		1024
+#endif
+
+/* SDM buffer pool usage, as returned by aw_etpu_i2c_pool_get_stats().
+ * All sizes are in bytes.  Space on the free lists can only be reused
+ * by requests of the same class, so a request may fail even though
+ * free_bytes exceeds it; free_bytes relative to uncarved_bytes is a
+ * measure of the pool's fragmentation. */
+struct aw_etpu_i2c_pool_stats
+{
+    /* arena_bytes - size of the arena reserved by aw_etpu_i2c_pool_init() */
+    uint32_t arena_bytes;
+    /* uncarved_bytes - arena not yet handed out to any class */
+    uint32_t uncarved_bytes;
+    /* used_bytes - currently allocated, rounded up to the block size */
+    uint32_t used_bytes;
+    /* peak_used_bytes - highest value used_bytes has reached */
+    uint32_t peak_used_bytes;
+    /* free_bytes - held on the per-class free lists */
+    uint32_t free_bytes;
+    /* fail_cnt - allocations that could not be satisfied */
+    uint32_t fail_cnt;
+    /* free_block_cnt - number of blocks on each class free list */
+    uint32_t free_block_cnt[ETPU_I2C_POOL_CLASS_CNT];
+};
+
 /****************************************************************
  * Allocate a buffer from eTPU Shared Data Memory for use as an I2C
- * transmit/receive buffer.  Once allocated, buffers are not expected
- * to be de-allocated unless the entire eTPU module is re-initialized.
+ * transmit/receive buffer.  If a buffer pool has been set up for
+ * the module with aw_etpu_i2c_pool_init(), the buffer comes from
+ * the pool and can be released with aw_etpu_i2c_free_buffer().
+ * Otherwise it is allocated with fs_etpu_malloc_ext() and is not
+ * expected to be de-allocated unless the entire eTPU module is
+ * re-initialized.
  *
  * byte_size - the size in bytes of the buffer to be allocated.  The 
  *		buffer can be used for both transmit and receive operations.
@@ -40,6 +131,123 @@ int32_t aw_etpu_i2c_allocate_buffer(
 	uint8_t** buf_ptr);
 
 
+/****************************************************************
+ * Set up the SDM buffer pool of an eTPU module.  The arena is
+ * reserved in one piece with fs_etpu_malloc_ext(), so it follows
+ * the globals and anything allocated before it.  Blocks are carved
+ * from the arena on demand and returned to a free list per size
+ * class when released, so allocate and free both take constant
+ * time.  Each module (eTPU-AB, eTPU-C) has its own pool; calling
+ * this again, after the module has been re-initialized, starts a
+ * new empty pool.
+ *
+ * arena_size - the number of bytes to reserve for the pool, no more
+ *		than ETPU_I2C_POOL_MAX_SIZE.
+ *
+ * Returns FS_ETPU_ERROR_MALLOC if the arena does not fit SDM,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_pool_init(
+    ETPU_MODULE em,
+    uint32_t arena_size);
+
+
+/****************************************************************
+ * Return a buffer obtained from the pool to its free list.  The
+ * eTPU must no longer be using the buffer.  The block's class is
+ * taken from the pool's own record, not from byte_size; a pointer
+ * that is not an allocated block of the pool (including one already
+ * freed) is always rejected.
+ *
+ * buf_ptr - the buffer, as returned by aw_etpu_i2c_allocate_buffer().
+ * byte_size - the size that was requested when it was allocated;
+ *		checked against the block's class if ETPU_I2C_PARAMETER_CHECK
+ *		is defined.
+ *
+ * Returns FS_ETPU_ERROR_VALUE for an invalid block, other failure
+ * code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_free_buffer(
+    ETPU_MODULE em,
+    uint8_t* buf_ptr,
+    uint32_t byte_size);
+
+
+/****************************************************************
+ * Get the usage statistics of a module's buffer pool.
+ *
+ * stats_ptr - the statistics are returned at this location.
+ *
+ * Returns FS_ETPU_ERROR_UNINITIALIZED if the module has no pool,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_pool_get_stats(
+    ETPU_MODULE em,
+    struct aw_etpu_i2c_pool_stats* stats_ptr);
+
+
+/* eTPU engines known to the channel group placement service */
+#define ETPU_I2C_ENGINE_A			0	/* eTPU-AB channels 0-31 */
+#define ETPU_I2C_ENGINE_B			1	/* eTPU-AB channels 64-95 */
+#define ETPU_I2C_ENGINE_C			2	/* eTPU-C channels 0-31 */
+#define ETPU_I2C_ENGINE_CNT			3
+
+/* Estimated eTPU threads serviced per I2C bit; used to weigh each
+ * instance's share of its engine.  A bus is estimated to load its
+ * engine with bit_rate_khz * threads per bit thousand threads per
+ * second. */
+#ifndef ETPU_I2C_MASTER_THREADS_PER_BIT
+#define ETPU_I2C_MASTER_THREADS_PER_BIT	2
+#endif
+#ifndef ETPU_I2C_SLAVE_THREADS_PER_BIT
+#define ETPU_I2C_SLAVE_THREADS_PER_BIT	2
+#endif
+#define AW_ETPU_I2C_MASTER_LOAD(bit_rate_khz)	((bit_rate_khz) * ETPU_I2C_MASTER_THREADS_PER_BIT)
+#define AW_ETPU_I2C_SLAVE_LOAD(bit_rate_khz)	((bit_rate_khz) * ETPU_I2C_SLAVE_THREADS_PER_BIT)
+
+/****************************************************************
+ * Channel group placement.  Rather than hard coding the module and
+ * base channel of every instance, a system can register the engines
+ * (and channels on them) available to I2C, then ask for a group of
+ * ETPU_I2C_CHANNELS_USED consecutive channels per instance.  Each
+ * request goes to the engine with the lowest estimated load that
+ * has a free group, so the I2C thread load is spread across eTPU-A,
+ * eTPU-B and eTPU-C.  The returned em and base channel are then set
+ * in the instance before calling its init function.
+ *
+ * engine - ETPU_I2C_ENGINE_A/B/C.
+ * free_channel_mask - bit n set if engine channel n (0-31) may be
+ *		used for I2C.
+ * max_load - load budget for the engine in the units of
+ *		AW_ETPU_I2C_MASTER_LOAD(), or 0 for no limit.
+ * load - the estimated load of the instance being placed/removed,
+ *		e.g. AW_ETPU_I2C_MASTER_LOAD(100).
+ * em_ptr, base_chan_ptr - the module and base channel of the
+ *		placed group are returned at these locations.
+ *
+ * aw_etpu_i2c_place() returns FS_ETPU_ERROR_MALLOC if no registered
+ * engine has a free group, FS_ETPU_ERROR_TIMING if placing the load
+ * on any engine with a free group would exceed its budget, other
+ * failure code, or pass (0).  The others return failure code, or
+ * pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_place_add_engine(
+    uint32_t engine,
+    uint32_t free_channel_mask,
+    uint32_t max_load);
+int32_t aw_etpu_i2c_place(
+    uint32_t load,
+    ETPU_MODULE* em_ptr,
+    uint8_t* base_chan_ptr);
+int32_t aw_etpu_i2c_unplace(
+    ETPU_MODULE em,
+    uint8_t base_chan_num,
+    uint32_t load);
+int32_t aw_etpu_i2c_place_get_load(
+    uint32_t engine,
+    uint32_t* load_ptr);
+
+
 /****************************************************************
  * Shut down the I2C instance referenced by the base channel.
  *
@@ -52,6 +260,158 @@ int32_t aw_etpu_i2c_shutdown(
     uint8_t channel);
 
 
+/* states of a non-blocking shutdown */
+#define ETPU_I2C_SHUTDOWN_IDLE			0
+#define ETPU_I2C_SHUTDOWN_WAIT			1	/* waiting for the bus/HSRs to be free */
+#define ETPU_I2C_SHUTDOWN_PENDING		2	/* shutdown HSRs issued */
+#define ETPU_I2C_SHUTDOWN_DONE			3	/* channels disabled */
+
+/* Non-blocking shutdown of one I2C instance (any of the I2C functions). */
+struct aw_etpu_i2c_shutdown_t
+{
+    /* em, channel - the module and I2C eTPU base channel */
+    ETPU_MODULE         em;
+    uint8_t             channel;
+    /* chan_cnt - the number of channels in the group:
+     *		ETPU_I2C_CHANNELS_USED for the master, slave and node,
+     *		ETPU_I2C_MONITOR_CHANNELS_USED and ETPU_I2C_UFM_CHANNELS_USED,
+     *		or ETPU_I2C_MULTILANE_CHANNELS_USED(lane_cnt) */
+    uint8_t             chan_cnt;
+    /* seq_offset - the function's result sequence counter (e.g.
+     *		_CPBA24_I2C_master__result_seq_), used by the quiesce option */
+    uint32_t            seq_offset;
+    /* the remaining members are managed by the shutdown functions */
+    uint32_t            quiesce;
+    uint32_t            state;
+};
+
+/****************************************************************
+ * Shut down an I2C instance without waiting on the eTPU.
+ * aw_etpu_i2c_shutdown_start() issues the shutdown HSRs and returns
+ * at once; aw_etpu_i2c_shutdown_poll() is then called (e.g. from a
+ * periodic task) until it returns pass, at which point the channels
+ * are disabled and the instance may be re-initialized.  Shutdowns of
+ * any number of instances can be started first and polled together.
+ *
+ * If another HSR is pending on the channel group, the shutdown HSRs
+ * are issued by a later poll once it has been serviced.  With the
+ * quiesce option the HSRs are also held back while a transfer is in
+ * progress (the result sequence counter is odd), so the shutdown
+ * takes effect after its STOP rather than mid-byte.  The host must
+ * not start new master transfers once a quiesced shutdown is under
+ * way; a slave may still be addressed between the check and the HSR
+ * being serviced.
+ *
+ * p_shutdown - shutdown descriptor; em, channel, chan_cnt and
+ *		seq_offset must be set before calling
+ *		aw_etpu_i2c_shutdown_start().
+ * quiesce - non-zero to wait for the in-flight transfer to end.
+ *
+ * aw_etpu_i2c_shutdown_poll() returns FS_ETPU_ERROR_NOT_READY while
+ * the shutdown is in progress, FS_ETPU_ERROR_UNINITIALIZED if none
+ * was started, or pass (0) once complete.  aw_etpu_i2c_shutdown_start()
+ * returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_shutdown_start(
+    struct aw_etpu_i2c_shutdown_t *p_shutdown,
+    uint32_t quiesce);
+int32_t aw_etpu_i2c_shutdown_poll(
+    struct aw_etpu_i2c_shutdown_t *p_shutdown);
+
+
+/****************************************************************
+ * One step of the shutdown of an instance that keeps its shutdown
+ * descriptor, for the per-function shutdown calls (monitor, UFm,
+ * multilane, node).  If the descriptor is idle the shutdown is
+ * started (without quiesce), then it is polled.  The descriptor
+ * state must be set to ETPU_I2C_SHUTDOWN_IDLE when the instance is
+ * initialized.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY while the shutdown is in
+ * progress, other failure code, or pass (0) once complete.
+ ****************************************************************/
+int32_t aw_etpu_i2c_shutdown_step(
+    struct aw_etpu_i2c_shutdown_t *p_shutdown,
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint8_t chan_cnt);
+
+
+/****************************************************************
+ * Lock-free coherent reads of I2C results.  The eTPU functions keep
+ * a result sequence counter (_result_seq) in the channel frame that
+ * is odd while results are being updated and even when they are
+ * stable.  A reader calls aw_etpu_i2c_seq_begin(), reads any number
+ * of fields and/or buffer bytes, then calls aw_etpu_i2c_seq_retry();
+ * if the latter returns non-zero the reads must be repeated.
+ *
+ * channel - the I2C eTPU base channel (master or slave)
+ * seq_offset - _CPBA24_I2C_master__result_seq_ or
+ *		_CPBA24_I2C_slave__result_seq_.
+ * seq_ptr - the counter value to later pass to aw_etpu_i2c_seq_retry()
+ *		is returned at this location.
+ * seq - the value returned by aw_etpu_i2c_seq_begin().
+ *
+ * aw_etpu_i2c_seq_begin() returns FS_ETPU_ERROR_NOT_READY if an update
+ * is in progress, aw_etpu_i2c_seq_retry() returns FS_ETPU_ERROR_NOT_READY
+ * if an update occurred since the begin; otherwise pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_seq_begin(
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint32_t seq_offset,
+    uint32_t* seq_ptr);
+int32_t aw_etpu_i2c_seq_retry(
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint32_t seq_offset,
+    uint32_t seq);
+
+/****************************************************************
+ * Read a set of channel frame fields as one coherent snapshot,
+ * retrying up to ETPU_I2C_SEQ_READ_RETRIES times if the eTPU updates
+ * them during the read.  Unlike fs_etpu_coherent_read_24/32_ext this
+ * handles any number of fields, needs no SDM scratch and does not
+ * stall the host on the CDC.
+ *
+ * channel - the I2C eTPU base channel (master or slave)
+ * seq_offset - _CPBA24_I2C_master__result_seq_ or
+ *		_CPBA24_I2C_slave__result_seq_.
+ * fields - array of field descriptors; the value member of each is
+ *		filled in.
+ * field_cnt - number of entries in fields.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if no stable snapshot could be
+ * taken (e.g. a transfer is in progress), other failure code, or
+ * pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_seq_read_fields(
+    ETPU_MODULE em,
+    uint8_t channel,
+    uint32_t seq_offset,
+    struct aw_etpu_i2c_seq_field* fields,
+    uint32_t field_cnt);
+
+/****************************************************************
+ * As aw_etpu_i2c_seq_read_fields(), but through a channel frame
+ * pointer the caller already holds (e.g. the p_cpba of an
+ * initialized instance), optionally copying an SDM buffer inside
+ * the same snapshot.
+ *
+ * p_frame - host address of the channel frame.
+ * p_copy - the buffer to copy, or NULL for none.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if no stable snapshot could be
+ * taken, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_seq_read_frame(
+    volatile uint8_t* p_frame,
+    uint32_t seq_offset,
+    struct aw_etpu_i2c_seq_field* fields,
+    uint32_t field_cnt,
+    struct aw_etpu_i2c_seq_copy* p_copy);
+
+
 #ifdef __cplusplus
 }
 #endif
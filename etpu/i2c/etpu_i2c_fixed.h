@@ -0,0 +1,180 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_fixed.h
+*
+* DESCRIPTION: Compile-time checked fast path for I2C instances whose
+* eTPU module and base channel are fixed at build time.
+*
+* Most systems assign each I2C bus a fixed module and channel group.  For
+* those, the channel group can be validated by the compiler rather than on
+* every call, and the channel offsets folded into constants.  The helpers
+* below operate on an instance that has been initialized with
+* aw_etpu_i2c_master_init()/aw_etpu_i2c_slave_init(); without
+* ETPU_I2C_PARAMETER_CHECK each reduces to the required SDM and HSRR
+* accesses.  The channel frame itself is allocated at run time, so its
+* fields are reached through the overlay pointers cached in the instance.
+*
+* The helpers name the channel group by the tag it was checked under, so
+* a group that was not checked does not compile.  The tag records the
+* module and base channel; with ETPU_I2C_PARAMETER_CHECK the helpers
+* return FS_ETPU_ERROR_VALUE if the instance passed is not the one on
+* that channel group.  Put the checks in a header shared by every file
+* that uses the helpers (e.g. etpu_gct.h).
+*
+* Usage:
+*   AW_ETPU_I2C_CHECK_CHANNEL_GROUP(EM_AB, ETPU_I2C_MASTER_BASE_CHAN, i2c_master);
+*   ...
+*   aw_etpu_i2c_master_fixed_transmit(&i2c_master_instance, i2c_master,
+*       0x64, 4, p_buf);
+*
+**************************************************************************/
+
+#ifndef __ETPU_I2C_FIXED_H
+#define __ETPU_I2C_FIXED_H
+
+#include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_i2c_master.h"
+#include "etpu_i2c_slave.h"
+#include "etpu_i2c_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Compile-time assertion; a false condition produces a negative array size
+ * error naming the offending tag. */
+#define AW_ETPU_I2C_STATIC_ASSERT(cond, tag) \
+	typedef char aw_etpu_i2c_static_assert_##tag[(cond) ? 1 : -1]
+
+/* Non-zero if the ETPU_I2C_CHANNELS_USED channels starting at base lie within
+ * one eTPU engine of module em (same rule as the run-time parameter check;
+ * eTPU-C has a single engine). */
+#define AW_ETPU_I2C_CHANNEL_GROUP_VALID(em, base) \
+	(!((((base) > (32 - ETPU_I2C_CHANNELS_USED)) && ((base) < 64)) || \
+	   ((base) > (96 - ETPU_I2C_CHANNELS_USED)) || \
+	   (((em) != EM_AB) && ((base) >= 32))))
+
+/* Reject a bad fixed channel group at compile time and record its module
+ * and base channel under tag for the helpers below.  Use at file scope,
+ * once per translation unit. */
+#define AW_ETPU_I2C_CHECK_CHANNEL_GROUP(em, base, tag) \
+	AW_ETPU_I2C_STATIC_ASSERT(AW_ETPU_I2C_CHANNEL_GROUP_VALID(em, base), tag##_channel_group); \
+	enum { aw_etpu_i2c_fixed_em_##tag = (em), aw_etpu_i2c_fixed_chan_##tag = (base) }
+
+/* The module and base channel checked under tag; undeclared if there was
+ * no check. */
+#define AW_ETPU_I2C_FIXED_EM(tag)	aw_etpu_i2c_fixed_em_##tag
+#define AW_ETPU_I2C_FIXED_CHAN(tag)	aw_etpu_i2c_fixed_chan_##tag
+
+/* Non-zero if the instance is initialized on the given channel group. */
+#define AW_ETPU_I2C_FIXED_INSTANCE_VALID(p_inst, em_, base_chan_num_) \
+	((p_inst)->p_etpu && ((p_inst)->em == (em_)) && ((p_inst)->base_chan_num == (base_chan_num_)))
+
+
+/****************************************************************
+ * Fast-path master transfer start.  tag is the one the instance's
+ * channel group was checked under with
+ * AW_ETPU_I2C_CHECK_CHANNEL_GROUP(), so that the SCL_out HSRR
+ * address is resolved by the compiler.  header is the complete
+ * header byte (address and R/W bit).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress or the
+ * previous request has not been taken by the eTPU yet, other failure
+ * code, or pass (0).
+ ****************************************************************/
+#define aw_etpu_i2c_master_fixed_start(p_inst, tag, header, buffer_size, buffer_ptr) \
+	aw_etpu_i2c_master_fixed_start_chan((p_inst), AW_ETPU_I2C_FIXED_EM(tag), AW_ETPU_I2C_FIXED_CHAN(tag), \
+		(header), (buffer_size), (buffer_ptr))
+
+#define aw_etpu_i2c_master_fixed_transmit(p_inst, tag, slave_address, buffer_size, buffer_ptr) \
+	aw_etpu_i2c_master_fixed_start((p_inst), tag, \
+		AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_WRITE_MESSAGE), (buffer_size), (buffer_ptr))
+
+#define aw_etpu_i2c_master_fixed_receive(p_inst, tag, slave_address, buffer_size, buffer_ptr) \
+	aw_etpu_i2c_master_fixed_start((p_inst), tag, \
+		AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_READ_MESSAGE), (buffer_size), (buffer_ptr))
+
+#define aw_etpu_i2c_master_fixed_latch_clear_error_flags(p_inst, tag) \
+	aw_etpu_i2c_master_fixed_latch_clear_error_flags_chan((p_inst), AW_ETPU_I2C_FIXED_EM(tag), AW_ETPU_I2C_FIXED_CHAN(tag))
+
+/****************************************************************
+ * Fast-path slave requests; tag as above.  Return failure code,
+ * or pass (0).
+ ****************************************************************/
+#define aw_etpu_i2c_slave_fixed_issue_data_ready(p_inst, tag) \
+	aw_etpu_i2c_slave_fixed_issue_data_ready_chan((p_inst), AW_ETPU_I2C_FIXED_EM(tag), AW_ETPU_I2C_FIXED_CHAN(tag))
+
+#define aw_etpu_i2c_slave_fixed_latch_clear_error_flags(p_inst, tag) \
+	aw_etpu_i2c_slave_fixed_latch_clear_error_flags_chan((p_inst), AW_ETPU_I2C_FIXED_EM(tag), AW_ETPU_I2C_FIXED_CHAN(tag))
+
+
+/* implementations; call them through the macros above */
+static inline int32_t aw_etpu_i2c_master_fixed_start_chan(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    ETPU_MODULE em,
+    uint8_t base_chan_num,
+    uint8_t header,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr)
+{
+	struct aw_etpu_i2c_cmd_words* p_cmd = (struct aw_etpu_i2c_cmd_words*)p_i2c_master_instance->p_cmd_list;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!AW_ETPU_I2C_FIXED_INSTANCE_VALID(p_i2c_master_instance, em, base_chan_num))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	if (p_i2c_master_instance->p_cpba->_in_use_flag ||
+		p_i2c_master_instance->p_etpu->CHAN[base_chan_num + ETPU_I2C_MASTER_SCL_OUT_OFFSET].HSRR.R)
+		return FS_ETPU_ERROR_NOT_READY;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(header, buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(p_i2c_master_instance->cmd_flags, buffer_size);
+	p_i2c_master_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_master_instance->p_etpu->CHAN[base_chan_num + ETPU_I2C_MASTER_SCL_OUT_OFFSET].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+	return 0;
+}
+
+static inline int32_t aw_etpu_i2c_master_fixed_latch_clear_error_flags_chan(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    ETPU_MODULE em,
+    uint8_t base_chan_num)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!AW_ETPU_I2C_FIXED_INSTANCE_VALID(p_i2c_master_instance, em, base_chan_num))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	p_i2c_master_instance->p_etpu->CHAN[base_chan_num + ETPU_I2C_MASTER_SCL_IN_OFFSET].HSRR.R = ETPU_I2C_LATCH_CLEAR_ERRORS_HSR;
+	return 0;
+}
+
+
+static inline int32_t aw_etpu_i2c_slave_fixed_issue_data_ready_chan(
+    struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
+    ETPU_MODULE em,
+    uint8_t base_chan_num)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!AW_ETPU_I2C_FIXED_INSTANCE_VALID(p_i2c_slave_instance, em, base_chan_num))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	p_i2c_slave_instance->p_etpu->CHAN[base_chan_num + ETPU_I2C_SLAVE_SCL_OUT_OFFSET].HSRR.R = ETPU_I2C_SLAVE_DATA_READY;
+	return 0;
+}
+
+static inline int32_t aw_etpu_i2c_slave_fixed_latch_clear_error_flags_chan(
+    struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
+    ETPU_MODULE em,
+    uint8_t base_chan_num)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!AW_ETPU_I2C_FIXED_INSTANCE_VALID(p_i2c_slave_instance, em, base_chan_num))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	p_i2c_slave_instance->p_etpu->CHAN[base_chan_num + ETPU_I2C_SLAVE_SCL_IN_OFFSET].HSRR.R = ETPU_I2C_LATCH_CLEAR_ERRORS_HSR;
+	return 0;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ETPU_I2C_FIXED_H
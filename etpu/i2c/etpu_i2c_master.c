@@ -13,11 +13,24 @@
 **************************************************************************/
 
 #include "etpu_util_ext.h"
+#include "etpu_i2c.h"
 #include "etpu_i2c_master.h"
 #include "etpu_i2c_common.h"
 #include "etpu_set_defines.h"
 
 
+/* timeout in us to TCR1 ticks; tcr1_mhz is the TCR1 rate in counts/us */
+static int32_t aw_etpu_i2c_master_timeout_ticks(uint32_t tcr1_mhz, uint32_t timeout_us, uint32_t* ticks_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (tcr1_mhz && (timeout_us > ETPU_I2C_MASTER_TIMEOUT_MAX_TICKS / tcr1_mhz))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	*ticks_ptr = tcr1_mhz * timeout_us;
+	return 0;
+}
+
+
 int32_t aw_etpu_i2c_master_init(
     struct aw_i2c_master_instance_t *p_i2c_master_instance,
     struct aw_i2c_master_config_t   *p_i2c_master_config)
@@ -26,15 +39,32 @@ int32_t aw_etpu_i2c_master_init(
 	uint32_t *pba;	/* parameter base address for channel */
 	uint32_t tcr1_freq;
 	uint32_t bit_time_tcr1_cnt;
+	uint32_t byte_timeout;
+	uint32_t transfer_timeout;
+	uint32_t hold_timeout;
+	uint32_t retry_interval;
 	uint32_t i2c_master_cpba;
+	uint32_t frame[_FRAME_SIZE_I2C_master_ / 4];
+	uint32_t i;
 	uint8_t channel = p_i2c_master_instance->base_chan_num;
 	uint8_t priority = p_i2c_master_instance->priority;
 
+	// invalidate the handle until initialization succeeds
+	p_i2c_master_instance->p_etpu = 0;
+
 #ifdef ETPU_I2C_PARAMETER_CHECK
 	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
 		return FS_ETPU_ERROR_VALUE;
 	if (!priority || (priority > 3))
 		return FS_ETPU_ERROR_VALUE;
+	if ((p_i2c_master_config->nack_retries > ETPU_I2C_CMD_RETRY_MASK) ||
+		(p_i2c_master_config->nack_policy & ~ETPU_I2C_CMD_NACK_POLICY_MASK) ||
+		(p_i2c_master_config->hs_master_id > ETPU_I2C_HS_MASTER_ID_MASK))
+		return FS_ETPU_ERROR_VALUE;
+	// room for the two commands of a combined transfer
+	if (!p_i2c_master_config->p_cmd_buffer ||
+		(p_i2c_master_config->cmd_buffer_size < 2 * sizeof(struct aw_etpu_i2c_cmd_words)))
+		return FS_ETPU_ERROR_VALUE;
 #endif
 
     if (p_i2c_master_instance->em == EM_AB)
@@ -55,6 +85,12 @@ int32_t aw_etpu_i2c_master_init(
         tcr1_freq = etpu_c_tcr1_freq;
     }
 
+	if (aw_etpu_i2c_master_timeout_ticks(tcr1_freq / 1000000, p_i2c_master_config->byte_timeout_us, &byte_timeout) ||
+		aw_etpu_i2c_master_timeout_ticks(tcr1_freq / 1000000, p_i2c_master_config->transfer_timeout_us, &transfer_timeout) ||
+		aw_etpu_i2c_master_timeout_ticks(tcr1_freq / 1000000, p_i2c_master_config->hold_timeout_us, &hold_timeout) ||
+		aw_etpu_i2c_master_timeout_ticks(tcr1_freq / 1000000, p_i2c_master_config->retry_interval_us, &retry_interval))
+		return FS_ETPU_ERROR_VALUE;
+
 	/* Disable channels to assign function safely */
 	fs_etpu_disable_ext(p_i2c_master_instance->em, channel );
 	fs_etpu_disable_ext(p_i2c_master_instance->em, channel + 1 );
@@ -83,35 +119,75 @@ int32_t aw_etpu_i2c_master_init(
 	eTPU->CHAN[channel+2].CR.B.CPBA = i2c_master_cpba;
 	eTPU->CHAN[channel+3].CR.B.CPBA = i2c_master_cpba;
 
-    p_i2c_master_instance->p_cpba = (void*)pba;
-    p_i2c_master_instance->p_cpba_pse = (void*)((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+    p_i2c_master_instance->p_cpba = (volatile etpu_if_I2C_master_CHANNEL_FRAME*)pba;
+    if (p_i2c_master_instance->em == EM_AB)
+    {
+        p_i2c_master_instance->p_data_ram = (uint8_t*)fs_etpu_data_ram_start;
+        p_i2c_master_instance->p_cpba_pse = (volatile etpu_if_I2C_master_CHANNEL_FRAME_unsignedPSE*)
+            ((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+    }
+    else
+    {
+        p_i2c_master_instance->p_data_ram = (uint8_t*)fs_etpu_c_data_ram_start;
+        p_i2c_master_instance->p_cpba_pse = (volatile etpu_if_I2C_master_CHANNEL_FRAME_unsignedPSE*)
+            ((uint32_t)pba + (fs_etpu_c_data_ram_ext - fs_etpu_c_data_ram_start));
+    }
+    p_i2c_master_instance->p_cmd_list = (struct aw_etpu_i2c_transfer_cmd*)
+        (((uint32_t)p_i2c_master_config->p_cmd_buffer & 0x3fff) + p_i2c_master_instance->p_data_ram);
+    i = p_i2c_master_config->cmd_buffer_size / sizeof(struct aw_etpu_i2c_cmd_words);
+    p_i2c_master_instance->cmd_capacity = (i > 0xff) ? 0xff : i;
+    p_i2c_master_instance->cmd_flags = (p_i2c_master_config->nack_retries & ETPU_I2C_CMD_RETRY_MASK) |
+        (p_i2c_master_config->nack_policy & ETPU_I2C_CMD_NACK_POLICY_MASK) |
+        (p_i2c_master_config->retry_backoff ? ETPU_I2C_CMD_RETRY_BACKOFF : 0);
 
 	/* initialize the parameter values */
-	fs_memset32_ext(pba, 0, _FRAME_SIZE_I2C_master_); // zero everything
+	/* the frame is built in RAM and written in one burst, rather than */
+	/* zeroed then updated one field at a time over the peripheral bus */
+	for (i = 0; i < _FRAME_SIZE_I2C_master_ / 4; i++)
+		frame[i] = 0;
 
 	// calc the bit time first, then calc the individual timing constraints
 	bit_time_tcr1_cnt = tcr1_freq / (p_i2c_master_config->bit_rate_khz * 1000);
 
 	// configure clock signal to be symmetric
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tLOW_, (uint24_t)(bit_time_tcr1_cnt / 2));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tHIGH_, (uint24_t)(bit_time_tcr1_cnt / 2));
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tLOW_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tHIGH_, bit_time_tcr1_cnt / 2);
 
 	// use the half bit time for START/STOP timing as well
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tBUF_, (uint24_t)(bit_time_tcr1_cnt / 2));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tSU_STA_, (uint24_t)(bit_time_tcr1_cnt / 2));
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tBUF_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tSU_STA_, bit_time_tcr1_cnt / 2);
 	// NOTE: tHD_STA currently not used; tHIGH is used in its place.  Thus tHIGH must be >= to tHD_STA.
-	//fs_etpu_set_chan_local_24(channel, _CPBA24_I2C__tHD_STA_, (uint24_t)(bit_time_tcr1_cnt / 2));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tSU_STO_, (uint24_t)(bit_time_tcr1_cnt / 2));
+	//AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C__tHD_STA_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tSU_STO_, bit_time_tcr1_cnt / 2);
 
 	// data hold timing - make it a tenth of the low time
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tHD_DAT_, (uint24_t)(bit_time_tcr1_cnt / 20));
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tHD_DAT_, bit_time_tcr1_cnt / 20);
 
 	// maximum signal rise time (used primarily for clock stretch detection)
 	// make it a tenth of the bit time
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tr_max_, (uint24_t)(bit_time_tcr1_cnt / 10));
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__tr_max_, bit_time_tcr1_cnt / 10);
+
+	// the Hs-mode profile starts out the same as the F/S timing; the
+	// set_timing() interface provides the real one
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hs_tLOW_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hs_tHIGH_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hs_tSU_STA_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hs_tSU_STO_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hs_tHD_DAT_, bit_time_tcr1_cnt / 20);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hs_tr_max_, bit_time_tcr1_cnt / 10);
+	AW_ETPU_I2C_FRAME_SET_8(frame, _CPBA8_I2C_master__hs_master_code_, ETPU_I2C_HS_MASTER_CODE | p_i2c_master_config->hs_master_id);
 
 	// set the cmd buffer ptr
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__p_cmd_list_, ((uint32_t)p_i2c_master_config->p_cmd_buffer & 0x3fff) );
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__p_cmd_list_, (uint32_t)p_i2c_master_config->p_cmd_buffer & 0x3fff);
+
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__byte_timeout_, byte_timeout);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__transfer_timeout_, transfer_timeout);
+	AW_ETPU_I2C_FRAME_SET_8(frame, _CPBA8_I2C_master__auto_recover_, p_i2c_master_config->auto_recover ? 1 : 0);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__hold_timeout_, hold_timeout);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_master__retry_interval_, retry_interval);
+	AW_ETPU_I2C_FRAME_SET_8(frame, _CPBA8_I2C_master__multi_master_, p_i2c_master_config->multi_master ? 1 : 0);
+
+	fs_memcpy32_ext(pba, frame, _FRAME_SIZE_I2C_master_);
 
 	/* write FM (function mode) bits (not used currently) */
 	eTPU->CHAN[channel  ].SCR.R = 0;
@@ -152,6 +228,9 @@ int32_t aw_etpu_i2c_master_init(
 		(_FUNCTION_NUM_I2C_master_I2C_SDA_in_ << 16) +
 		i2c_master_cpba;
 
+	// handle is now valid
+	p_i2c_master_instance->p_etpu = eTPU;
+
 	return 0;
 }
 
@@ -159,12 +238,16 @@ int32_t aw_etpu_i2c_master_set_timing(
     struct aw_i2c_master_instance_t *p_i2c_master_instance,
     struct aw_i2c_master_config_t   *p_i2c_master_config)
 {
+	volatile etpu_if_I2C_master_CHANNEL_FRAME_unsignedPSE* p_cpba_pse = p_i2c_master_instance->p_cpba_pse;
 	uint32_t tcr1_freq;
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
+	uint32_t byte_timeout;
+	uint32_t transfer_timeout;
+	uint32_t hold_timeout;
+	uint32_t retry_interval;
 
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
 
     if (p_i2c_master_instance->em == EM_AB)
@@ -185,13 +268,39 @@ int32_t aw_etpu_i2c_master_set_timing(
 	// put it into counts/us (hz => mhz)
 	tcr1_freq /= 1000000;
 
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tLOW_, (uint24_t)((tcr1_freq * p_i2c_master_config->tLOW) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tHIGH_, (uint24_t)((tcr1_freq * p_i2c_master_config->tHIGH) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tBUF_, (uint24_t)((tcr1_freq * p_i2c_master_config->tBUF) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tSU_STA_, (uint24_t)((tcr1_freq * p_i2c_master_config->tSU_STA) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tSU_STO_, (uint24_t)((tcr1_freq * p_i2c_master_config->tSU_STO) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tHD_DAT_, (uint24_t)((tcr1_freq * p_i2c_master_config->tHD_DAT) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__tr_max_, (uint24_t)((tcr1_freq * p_i2c_master_config->tr_max) / 1000));
+	if (aw_etpu_i2c_master_timeout_ticks(tcr1_freq, p_i2c_master_config->byte_timeout_us, &byte_timeout) ||
+		aw_etpu_i2c_master_timeout_ticks(tcr1_freq, p_i2c_master_config->transfer_timeout_us, &transfer_timeout) ||
+		aw_etpu_i2c_master_timeout_ticks(tcr1_freq, p_i2c_master_config->hold_timeout_us, &hold_timeout) ||
+		aw_etpu_i2c_master_timeout_ticks(tcr1_freq, p_i2c_master_config->retry_interval_us, &retry_interval))
+		return FS_ETPU_ERROR_VALUE;
+
+	// the PSE overlay only updates the low 24 bits of each parameter,
+	// so the fields are written directly with no read-modify-write
+	p_cpba_pse->_tLOW = (tcr1_freq * p_i2c_master_config->tLOW) / 1000;
+	p_cpba_pse->_tHIGH = (tcr1_freq * p_i2c_master_config->tHIGH) / 1000;
+	p_cpba_pse->_tBUF = (tcr1_freq * p_i2c_master_config->tBUF) / 1000;
+	p_cpba_pse->_tSU_STA = (tcr1_freq * p_i2c_master_config->tSU_STA) / 1000;
+	p_cpba_pse->_tSU_STO = (tcr1_freq * p_i2c_master_config->tSU_STO) / 1000;
+	p_cpba_pse->_tHD_DAT = (tcr1_freq * p_i2c_master_config->tHD_DAT) / 1000;
+	p_cpba_pse->_tr_max = (tcr1_freq * p_i2c_master_config->tr_max) / 1000;
+	// a zero Hs-mode input keeps the profile value already in place
+	// (the init default)
+	if (p_i2c_master_config->hs_tLOW)
+		p_cpba_pse->_hs_tLOW = (tcr1_freq * p_i2c_master_config->hs_tLOW) / 1000;
+	if (p_i2c_master_config->hs_tHIGH)
+		p_cpba_pse->_hs_tHIGH = (tcr1_freq * p_i2c_master_config->hs_tHIGH) / 1000;
+	if (p_i2c_master_config->hs_tSU_STA)
+		p_cpba_pse->_hs_tSU_STA = (tcr1_freq * p_i2c_master_config->hs_tSU_STA) / 1000;
+	if (p_i2c_master_config->hs_tSU_STO)
+		p_cpba_pse->_hs_tSU_STO = (tcr1_freq * p_i2c_master_config->hs_tSU_STO) / 1000;
+	if (p_i2c_master_config->hs_tHD_DAT)
+		p_cpba_pse->_hs_tHD_DAT = (tcr1_freq * p_i2c_master_config->hs_tHD_DAT) / 1000;
+	if (p_i2c_master_config->hs_tr_max)
+		p_cpba_pse->_hs_tr_max = (tcr1_freq * p_i2c_master_config->hs_tr_max) / 1000;
+	p_cpba_pse->_byte_timeout = byte_timeout;
+	p_cpba_pse->_transfer_timeout = transfer_timeout;
+	p_cpba_pse->_hold_timeout = hold_timeout;
+	p_cpba_pse->_retry_interval = retry_interval;
 
 	return 0;
 }
@@ -202,43 +311,28 @@ int32_t aw_etpu_i2c_master_transmit(
     uint32_t buffer_size,
     uint8_t* buffer_ptr)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t in_use_flag;
-	struct aw_etpu_i2c_transfer_cmd* p_cmd;
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
+	struct aw_etpu_i2c_cmd_words* p_cmd;
 
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
-	if (buffer_size && !buffer_ptr)
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buffer_size && !buffer_ptr) || !AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
 		return FS_ETPU_ERROR_VALUE;
 #endif
 
-    if (p_i2c_master_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
-
 	// OK, set up transmit
 
 	// check ready flag first
-	in_use_flag = fs_etpu_get_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__in_use_flag_);
-	if (in_use_flag)
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
 		return FS_ETPU_ERROR_NOT_READY;
 
-	p_cmd = (struct aw_etpu_i2c_transfer_cmd*)(fs_etpu_get_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__p_cmd_list_) + 
-		fs_etpu_data_ram_start);
-	p_cmd->_header = (slave_address & ~ETPU_I2C_RW_MASK) | ETPU_I2C_WRITE_MESSAGE;
-	p_cmd->_p_buffer = ((uint32_t)buffer_ptr & 0x3fff);
-	p_cmd->_size = buffer_size;
+	p_cmd = (struct aw_etpu_i2c_cmd_words*)p_i2c_master_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_WRITE_MESSAGE), buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(p_i2c_master_instance->cmd_flags, buffer_size);
 
 	// set one cmd and go
-	fs_etpu_set_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__cmd_cnt_, 1 );
-	eTPU->CHAN[channel].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+	p_i2c_master_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
 
 	return 0;
 }
@@ -250,43 +344,100 @@ int32_t aw_etpu_i2c_master_receive(
     uint32_t buffer_size,
     uint8_t* buffer_ptr)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t in_use_flag;
-	struct aw_etpu_i2c_transfer_cmd* p_cmd;
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
+	struct aw_etpu_i2c_cmd_words* p_cmd;
 
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buffer_size && !buffer_ptr) || !AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
 		return FS_ETPU_ERROR_VALUE;
-	if (buffer_size && !buffer_ptr)
+#endif
+
+	// OK, set up receive
+
+	// check ready flag first
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_cmd = (struct aw_etpu_i2c_cmd_words*)p_i2c_master_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_READ_MESSAGE), buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(p_i2c_master_instance->cmd_flags, buffer_size);
+
+	// set one cmd and go
+	p_i2c_master_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_transmit10(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint16_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr)
+{
+	struct aw_etpu_i2c_cmd_words* p_cmd;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buffer_size && !buffer_ptr) ||
+		(slave_address > ETPU_I2C_ADDR10_MAX) ||
+		!AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
 		return FS_ETPU_ERROR_VALUE;
 #endif
 
-    if (p_i2c_master_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
+	// OK, set up transmit
+
+	// check ready flag first
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_cmd = (struct aw_etpu_i2c_cmd_words*)p_i2c_master_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0_10BIT(slave_address, ETPU_I2C_WRITE_MESSAGE, buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1_10BIT(p_i2c_master_instance->cmd_flags, buffer_size);
+
+	// set one cmd and go
+	p_i2c_master_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_receive10(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint16_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr)
+{
+	struct aw_etpu_i2c_cmd_words* p_cmd;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buffer_size && !buffer_ptr) ||
+		(slave_address > ETPU_I2C_ADDR10_MAX) ||
+		!AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
+		return FS_ETPU_ERROR_VALUE;
+#endif
 
 	// OK, set up receive
 
 	// check ready flag first
-	in_use_flag = fs_etpu_get_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__in_use_flag_);
-	if (in_use_flag)
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
 		return FS_ETPU_ERROR_NOT_READY;
 
-	p_cmd = (struct aw_etpu_i2c_transfer_cmd*)(fs_etpu_get_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__p_cmd_list_) + 
-		fs_etpu_data_ram_start);
-	p_cmd->_header = (slave_address & ~ETPU_I2C_RW_MASK) | ETPU_I2C_READ_MESSAGE;
-	p_cmd->_p_buffer = ((uint32_t)buffer_ptr & 0x3fff);
-	p_cmd->_size = buffer_size;
+	// the eTPU sends the address in write form, then the repeated START
+	// and the read header
+	p_cmd = (struct aw_etpu_i2c_cmd_words*)p_i2c_master_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0_10BIT(slave_address, ETPU_I2C_READ_MESSAGE, buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1_10BIT(p_i2c_master_instance->cmd_flags, buffer_size);
 
 	// set one cmd and go
-	fs_etpu_set_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__cmd_cnt_, 1 );
-	eTPU->CHAN[channel].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+	p_i2c_master_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
 
 	return 0;
 }
@@ -301,48 +452,34 @@ int32_t aw_etpu_i2c_master_combined_transfer(
     uint32_t buf2_size,
     uint8_t* buf2_ptr)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t in_use_flag;
-	struct aw_etpu_i2c_transfer_cmd* p_cmd;
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
+	struct aw_etpu_i2c_cmd_words* p_cmd;
 
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
-	if ((buf1_size && !buf1_ptr) || (buf2_size && !buf2_ptr))
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buf1_size && !buf1_ptr) || (buf2_size && !buf2_ptr) ||
+		!AW_ETPU_I2C_CMD_SIZE_VALID(buf1_size) || !AW_ETPU_I2C_CMD_SIZE_VALID(buf2_size) ||
+		(p_i2c_master_instance->cmd_capacity < 2))
 		return FS_ETPU_ERROR_VALUE;
 #endif
 
-    if (p_i2c_master_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
-
 	// OK, set up combined format transfer
 
 	// check ready flag first
-	in_use_flag = fs_etpu_get_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__in_use_flag_);
-	if (in_use_flag)
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
 		return FS_ETPU_ERROR_NOT_READY;
 
-	p_cmd = (struct aw_etpu_i2c_transfer_cmd*)(fs_etpu_get_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__p_cmd_list_) + 
-		fs_etpu_data_ram_start);
+	p_cmd = (struct aw_etpu_i2c_cmd_words*)p_i2c_master_instance->p_cmd_list;
 
-	p_cmd->_header = header1;
-	p_cmd->_p_buffer = ((uint32_t)buf1_ptr & 0x3fff);
-	p_cmd->_size = buf1_size;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(header1, buf1_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(p_i2c_master_instance->cmd_flags, buf1_size);
 	p_cmd++;
-	p_cmd->_header = header2;
-	p_cmd->_p_buffer = ((uint32_t)buf2_ptr & 0x3fff);
-	p_cmd->_size = buf2_size;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(header2, buf2_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(p_i2c_master_instance->cmd_flags, buf2_size);
 
 	// set two cmds and go
-	fs_etpu_set_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__cmd_cnt_, 2 );
-	eTPU->CHAN[channel].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+	p_i2c_master_instance->p_cpba->_cmd_cnt = 2;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
 
 	return 0;
 }
@@ -352,103 +489,395 @@ int32_t aw_etpu_i2c_master_raw_transfer(
     struct aw_etpu_i2c_transfer_cmd* cmd_buffer_ptr,
     uint32_t cmd_cnt)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t in_use_flag;
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
+	struct aw_etpu_i2c_transfer_cmd* p_cmd_list;
 
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!cmd_buffer_ptr || !cmd_cnt || (cmd_cnt > 0xff))
 		return FS_ETPU_ERROR_VALUE;
-	if (!cmd_buffer_ptr || !cmd_cnt)
+#endif
+
+	// check ready flag first
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	// OK, then kick off transfer
+
+	// keep the shadow in step so later single/combined transfers build
+	// their commands where the eTPU will look for them; all that is known
+	// of a new buffer is that it holds cmd_cnt commands
+	p_cmd_list = (struct aw_etpu_i2c_transfer_cmd*)
+		(((uint32_t)cmd_buffer_ptr & 0x3fff) + p_i2c_master_instance->p_data_ram);
+	if (p_cmd_list != p_i2c_master_instance->p_cmd_list)
+	{
+		p_i2c_master_instance->p_cmd_list = p_cmd_list;
+		p_i2c_master_instance->cmd_capacity = cmd_cnt;
+	}
+	p_i2c_master_instance->p_cpba_pse->_p_cmd_list = ((uint32_t)cmd_buffer_ptr & 0x3fff);
+	p_i2c_master_instance->p_cpba->_cmd_cnt = cmd_cnt;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_encoded_transfer(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!cmd_words_ptr || !cmd_cnt || (cmd_cnt > p_i2c_master_instance->cmd_capacity))
 		return FS_ETPU_ERROR_VALUE;
 #endif
 
-    if (p_i2c_master_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
+	// check ready flag first
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	// copy the whole list in one burst, then go
+	fs_memcpy32_ext((uint32_t*)p_i2c_master_instance->p_cmd_list, (uint32_t*)cmd_words_ptr,
+		cmd_cnt * sizeof(struct aw_etpu_i2c_cmd_words));
+	p_i2c_master_instance->p_cpba->_cmd_cnt = cmd_cnt;
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_get_read_data(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* buffer_ptr,
+    uint8_t* dest_buffer_ptr,
+    uint32_t size,
+    uint8_t* error_flags_ptr)
+{
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA8_I2C_master__error_flags_, 8, 0 },
+	};
+	struct aw_etpu_i2c_seq_copy copy;
+	int32_t err_code;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (size && (!buffer_ptr || !dest_buffer_ptr))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// the buffer may be passed in host or eTPU address space
+	copy.src = ((uint32_t)buffer_ptr & 0x3fff) + p_i2c_master_instance->p_data_ram;
+	copy.dest = dest_buffer_ptr;
+	copy.size = size;
+	copy.limit_field = ETPU_I2C_SEQ_NO_LIMIT;
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_master_instance->p_cpba,
+		_CPBA24_I2C_master__result_seq_, fields, 1, &copy);
+	if (err_code)
+		return err_code;
+
+	if (error_flags_ptr)
+		*error_flags_ptr = (uint8_t)fields[0].value;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_recover_bus(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+
+	// check ready flag first; a held bus must be released instead, and a
+	// bus in use by another master must not be clocked
+	if (p_i2c_master_instance->p_cpba->_in_use_flag || p_i2c_master_instance->p_cpba->_bus_held ||
+		p_i2c_master_instance->p_cpba->_bus_busy)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num+ETPU_I2C_MASTER_SDA_OUT_OFFSET].HSRR.R = ETPU_I2C_MASTER_BUS_RECOVERY_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_get_recovery_status(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* clocks_ptr,
+    uint8_t* error_flags_ptr)
+{
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA8_I2C_master__recovery_clocks_, 8, 0 },
+		{ _CPBA8_I2C_master__error_flags_, 8, 0 },
+	};
+	int32_t err_code;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!clocks_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// NOT_READY while a recovery or transfer is in progress
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_master_instance->p_cpba,
+		_CPBA24_I2C_master__result_seq_, fields, 2, 0);
+	if (err_code)
+		return err_code;
+
+	*clocks_ptr = (uint8_t)fields[0].value;
+	if (error_flags_ptr)
+		*error_flags_ptr = (uint8_t)fields[1].value;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_abort(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num+ETPU_I2C_MASTER_SDA_IN_OFFSET].HSRR.R = ETPU_I2C_MASTER_ABORT_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_hold_bus(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
 
 	// check ready flag first
-	in_use_flag = fs_etpu_get_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__in_use_flag_);
-	if (in_use_flag)
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
 		return FS_ETPU_ERROR_NOT_READY;
 
-	// OK, then kick off transfer
+	// consumed by the eTPU when the next transfer starts
+	p_i2c_master_instance->p_cpba->_hold_request = 1;
+
+	return 0;
+}
+
 
-	fs_etpu_set_chan_local_24_ext(p_i2c_master_instance->em, channel, _CPBA24_I2C_master__p_cmd_list_, ((uint32_t)cmd_buffer_ptr & 0x3fff) );
-	fs_etpu_set_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__cmd_cnt_, cmd_cnt );
-	eTPU->CHAN[channel].HSRR.R = ETPU_I2C_MASTER_START_TRANSFER_HSR;
+int32_t aw_etpu_i2c_master_request_hs(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+
+	// check ready flag first
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	// consumed by the eTPU when the next transfer starts
+	p_i2c_master_instance->p_cpba->_hs_request = 1;
 
 	return 0;
 }
 
 
-int32_t aw_etpu_i2c_master_latch_clear_error_flags(struct aw_i2c_master_instance_t *p_i2c_master_instance)
+int32_t aw_etpu_i2c_master_release_bus(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+
+	// check ready flag first
+	if (p_i2c_master_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num+ETPU_I2C_MASTER_SDA_IN_OFFSET].HSRR.R = ETPU_I2C_MASTER_RELEASE_BUS_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_is_bus_held(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* held_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!held_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-    if (p_i2c_master_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
-	eTPU->CHAN[channel+ETPU_I2C_MASTER_SCL_IN_OFFSET].HSRR.R = ETPU_I2C_LATCH_CLEAR_ERRORS_HSR;
+
+	*held_ptr = p_i2c_master_instance->p_cpba->_bus_held ? 1 : 0;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_get_attempts(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* attempts_ptr)
+{
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA8_I2C_master__attempts_, 8, 0 },
+	};
+	int32_t err_code;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!attempts_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_master_instance->p_cpba,
+		_CPBA24_I2C_master__result_seq_, fields, 1, 0);
+	if (err_code)
+		return err_code;
+
+	*attempts_ptr = (uint8_t)fields[0].value;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_get_failed_cmd(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* failed_cmd_ptr,
+    uint8_t* failed_cnt_ptr)
+{
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA8_I2C_master__failed_cmd_, 8, 0 },
+		{ _CPBA8_I2C_master__failed_cnt_, 8, 0 },
+	};
+	int32_t err_code;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!failed_cmd_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_master_instance->p_cpba,
+		_CPBA24_I2C_master__result_seq_, fields, 2, 0);
+	if (err_code)
+		return err_code;
+
+	*failed_cmd_ptr = (uint8_t)fields[0].value;
+	if (failed_cnt_ptr)
+		*failed_cnt_ptr = (uint8_t)fields[1].value;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_is_bus_busy(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* busy_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!busy_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	*busy_ptr = p_i2c_master_instance->p_cpba->_bus_busy ? 1 : 0;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_get_abort_status(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* aborted_ptr,
+    uint32_t* cmd_cnt_ptr,
+    uint32_t* byte_cnt_ptr)
+{
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA8_I2C_master__aborted_, 8, 0 },
+		{ _CPBA8_I2C_master__abort_cmd_cnt_, 8, 0 },
+		{ _CPBA24_I2C_master__abort_byte_cnt_, 24, 0 },
+	};
+	int32_t err_code;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!aborted_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// NOT_READY while a recovery or transfer is in progress
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_master_instance->p_cpba,
+		_CPBA24_I2C_master__result_seq_, fields, 3, 0);
+	if (err_code)
+		return err_code;
+
+	*aborted_ptr = (uint8_t)fields[0].value;
+	if (cmd_cnt_ptr)
+		*cmd_cnt_ptr = fields[1].value;
+	if (byte_cnt_ptr)
+		*byte_cnt_ptr = fields[2].value;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_master_latch_clear_error_flags(struct aw_i2c_master_instance_t *p_i2c_master_instance)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+	p_i2c_master_instance->p_etpu->CHAN[p_i2c_master_instance->base_chan_num+ETPU_I2C_MASTER_SCL_IN_OFFSET].HSRR.R = ETPU_I2C_LATCH_CLEAR_ERRORS_HSR;
 	return 0;
 }
 int32_t aw_etpu_i2c_master_get_running_error_flags(struct aw_i2c_master_instance_t *p_i2c_master_instance,
 												   uint8_t* error_flags_ptr)
 {
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 	if (!error_flags_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-	*error_flags_ptr = fs_etpu_get_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__error_flags_);
+	*error_flags_ptr = p_i2c_master_instance->p_cpba->_error_flags;
 	return 0;
 }
 int32_t aw_etpu_i2c_master_clear_running_error_flags(struct aw_i2c_master_instance_t *p_i2c_master_instance)
 {
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
-	fs_etpu_set_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__error_flags_, 0);
+	p_i2c_master_instance->p_cpba->_error_flags = 0;
 	return 0;
 }
 int32_t aw_etpu_i2c_master_get_latched_error_flags(struct aw_i2c_master_instance_t *p_i2c_master_instance,
 												   uint8_t* error_flags_ptr)
 {
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 	if (!error_flags_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-	*error_flags_ptr = fs_etpu_get_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__latched_error_flags_);
+	*error_flags_ptr = p_i2c_master_instance->p_cpba->_latched_error_flags;
 	return 0;
 }
 int32_t aw_etpu_i2c_master_clear_latched_error_flags(struct aw_i2c_master_instance_t *p_i2c_master_instance)
 {
-	uint8_t channel = p_i2c_master_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_master_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
-	fs_etpu_set_chan_local_8_ext(p_i2c_master_instance->em, channel, _CPBA8_I2C_master__latched_error_flags_, 0);
+	p_i2c_master_instance->p_cpba->_latched_error_flags = 0;
 	return 0;
 }
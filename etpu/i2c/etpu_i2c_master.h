@@ -17,6 +17,7 @@
 
 #include "typedefs.h"	/* type definitions for eTPU interface */
 #include "etpu_util_ext.h"
+#include "etpu_auto_api.h"	/* channel frame overlays (etpu_set_struct.h) */
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,8 +27,15 @@ extern "C" {
 * Type Definitions
 *******************************************************************************/
 
+struct aw_etpu_i2c_transfer_cmd;
+
 /** A structure to represent an instance of I2C_master
- *  It includes static I2C_master initialization items. */
+ *  It includes static I2C_master initialization items.  Once
+ *  aw_etpu_i2c_master_init() succeeds it also serves as a validated
+ *  handle: the remaining members cache the module base, the channel
+ *  frame overlays and shadows of static configuration so that the
+ *  transfer calls do not need to re-check the channel or re-read
+ *  CPBA and static parameters from the eTPU. */
 struct aw_i2c_master_instance_t
 {
     ETPU_MODULE         em;
@@ -43,8 +51,23 @@ struct aw_i2c_master_instance_t
      *		that does most of the servicing and work, but they are
      *		assigned the same priority as SCL_out. */
     uint8_t             priority;
-    void                *p_cpba;        /* set during initialization */
-    void                *p_cpba_pse;    /* set during initialization */
+    volatile etpu_if_I2C_master_CHANNEL_FRAME              *p_cpba;        /* set during initialization */
+    volatile etpu_if_I2C_master_CHANNEL_FRAME_unsignedPSE  *p_cpba_pse;    /* set during initialization */
+    /* p_etpu - the eTPU module base; non-NULL only once initialization
+     *		has succeeded. */
+    volatile struct eTPU_struct         *p_etpu;        /* set during initialization */
+    /* p_data_ram - host address of the module SDM (eTPU address 0). */
+    uint8_t                             *p_data_ram;    /* set during initialization */
+    /* p_cmd_list - host address of the command list the channel frame
+     *		currently points to (shadow of _p_cmd_list). */
+    struct aw_etpu_i2c_transfer_cmd     *p_cmd_list;    /* set during initialization */
+    /* cmd_capacity - number of commands the list at p_cmd_list can hold
+     *		(at most 255, the range of _cmd_cnt). */
+    uint8_t                             cmd_capacity;  /* set during initialization */
+    /* cmd_flags - flags given to the commands built by the transmit,
+     *		receive and combined transfer calls (from nack_retries,
+     *		nack_policy and retry_backoff). */
+    uint8_t                             cmd_flags;     /* set during initialization */
 };
 
 /** A structure to represent a configuration of I2C_master.
@@ -55,6 +78,10 @@ struct aw_i2c_master_config_t
      *		used for setting up transfer commands.  It should be at least 16 bytes
      *		in size in order to allow configuration of a combined transfer. */
     uint8_t             *p_cmd_buffer;
+    /* cmd_buffer_size - size of the p_cmd_buffer buffer in bytes; at least
+     *		16.  Bounds the number of commands that
+     *		aw_etpu_i2c_master_encoded_transfer() may copy into it. */
+    uint32_t            cmd_buffer_size;
     /* bit_rate_khz - the bit rate in kHz.  By default the initialization function
      *		derives all the various bit timings from this rate.  The
      *		aw_etpu_i2c_master_set_timing() interface can be used to override
@@ -82,9 +109,89 @@ struct aw_i2c_master_config_t
     uint32_t            tHD_DAT;
     /* tr_max - maximum rise time for the signals, in ns. */
     uint32_t            tr_max;
+
+    /* byte_timeout_us - maximum time in us for one byte of a transfer (9 clocks,
+     *		including any clock stretching by a slave), or 0 for no limit.
+     *		A transfer that exceeds it is abandoned with ETPU_I2C_MASTER_TIMEOUT
+     *		and ended with a bus recovery and STOP (which may add
+     *		ETPU_I2C_MASTER_BUS_STUCK).  Used by the init and set_timing
+     *		functions. */
+    uint32_t            byte_timeout_us;
+    /* transfer_timeout_us - maximum time in us for a complete transfer, from
+     *		its START, or 0 for no limit.  As byte_timeout_us otherwise.  Each
+     *		timeout must be below ETPU_I2C_MASTER_TIMEOUT_MAX_TICKS TCR1 ticks. */
+    uint32_t            transfer_timeout_us;
+
+    /* auto_recover - when non-zero, a transfer that finds SDA held low is
+     *		preceded by a bus recovery (see aw_etpu_i2c_master_recover_bus());
+     *		the transfer is only issued if the recovery succeeds.  Used by
+     *		the init function. */
+    uint8_t             auto_recover;
+
+    /* nack_retries - number of times (0 to ETPU_I2C_CMD_RETRY_MASK) a command
+     *		built by the transmit, receive and combined transfer calls is
+     *		retried by the eTPU when the slave NACKs it.  Commands passed to
+     *		the raw and encoded transfer calls carry their own count.  Used
+     *		by the init function. */
+    uint8_t             nack_retries;
+    /* nack_policy - what a command built by the transmit, receive and
+     *		combined transfer calls does once it has failed (NACKed after
+     *		its retries): ETPU_I2C_CMD_NACK_CONTINUE goes on to the next
+     *		command, ETPU_I2C_CMD_NACK_STOP ends the transfer with a STOP.
+     *		Used by the init function. */
+    uint8_t             nack_policy;
+    /* retry_interval_us - bus free time in us added before a NACKed command
+     *		is retried, giving a busy device time to finish.  As
+     *		byte_timeout_us otherwise. */
+    uint32_t            retry_interval_us;
+    /* retry_backoff - when non-zero, a command built by the transmit,
+     *		receive and combined transfer calls waits twice as long before
+     *		each further retry (ETPU_I2C_CMD_RETRY_BACKOFF); otherwise every
+     *		retry waits retry_interval_us.  Used by the init function. */
+    uint8_t             retry_backoff;
+
+    /* hold_timeout_us - maximum time in us a bus held by
+     *		aw_etpu_i2c_master_hold_bus() may stay held before the eTPU forces
+     *		a STOP (setting ETPU_I2C_MASTER_HOLD_TIMEOUT), or 0 for no limit.  As
+     *		byte_timeout_us otherwise. */
+    uint32_t            hold_timeout_us;
+
+    /* multi_master - when non-zero, the bus is shared with other masters:
+     *		the eTPU checks arbitration on every bit it sends, and defers a
+     *		START while another master has the bus (between its START and
+     *		STOP).  A transfer that loses arbitration ends at once, without a
+     *		STOP, and sets ETPU_I2C_MASTER_ARB_LOST; the host may request it
+     *		again, and it starts once the other master's STOP is seen.  Used
+     *		by the init function. */
+    uint8_t             multi_master;
+
+    /* hs_tLOW, hs_tHIGH, hs_tSU_STA, hs_tSU_STO, hs_tHD_DAT, hs_tr_max - the
+     *		Hs-mode timing profile in ns, as tLOW to tr_max above, used from
+     *		the repeated START that follows the master code to the STOP of a
+     *		transfer requested with aw_etpu_i2c_master_request_hs().  Only
+     *		used by the set_timing() interface, where a 0 leaves that value
+     *		as it was; init sets the profile to the default F/S timing.  The
+     *		eTPU keeps both profiles as they were set and only copies the one
+     *		in use at the start of a transfer, so they may be changed at any
+     *		time, taking effect with the next transfer. */
+    uint32_t            hs_tLOW;
+    uint32_t            hs_tHIGH;
+    uint32_t            hs_tSU_STA;
+    uint32_t            hs_tSU_STO;
+    uint32_t            hs_tHD_DAT;
+    uint32_t            hs_tr_max;
+    /* hs_master_id - the master id (0 to ETPU_I2C_HS_MASTER_ID_MASK) in the
+     *		master code sent before an Hs-mode transfer; each Hs master on a
+     *		bus needs its own.  Used by the init function. */
+    uint8_t             hs_master_id;
 };
 
 
+// timeouts must be below half the 24-bit TCR1 range, as the eTPU
+// compares deadlines as signed values
+#define ETPU_I2C_MASTER_TIMEOUT_MAX_TICKS	0x7fffff
+
+
 // define the bitfield order for compiler
 #define MSB_BITFIELD_ORDER
 //#define LSB_BITFIELD_ORDER
@@ -94,22 +201,107 @@ struct aw_etpu_i2c_transfer_cmd
 {
 #if defined(MSB_BITFIELD_ORDER)
 	uint32_t _header : 8;      /* header/address byte */
-	uint32_t _p_buffer: 24;    /* pointer to data buffer in eTPU memory */
+	uint32_t _addr10 : 8;      /* second address byte (A7-A0) of an ETPU_I2C_CMD_ADDR10
+	                              command, else 0 */
+	uint32_t _p_buffer: 16;    /* pointer to data buffer in eTPU memory */
 #elif defined(LSB_BITFIELD_ORDER)
-	uint32_t _p_buffer: 24;
+	uint32_t _p_buffer: 16;
+	uint32_t _addr10 : 8;
 	uint32_t _header : 8;
 #else
 #error Must define either MSB_BITFIELD_ORDER or LSB_BITFIELD_ORDER
 #endif
-	uint32_t _size;            /* data transfer size in bytes */
+	uint32_t _size;            /* data transfer size in bytes, at most 0xffffff.  Bits
+	                              31-24 carry the command flags (ETPU_I2C_CMD_*, see
+	                              AW_ETPU_I2C_CMD_WORD1()); a plain size leaves them 0 */
+};
+
+// pre-encoded form of a transfer command - the two 32-bit words the eTPU
+// reads.  Either bitfield order places _header in the most significant byte
+// of the first word, so the encoding does not depend on the host compiler.
+// Building commands this way replaces the read-modify-write bitfield stores
+// into SDM with plain word stores (or a single fs_memcpy32_ext burst).
+struct aw_etpu_i2c_cmd_words
+{
+	uint32_t header_buffer;    /* header << 24 | addr10 << 16 | eTPU address of data buffer */
+	uint32_t size;             /* flags << 24 | data transfer size in bytes */
 };
 
+// Command encoding.  The AW_ETPU_I2C_ENCODE_* and AW_ETPU_I2C_CMD_WORD*
+// macros only place values in their fields; they are meant for values
+// that have already been checked (as the transfer functions do under
+// ETPU_I2C_PARAMETER_CHECK).  AW_ETPU_I2C_HEADER, AW_ETPU_I2C_HEADER10 and
+// the AW_ETPU_I2C_CMD_WORDS* initializers are for constant arguments and
+// do not compile if an address, flags byte or size is out of range.
+
+// 0 if cond holds, otherwise a negative array size error; cond must be a
+// constant expression
+#define AW_ETPU_I2C_CONST_CHECK(cond) \
+	(0 * sizeof(char[(cond) ? 1 : -1]))
+// non-zero if size can be carried by the 24-bit size field
+#define AW_ETPU_I2C_CMD_SIZE_VALID(size) \
+	((uint32_t)(size) <= 0x00ffffff)
+// check a constant header byte, flags byte and size.  A 7-bit slave
+// address is a header with bit 0 clear; a plain command cannot carry
+// ETPU_I2C_CMD_ADDR10, which needs the second address byte.
+#define AW_ETPU_I2C_CHECK_CMD(header, flags, size) \
+	AW_ETPU_I2C_CONST_CHECK((((header) & ~0xff) == 0) && \
+		(((flags) & ~0xff) == 0) && !((flags) & ETPU_I2C_CMD_ADDR10) && \
+		AW_ETPU_I2C_CMD_SIZE_VALID(size))
+#define AW_ETPU_I2C_CHECK_RW(rw) \
+	(((rw) & ~ETPU_I2C_RW_MASK) == 0)
+
+// header byte from a 7-bit slave address (in bits 7-1) and R/W flag; bit 0
+// of the address is replaced by the R/W flag
+#define AW_ETPU_I2C_ENCODE_HEADER(address, rw) \
+	((uint8_t)(((address) & ~ETPU_I2C_RW_MASK) | ((rw) & ETPU_I2C_RW_MASK)))
+// the same for constant arguments; the address must have bit 0 clear
+#define AW_ETPU_I2C_HEADER(address, rw) \
+	((uint8_t)(AW_ETPU_I2C_ENCODE_HEADER(address, rw) + \
+		AW_ETPU_I2C_CONST_CHECK((((address) & ~0xfe) == 0) && AW_ETPU_I2C_CHECK_RW(rw))))
+// first command word; buffer_ptr may be in host or eTPU address space
+#define AW_ETPU_I2C_CMD_WORD0(header, buffer_ptr) \
+	((((uint32_t)(uint8_t)(header)) << 24) | ((uint32_t)(buffer_ptr) & 0x3fff))
+#define AW_ETPU_I2C_CMD_WORD1(flags, size) \
+	((((uint32_t)(uint8_t)(flags)) << 24) | ((uint32_t)(size) & 0x00ffffff))
+// initializers for a struct aw_etpu_i2c_cmd_words
+#define AW_ETPU_I2C_CMD_WORDS(header, buffer_ptr, size) \
+	AW_ETPU_I2C_CMD_WORDS_FLAGS(header, buffer_ptr, 0, size)
+#define AW_ETPU_I2C_CMD_WORDS_FLAGS(header, buffer_ptr, flags, size) \
+	{ AW_ETPU_I2C_CMD_WORD0(header, buffer_ptr), \
+	  AW_ETPU_I2C_CMD_WORD1(flags, size) + AW_ETPU_I2C_CHECK_CMD(header, flags, size) }
+
+// 10-bit addressing (ETPU_I2C_CMD_ADDR10).  The header is the first address
+// byte, 11110 A9 A8 R/W; the second (A7-A0) has its own byte in the first
+// command word.  A command following a 10-bit command to the same slave may
+// use the short read form instead: a plain command whose header is
+// AW_ETPU_I2C_HEADER10(address, ETPU_I2C_READ_MESSAGE).
+#define AW_ETPU_I2C_ENCODE_HEADER10(address, rw) \
+	((uint8_t)(ETPU_I2C_ADDR10_HEADER | (((address) >> 7) & 0x06) | ((rw) & ETPU_I2C_RW_MASK)))
+// the same for constant arguments; the address must be 0 - 0x3ff
+#define AW_ETPU_I2C_HEADER10(address, rw) \
+	((uint8_t)(AW_ETPU_I2C_ENCODE_HEADER10(address, rw) + \
+		AW_ETPU_I2C_CONST_CHECK(((uint32_t)(address) <= ETPU_I2C_ADDR10_MAX) && AW_ETPU_I2C_CHECK_RW(rw))))
+#define AW_ETPU_I2C_CMD_WORD0_10BIT(address, rw, buffer_ptr) \
+	(AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_ENCODE_HEADER10(address, rw), buffer_ptr) | \
+	 (((uint32_t)(uint8_t)(address)) << 16))
+#define AW_ETPU_I2C_CMD_WORD1_10BIT(flags, size) \
+	AW_ETPU_I2C_CMD_WORD1((flags) | ETPU_I2C_CMD_ADDR10, size)
+#define AW_ETPU_I2C_CMD_WORDS_10BIT(address, rw, buffer_ptr, flags, size) \
+	{ AW_ETPU_I2C_CMD_WORD0_10BIT(address, rw, buffer_ptr) + \
+	    AW_ETPU_I2C_CONST_CHECK(((uint32_t)(address) <= ETPU_I2C_ADDR10_MAX) && AW_ETPU_I2C_CHECK_RW(rw)), \
+	  AW_ETPU_I2C_CMD_WORD1_10BIT(flags, size) + \
+	    AW_ETPU_I2C_CONST_CHECK((((flags) & ~0xff) == 0) && AW_ETPU_I2C_CMD_SIZE_VALID(size)) }
 
 /****************************************************************
  * I2C Master eTPU app initialization.  This one routine initializes all
  * four eTPU channels that act together as an I2C master.  Four consecutive
  * channels must be used for an I2C master.
  *
+ * The channel group is validated here, once; on success the instance
+ * becomes a handle for the calls below, which then only check that
+ * the instance was initialized (FS_ETPU_ERROR_UNINITIALIZED if not).
+ *
  * Returns failure code, or pass (0).
  ****************************************************************/
 int32_t aw_etpu_i2c_master_init(
@@ -136,7 +328,7 @@ int32_t aw_etpu_i2c_master_set_timing(
  *		is 0 and will be filled in based upon read/write.
  * buf_size - the size in bytes of the data to be transmitted.  It
  *		does not include the header byte that is made out of the
- *		slave address.
+ *		slave address.  At most 0xffffff.
  * buffer_ptr - the buffer from which data is transmitted.  The buffer
  *		must reside in eTPU data memory (SDM).
  *
@@ -158,7 +350,7 @@ int32_t aw_etpu_i2c_master_transmit(
  *		is 0 and will be filled in based upon read/write.
  * buf_size - the size in bytes of the data to be received.  It
  *		does not include the header byte that is made out of the
- *		slave address.
+ *		slave address.  At most 0xffffff.
  * buffer_ptr - the buffer into which data is to be received.  The buffer
  *		must reside in eTPU data memory (SDM).
  *
@@ -171,6 +363,47 @@ int32_t aw_etpu_i2c_master_receive(
     uint8_t* buffer_ptr);
 
 
+/****************************************************************
+ * Transmit a buffer of data to the specified 10-bit slave address.
+ * The header goes out as two bytes (11110 A9 A8 0, then A7-A0).
+ * Otherwise the same as aw_etpu_i2c_master_transmit().
+ *
+ * slave_address - the 10-bit slave address (0 - 0x3ff).
+ * buffer_size - the size in bytes of the data to be transmitted,
+ *		at most 0xffffff.
+ * buffer_ptr - the buffer from which data is transmitted.  The buffer
+ *		must reside in eTPU data memory (SDM).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_transmit10(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint16_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr);
+
+
+/****************************************************************
+ * Receive a data message from the specified 10-bit slave address.
+ * The address goes out in write form, then a repeated START and the
+ * first header byte with R/W set precede the data.  Otherwise the
+ * same as aw_etpu_i2c_master_receive().
+ *
+ * slave_address - the 10-bit slave address (0 - 0x3ff).
+ * buffer_size - the size in bytes of the data to be received, at
+ *		most 0xffffff.
+ * buffer_ptr - the buffer into which data is to be received.  The buffer
+ *		must reside in eTPU data memory (SDM).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_receive10(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint16_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr);
+
+
 /****************************************************************
  * Perform a combined transfer using the specified slave address.
  * The combined transfer allows for 2 back-to-back data transfers,
@@ -182,14 +415,14 @@ int32_t aw_etpu_i2c_master_receive(
  * buf1_size - the size in bytes of the data to be received or 
  *		transmitted in the first half of the combined transfer. It
  *		does not include the header byte that is made out of the
- *		slave address.
+ *		slave address.  At most 0xffffff.
  * buf1_ptr - the buffer for data receipt/transmit for the first
  *		transfer.  Buffer must be in eTPU data memory (SDM).
  * header2 - the header (address and R/W bit) for the second transfer.
  * buf2_size - the size in bytes of the data to be received or 
  *		transmitted in the second half of the combined transfer. It
  *		does not include the header byte that is made out of the
- *		slave address.
+ *		slave address.  At most 0xffffff.
  * buf2_ptr - the buffer for data receipt/transmit for the second
  *		transfer.  Buffer must be in eTPU data memory (SDM).
  *
@@ -213,8 +446,10 @@ int32_t aw_etpu_i2c_master_combined_transfer(
  *
  * cmd_buffer_ptr - a buffer in eTPU data memory (SDM) that holds 
  *		cmd_cnt transfer commands (see the type struct aw_etpu_i2c_transfer_cmd
- *		for the layout of each command.
- * cmd_cnt - number of commands in the cmd_buffer.
+ *		for the layout of each command.  A command set up through _header,
+ *		_p_buffer and _size alone is a plain 7-bit command: the flags are the
+ *		top byte of _size, and _addr10 is only read for ETPU_I2C_CMD_ADDR10.
+ * cmd_cnt - number of commands in the cmd_buffer (1 - 255).
  *
  * Returns failure code, or pass (0).
  ****************************************************************/
@@ -224,6 +459,237 @@ int32_t aw_etpu_i2c_master_raw_transfer(
     uint32_t cmd_cnt);
 
 
+/****************************************************************
+ * Start a transfer from a list of pre-encoded commands (see
+ * AW_ETPU_I2C_CMD_WORDS).  The list is copied into the instance's
+ * command buffer (p_cmd_buffer at initialization, or the buffer last
+ * passed to aw_etpu_i2c_master_raw_transfer()) with a single
+ * fs_memcpy32_ext burst.  When the full transfer completes, a channel
+ * interrupt is generated from the base channel of the I2C instance.
+ *
+ * cmd_words_ptr - host buffer holding cmd_cnt encoded commands.
+ * cmd_cnt - number of commands; no more than the command buffer holds
+ *		(cmd_buffer_size / 8 for p_cmd_buffer, or the cmd_cnt of the last
+ *		raw transfer) and at most 255.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_encoded_transfer(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt);
+
+
+/****************************************************************
+ * Copy the data received by the last transfer out of its eTPU buffer,
+ * together with the running error flags, as one coherent snapshot
+ * (see aw_etpu_i2c_seq_begin()).  Fails rather than returning a
+ * partially received buffer if a transfer is in progress.
+ *
+ * buffer_ptr - the eTPU data memory (SDM) buffer the data was
+ *		received into (as passed to receive/combined/raw transfer).
+ * dest_buffer_ptr - host buffer to copy the received data to.
+ * size - number of bytes to copy.
+ * error_flags_ptr - the byte location at which to write the error
+ *		flags.  Can be NULL.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, other
+ * failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_get_read_data(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* buffer_ptr,
+    uint8_t* dest_buffer_ptr,
+    uint32_t size,
+    uint8_t* error_flags_ptr);
+
+
+/****************************************************************
+ * Recover a bus on which a slave is holding SDA low, for example a
+ * slave that was reset part way through a read.  The eTPU checks the
+ * bus, issues SCL clocks until SDA is released (at most
+ * ETPU_I2C_MASTER_RECOVERY_MAX_CLOCKS), then generates a STOP.  When
+ * the recovery completes, a channel interrupt is generated from the
+ * base channel, as for a transfer.  If SCL is held low, or SDA is still
+ * low after the last clock or the STOP, ETPU_I2C_MASTER_BUS_STUCK is
+ * set in the error flags.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, the
+ * bus is held, or another master is using it, other failure code, or
+ * pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_recover_bus(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance);
+
+
+/****************************************************************
+ * Get the outcome of the last bus recovery as one coherent snapshot.
+ *
+ * clocks_ptr - the byte location at which to write the number of SCL
+ *		clocks the recovery issued (0 if SDA was not held low).
+ * error_flags_ptr - the byte location at which to write the running
+ *		error flags (ETPU_I2C_MASTER_BUS_STUCK if the recovery failed).
+ *		Can be NULL.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a recovery or transfer is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_get_recovery_status(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* clocks_ptr,
+    uint8_t* error_flags_ptr);
+
+
+/****************************************************************
+ * Abort the transfer in progress.  The eTPU ends it at the next byte
+ * boundary - the byte in flight completes (a read byte is NACKed), no
+ * further commands are issued, and a STOP is generated - so the bus is
+ * free again within about one byte time.  Completion is signalled by
+ * the usual channel interrupt.  A transfer whose START is still waiting
+ * (for a busy bus or a bus recovery) ends without one.  The request is
+ * ignored if no transfer is in progress, or if the last byte is already
+ * under way.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_abort(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance);
+
+
+/****************************************************************
+ * Have the next transfer requested end without a STOP, holding the
+ * bus (SCL low) for a following step of an atomic sequence such as a
+ * read-modify-write.  The transfer completes with the usual channel
+ * interrupt.  The next transfer request then continues with a repeated
+ * START instead of a START, and can itself be held again;
+ * aw_etpu_i2c_master_release_bus() instead ends the hold with a STOP.
+ * If hold_timeout_us is configured, the eTPU generates the STOP itself
+ * once it expires.  An aborted transfer is never held.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, other
+ * failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_hold_bus(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance);
+
+
+/****************************************************************
+ * Have the next transfer requested run in Hs-mode.  The eTPU sends
+ * the master code at the F/S timing, then a repeated START, and the
+ * transfer itself at the Hs-mode timing configured with
+ * aw_etpu_i2c_master_set_timing(); the STOP returns the bus to F/S
+ * mode.  A held Hs-mode transfer leaves the bus in Hs-mode, and the
+ * transfer that continues it runs in Hs-mode without a request.
+ *
+ * The eTPU thread load, not the timing, limits the rate: see the
+ * Hs-mode notes in etec_i2c_master.h.  A push-pull SCL, if wanted,
+ * is a pad setting made by the host for the whole bus.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, other
+ * failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_request_hs(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance);
+
+
+/****************************************************************
+ * End a held bus with a STOP.  Completion is signalled by a channel
+ * interrupt, as for a transfer.  The request is ignored if the bus is
+ * not held.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, other
+ * failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_release_bus(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance);
+
+
+/****************************************************************
+ * Find out whether the last transfer left the bus held.
+ *
+ * held_ptr - the byte location at which to write 1 if the bus is
+ *		held, else 0.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_is_bus_held(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* held_ptr);
+
+
+/****************************************************************
+ * Get the number of attempts made by the commands of the last
+ * transfer, as a coherent snapshot: one for each command issued plus
+ * one for each retry, saturating at 255.  A value equal to the number
+ * of commands issued means nothing was retried; which command failed,
+ * if any, is reported by aw_etpu_i2c_master_get_failed_cmd().
+ *
+ * attempts_ptr - the byte location at which to write the count.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, other
+ * failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_get_attempts(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* attempts_ptr);
+
+
+/****************************************************************
+ * Find out which command of the last transfer failed (was NACKed after
+ * any retries), as a coherent snapshot.  Under ETPU_I2C_CMD_NACK_CONTINUE
+ * several commands of a list may fail; the first is reported.
+ *
+ * failed_cmd_ptr - the byte location at which to write the index in the
+ *		command list of the first failed command, or
+ *		ETPU_I2C_MASTER_NO_FAILED_CMD if none failed.
+ * failed_cnt_ptr - the byte location at which to write the number of
+ *		commands that failed.  Can be NULL.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress, other
+ * failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_get_failed_cmd(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* failed_cmd_ptr,
+    uint8_t* failed_cnt_ptr);
+
+
+/****************************************************************
+ * Find out whether another master is using the bus (multi_master
+ * configurations; always 0 otherwise).  A transfer requested while it
+ * is 1 is started after that master's STOP.
+ *
+ * busy_ptr - the byte location at which to write 1 if the bus is
+ *		busy, else 0.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_is_bus_busy(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* busy_ptr);
+
+
+/****************************************************************
+ * Find out whether the last transfer was aborted and, if so, how far
+ * it got, as one coherent snapshot.
+ *
+ * aborted_ptr - the byte location at which to write 1 if the last
+ *		transfer was aborted, else 0.
+ * cmd_cnt_ptr - the location at which to write the number of commands
+ *		completed before the aborted one.  Can be NULL.
+ * byte_cnt_ptr - the location at which to write the number of data
+ *		bytes of the aborted command that were transferred.  Can be NULL.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a recovery or transfer is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_master_get_abort_status(
+    struct aw_i2c_master_instance_t *p_i2c_master_instance,
+    uint8_t* aborted_ptr,
+    uint32_t* cmd_cnt_ptr,
+    uint32_t* byte_cnt_ptr);
+
+
 /****************************************************************
  * Latch, clear and get the error flags associated with an I2C transfer.
  * The "latch and clear" interface does coherently latch the error
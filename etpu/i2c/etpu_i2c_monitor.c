@@ -0,0 +1,250 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_monitor.c
+*
+* DESCRIPTION: Implementation of API for initializing and controlling the
+* I2C bus monitor eTPU function.  See the .h file for API documentation.
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+* 1.1     J Diener   19/Oct/26     Add raw record drain for logging.
+*
+**************************************************************************/
+
+#include "etpu_util_ext.h"
+#include "etpu_i2c.h"
+#include "etpu_i2c_monitor.h"
+#include "etpu_i2c_common.h"
+#include "etpu_set_defines.h"
+
+
+int32_t aw_etpu_i2c_monitor_init(
+    struct aw_i2c_monitor_instance_t  *p_i2c_monitor_instance,
+    struct aw_i2c_monitor_config_t    *p_i2c_monitor_config)
+{
+    volatile struct eTPU_struct * eTPU;
+	uint32_t *pba;	/* parameter base address for channel */
+	uint32_t i2c_monitor_cpba;
+	uint32_t frame[_FRAME_SIZE_I2C_monitor_ / 4];
+	uint32_t i;
+	uint8_t *p_data_ram;
+	uint8_t channel = p_i2c_monitor_instance->base_chan_num;
+	uint8_t priority = p_i2c_monitor_instance->priority;
+
+	// invalidate the handle until initialization succeeds
+	p_i2c_monitor_instance->p_etpu = 0;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (((channel > (32 - ETPU_I2C_MONITOR_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_MONITOR_CHANNELS_USED)))
+		return FS_ETPU_ERROR_VALUE;
+	if (!priority || (priority > 3))
+		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_monitor_config->p_ring || ((uint32_t)p_i2c_monitor_config->p_ring & 7))
+		return FS_ETPU_ERROR_VALUE;
+	if ((p_i2c_monitor_config->ring_size < 2) || (p_i2c_monitor_config->ring_size > 0x00ffffff))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+    if (p_i2c_monitor_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+        p_data_ram = (uint8_t*)fs_etpu_data_ram_start;
+    }
+    else
+    {
+        eTPU = eTPU_C;
+        p_data_ram = (uint8_t*)fs_etpu_c_data_ram_start;
+    }
+
+	/* Disable channels to assign function safely */
+	fs_etpu_disable_ext(p_i2c_monitor_instance->em, channel );
+	fs_etpu_disable_ext(p_i2c_monitor_instance->em, channel + 1 );
+
+	/* allocate a channel frame if not already done so */
+	/* NOTE: this means that re-initialization of this channel (2 channels) */
+	/* must re-use the same channel frame allocation */
+	if (eTPU->CHAN[channel].CR.B.CPBA == 0 )
+	{
+		/* get parameter RAM
+		number of parameters passed from eTPU C code */
+		pba = fs_etpu_malloc_ext(p_i2c_monitor_instance->em, _FRAME_SIZE_I2C_monitor_);
+		if (pba == 0)
+			return (FS_ETPU_ERROR_MALLOC);
+	}
+	else /*set pba to what is in the CR register*/
+	{
+		pba = fs_etpu_get_cpba_ext(p_i2c_monitor_instance->em, channel);
+	}
+	// the channel pair shares the same channel frame
+	i2c_monitor_cpba = ((uint32_t)pba & 0x3fff)>>3;
+	eTPU->CHAN[channel  ].CR.B.CPBA = i2c_monitor_cpba;
+	eTPU->CHAN[channel+1].CR.B.CPBA = i2c_monitor_cpba;
+
+	p_i2c_monitor_instance->p_cpba = (volatile etpu_if_I2C_monitor_CHANNEL_FRAME*)pba;
+	if (p_i2c_monitor_instance->em == EM_AB)
+	{
+		p_i2c_monitor_instance->p_cpba_pse = (volatile etpu_if_I2C_monitor_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+	}
+	else
+	{
+		p_i2c_monitor_instance->p_cpba_pse = (volatile etpu_if_I2C_monitor_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_c_data_ram_ext - fs_etpu_c_data_ram_start));
+	}
+	p_i2c_monitor_instance->p_ring = ((uint32_t)p_i2c_monitor_config->p_ring & 0x3fff) + p_data_ram;
+	p_i2c_monitor_instance->ring_size = p_i2c_monitor_config->ring_size;
+
+	/* initialize the parameter values; head, tail and the overflow */
+	/* count start at 0 (empty ring) */
+	for (i = 0; i < _FRAME_SIZE_I2C_monitor_ / 4; i++)
+		frame[i] = 0;
+
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_monitor__p_ring_, (uint32_t)p_i2c_monitor_config->p_ring & 0x3fff);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_monitor__ring_size_, p_i2c_monitor_config->ring_size);
+
+	fs_memcpy32_ext(pba, frame, _FRAME_SIZE_I2C_monitor_);
+
+	/* no function modes */
+	eTPU->CHAN[channel+ETPU_I2C_MONITOR_SCL_IN_OFFSET].SCR.R = 0;
+	eTPU->CHAN[channel+ETPU_I2C_MONITOR_SDA_IN_OFFSET].SCR.R = 0;
+
+	/* write hsr to init the channels */
+	eTPU->CHAN[channel  ].HSRR.R = ETPU_I2C_INIT_HSR;
+	eTPU->CHAN[channel+1].HSRR.R = ETPU_I2C_INIT_HSR;
+
+	/* fully write channel configuration register */
+	/* channel   = SCL_in */
+	/* channel+1 = SDA_in */
+	/* this has the side-effect of starting the function running */
+	eTPU->CHAN[channel+ETPU_I2C_MONITOR_SCL_IN_OFFSET].CR.R = (priority << 28) +
+		(_ENTRY_TABLE_PIN_DIR_I2C_monitor_I2C_SCL_in_ << 25) +
+		(_ENTRY_TABLE_TYPE_I2C_monitor_I2C_SCL_in_ << 24) +
+		(_FUNCTION_NUM_I2C_monitor_I2C_SCL_in_ << 16) +
+		i2c_monitor_cpba;
+	eTPU->CHAN[channel+ETPU_I2C_MONITOR_SDA_IN_OFFSET].CR.R = (priority << 28) +
+		(_ENTRY_TABLE_PIN_DIR_I2C_monitor_I2C_SDA_in_ << 25) +
+		(_ENTRY_TABLE_TYPE_I2C_monitor_I2C_SDA_in_ << 24) +
+		(_FUNCTION_NUM_I2C_monitor_I2C_SDA_in_ << 16) +
+		i2c_monitor_cpba;
+
+	p_i2c_monitor_instance->shutdown.state = ETPU_I2C_SHUTDOWN_IDLE;
+
+	// handle is now valid
+	p_i2c_monitor_instance->p_etpu = eTPU;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_monitor_read_records(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance,
+    struct aw_etpu_i2c_monitor_record* records_ptr,
+    uint32_t max_cnt,
+    uint32_t* cnt_ptr)
+{
+	volatile etpu_if_I2C_monitor_CHANNEL_FRAME_unsignedPSE* p_cpba_pse = p_i2c_monitor_instance->p_cpba_pse;
+	volatile uint32_t* p_rec;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t word;
+	uint32_t cnt;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_monitor_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!cnt_ptr || (max_cnt && !records_ptr))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	// the eTPU writes a record before advancing the head past it, and
+	// only the host moves the tail, so the records in between are stable
+	head = 0x00ffffff & p_cpba_pse->_ring_head;
+	tail = 0x00ffffff & p_cpba_pse->_ring_tail;
+	for (cnt = 0; (cnt < max_cnt) && (tail != head); cnt++)
+	{
+		// two word reads per record; SDM is big-endian
+		p_rec = (volatile uint32_t*)(p_i2c_monitor_instance->p_ring + tail * ETPU_I2C_MONITOR_REC_SIZE);
+		word = p_rec[0];
+		records_ptr[cnt].type = (uint8_t)(word >> 24);
+		records_ptr[cnt].timestamp = word & 0x00ffffff;
+		word = p_rec[1];
+		records_ptr[cnt].data = (uint8_t)(word >> 24);
+		records_ptr[cnt].ack_time = word & 0x00ffffff;
+		if (++tail == p_i2c_monitor_instance->ring_size)
+			tail = 0;
+	}
+	// hand the slots back in one write
+	if (cnt)
+		p_cpba_pse->_ring_tail = tail;
+	*cnt_ptr = cnt;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_monitor_read_raw(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance,
+    uint32_t* words_ptr,
+    uint32_t max_cnt,
+    uint32_t* cnt_ptr)
+{
+	volatile etpu_if_I2C_monitor_CHANNEL_FRAME_unsignedPSE* p_cpba_pse = p_i2c_monitor_instance->p_cpba_pse;
+	volatile uint32_t* p_rec;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t cnt;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_monitor_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!cnt_ptr || (max_cnt && !words_ptr))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	// same hand-off as aw_etpu_i2c_monitor_read_records(), minus the decode
+	head = 0x00ffffff & p_cpba_pse->_ring_head;
+	tail = 0x00ffffff & p_cpba_pse->_ring_tail;
+	for (cnt = 0; (cnt < max_cnt) && (tail != head); cnt++)
+	{
+		p_rec = (volatile uint32_t*)(p_i2c_monitor_instance->p_ring + tail * ETPU_I2C_MONITOR_REC_SIZE);
+		*words_ptr++ = p_rec[0];
+		*words_ptr++ = p_rec[1];
+		if (++tail == p_i2c_monitor_instance->ring_size)
+			tail = 0;
+	}
+	if (cnt)
+		p_cpba_pse->_ring_tail = tail;
+	*cnt_ptr = cnt;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_monitor_get_overflow_cnt(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance,
+    uint32_t* overflow_cnt_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_monitor_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!overflow_cnt_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+	*overflow_cnt_ptr = 0x00ffffff & p_i2c_monitor_instance->p_cpba_pse->_overflow_cnt;
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_monitor_shutdown(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance)
+{
+	int32_t err_code;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_monitor_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+	err_code = aw_etpu_i2c_shutdown_step(&p_i2c_monitor_instance->shutdown,
+		p_i2c_monitor_instance->em, p_i2c_monitor_instance->base_chan_num, ETPU_I2C_MONITOR_CHANNELS_USED);
+	if (err_code)
+		return err_code;
+
+	// handle is no longer valid
+	p_i2c_monitor_instance->p_etpu = 0;
+
+	return 0;
+}
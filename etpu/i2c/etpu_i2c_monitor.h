@@ -0,0 +1,184 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_monitor.h
+*
+* DESCRIPTION: API for initializing and controlling the I2C eTPU function
+* (passive I2C bus monitor)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+* 1.1     J Diener   19/Oct/26     Add raw record drain for logging.
+*
+**************************************************************************/
+
+#ifndef __ETPU_I2C_MONITOR_H
+#define __ETPU_I2C_MONITOR_H
+
+#include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_util_ext.h"
+#include "etpu_auto_api.h"	/* channel frame overlays (etpu_set_struct.h) */
+#include "etpu_i2c.h"	/* non-blocking shutdown */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A structure to represent an instance of I2C_monitor
+ *  It includes static I2C_monitor initialization items.  Once
+ *  aw_etpu_i2c_monitor_init() succeeds it also serves as a validated
+ *  handle (see aw_i2c_master_instance_t). */
+struct aw_i2c_monitor_instance_t
+{
+    ETPU_MODULE         em;
+    /* base_chan_num - the base channel for the I2C eTPU bus monitor.  The
+     *		channels are defined as follows:
+     *			base_chan_num   - SCL_in
+     *			base_chan_num+1 - SDA_in */
+    uint8_t             base_chan_num;
+    /* priority - the priority assigned to both channels, with a range of
+     *		1 (low) to 3 (high).  The monitor must be serviced within the
+     *		START/STOP setup time of an SCL rising edge, so it normally runs
+     *		at the highest priority. */
+    uint8_t             priority;
+    volatile etpu_if_I2C_monitor_CHANNEL_FRAME             *p_cpba;        /* set during initialization */
+    volatile etpu_if_I2C_monitor_CHANNEL_FRAME_unsignedPSE *p_cpba_pse;    /* set during initialization */
+    /* p_etpu - the eTPU module base; non-NULL only once initialization
+     *		has succeeded. */
+    volatile struct eTPU_struct         *p_etpu;        /* set during initialization */
+    /* p_ring, ring_size - shadows of the ring configuration (host
+     *		address), kept by init. */
+    uint8_t                             *p_ring;        /* set during initialization */
+    uint32_t                            ring_size;     /* set during initialization */
+    /* shutdown - progress of aw_etpu_i2c_monitor_shutdown(). */
+    struct aw_etpu_i2c_shutdown_t       shutdown;      /* set during initialization */
+};
+
+/** A structure to represent a configuration of I2C_monitor. */
+struct aw_i2c_monitor_config_t
+{
+    /* p_ring - pointer to the ring buffer the monitor logs records into
+     *		(pointer must be in eTPU data space - SDM, but can be in host or
+     *		eTPU pointer address space).  It must be 8-byte aligned, as
+     *		buffers from aw_etpu_i2c_allocate_buffer() are, and hold
+     *		ring_size * ETPU_I2C_MONITOR_REC_SIZE bytes. */
+    uint8_t* p_ring;
+    /* ring_size - the number of records in the ring, at least 2.  One is
+     *		always left free, so ring_size - 1 records can be pending. */
+    uint32_t ring_size;
+};
+
+/** One decoded bus monitor record, see aw_etpu_i2c_monitor_read_records(). */
+struct aw_etpu_i2c_monitor_record
+{
+    /* type - ETPU_I2C_MONITOR_REC_xxx; ETPU_I2C_MONITOR_REC_NACK is or'ed
+     *		into a header or data byte that was not acknowledged */
+    uint8_t  type;
+    /* data - the header or data byte, else 0 */
+    uint8_t  data;
+    /* timestamp - 24-bit TCR1 value at the SDA edge of a START, repeated
+     *		START or STOP, or at the first SCL rising edge of a byte */
+    uint32_t timestamp;
+    /* ack_time - 24-bit TCR1 value at the ACK/NACK SCL rising edge of a
+     *		byte, else 0 */
+    uint32_t ack_time;
+};
+
+/****************************************************************
+ * I2C bus monitor initialization.  This one routine initializes
+ * both eTPU channels of a passive I2C bus monitor; two consecutive
+ * channels must be used, wired to the SCL and SDA lines.  The
+ * monitor never drives the bus.  The ring is emptied.
+ *
+ * The channel pair is validated here, once; on success the instance
+ * becomes a handle for the calls below, which then only check that
+ * the instance was initialized (FS_ETPU_ERROR_UNINITIALIZED if not).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_monitor_init(
+    struct aw_i2c_monitor_instance_t  *p_i2c_monitor_instance,
+    struct aw_i2c_monitor_config_t    *p_i2c_monitor_config);
+
+
+/****************************************************************
+ * Drain logged bus traffic.  Copies up to max_cnt of the oldest
+ * pending records, in the order they occurred, and releases their
+ * ring slots to the eTPU.  Call often enough that the ring does
+ * not fill: at 400 kHz a byte record is logged about every 23 us.
+ *
+ * records_ptr - the buffer to which to write the records.
+ * max_cnt - the number of records records_ptr can hold.
+ * cnt_ptr - the number of records copied is returned at this
+ *		location (0 if none were pending).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_monitor_read_records(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance,
+    struct aw_etpu_i2c_monitor_record* records_ptr,
+    uint32_t max_cnt,
+    uint32_t* cnt_ptr);
+
+
+/****************************************************************
+ * Drain logged bus traffic without decoding it, for logging to a
+ * capture file.  Same as aw_etpu_i2c_monitor_read_records(), but
+ * each record is copied as its two raw ring words: type and
+ * 24-bit timestamp, then data and 24-bit ack_time (see
+ * ETPU_I2C_MONITOR_REC_xxx_OFFSET).  Written out big-endian, as
+ * the words are in SDM, this is the capture format read by
+ * tools/i2c_monitor_decode.
+ *
+ * words_ptr - the buffer to which to write the records, 2 words
+ *		per record.
+ * max_cnt - the number of records words_ptr can hold.
+ * cnt_ptr - the number of records copied is returned at this
+ *		location (0 if none were pending).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_monitor_read_raw(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance,
+    uint32_t* words_ptr,
+    uint32_t max_cnt,
+    uint32_t* cnt_ptr);
+
+
+/****************************************************************
+ * Get the number of records the monitor has dropped because the
+ * ring was full (24-bit, wraps).  Records are dropped rather than
+ * overwritten, so those read are always in order; a change in this
+ * count between two drains marks a gap.
+ *
+ * overflow_cnt_ptr - pointer to the location to which to write
+ *		the count.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_monitor_get_overflow_cnt(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance,
+    uint32_t* overflow_cnt_ptr);
+
+
+/****************************************************************
+ * Shut down the bus monitor and disable its channels.  The
+ * instance must be re-initialized before it is used again.
+ *
+ * The shutdown does not wait on the eTPU: the first call issues
+ * the shutdown HSRs (once no other HSR is pending), and the call is
+ * repeated (e.g. from a periodic task) until it returns pass, at
+ * which point the channels are disabled.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY while the shutdown is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_monitor_shutdown(
+    struct aw_i2c_monitor_instance_t *p_i2c_monitor_instance);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ETPU_I2C_MONITOR_H
@@ -0,0 +1,372 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_multilane.c
+*
+* DESCRIPTION: Implementation of API for initializing and controlling the
+* I2C multi-lane master eTPU function.  See the .h file for API
+* documentation.
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+**************************************************************************/
+
+#include "etpu_util_ext.h"
+#include "etpu_i2c.h"
+#include "etpu_i2c_multilane.h"
+#include "etpu_i2c_common.h"
+#include "etpu_set_defines.h"
+
+
+int32_t aw_etpu_i2c_multilane_init(
+    struct aw_i2c_multilane_instance_t  *p_i2c_multilane_instance,
+    struct aw_i2c_multilane_config_t    *p_i2c_multilane_config)
+{
+    volatile struct eTPU_struct * eTPU;
+	uint32_t *pba;	/* parameter base address for channel */
+	uint32_t tcr1_freq;
+	uint32_t bit_time_tcr1_cnt;
+	uint32_t i2c_multilane_cpba;
+	uint32_t frame[_FRAME_SIZE_I2C_multilane_ / 4];
+	uint32_t i;
+	uint8_t *p_data_ram;
+	uint8_t channel = p_i2c_multilane_instance->base_chan_num;
+	uint8_t lane_cnt = p_i2c_multilane_instance->lane_cnt;
+	uint8_t chan_cnt = ETPU_I2C_MULTILANE_CHANNELS_USED(lane_cnt);
+	uint8_t priority = p_i2c_multilane_instance->priority;
+
+	// invalidate the handle until initialization succeeds
+	p_i2c_multilane_instance->p_etpu = 0;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!lane_cnt || (lane_cnt > ETPU_I2C_MULTILANE_MAX_LANES))
+		return FS_ETPU_ERROR_VALUE;
+	if (((channel > (32 - chan_cnt)) && (channel < 64)) || (channel > 96 - chan_cnt))
+		return FS_ETPU_ERROR_VALUE;
+	if (!priority || (priority > 3))
+		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_multilane_config->p_cmd_buffer || !p_i2c_multilane_config->bit_rate_khz)
+		return FS_ETPU_ERROR_VALUE;
+	if ((lane_cnt > 1) && !AW_ETPU_I2C_CMD_SIZE_VALID(p_i2c_multilane_config->lane_stride))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+    if (p_i2c_multilane_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+        p_data_ram = (uint8_t*)fs_etpu_data_ram_start;
+        if (channel < 32)
+        {
+            tcr1_freq = etpu_a_tcr1_freq;
+        }
+        else
+        {
+            tcr1_freq = etpu_b_tcr1_freq;
+        }
+    }
+    else
+    {
+        eTPU = eTPU_C;
+        p_data_ram = (uint8_t*)fs_etpu_c_data_ram_start;
+        tcr1_freq = etpu_c_tcr1_freq;
+    }
+
+	/* Disable channels to assign function safely */
+	for (i = 0; i < chan_cnt; i++)
+		fs_etpu_disable_ext(p_i2c_multilane_instance->em, channel + i );
+
+	/* allocate a channel frame if not already done so */
+	/* NOTE: this means that re-initialization of this channel group */
+	/* must re-use the same channel frame allocation */
+	if (eTPU->CHAN[channel].CR.B.CPBA == 0 )
+	{
+		/* get parameter RAM
+		number of parameters passed from eTPU C code */
+		pba = fs_etpu_malloc_ext(p_i2c_multilane_instance->em, _FRAME_SIZE_I2C_multilane_);
+		if (pba == 0)
+			return (FS_ETPU_ERROR_MALLOC);
+	}
+	else /*set pba to what is in the CR register*/
+	{
+		pba = fs_etpu_get_cpba_ext(p_i2c_multilane_instance->em, channel);
+	}
+	// all channels share the same channel frame
+	i2c_multilane_cpba = ((uint32_t)pba & 0x3fff)>>3;
+	for (i = 0; i < chan_cnt; i++)
+		eTPU->CHAN[channel+i].CR.B.CPBA = i2c_multilane_cpba;
+
+	p_i2c_multilane_instance->p_cpba = (volatile etpu_if_I2C_multilane_CHANNEL_FRAME*)pba;
+	if (p_i2c_multilane_instance->em == EM_AB)
+	{
+		p_i2c_multilane_instance->p_cpba_pse = (volatile etpu_if_I2C_multilane_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+	}
+	else
+	{
+		p_i2c_multilane_instance->p_cpba_pse = (volatile etpu_if_I2C_multilane_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_c_data_ram_ext - fs_etpu_c_data_ram_start));
+	}
+	p_i2c_multilane_instance->p_cmd_list = (struct aw_etpu_i2c_cmd_words*)
+		(((uint32_t)p_i2c_multilane_config->p_cmd_buffer & 0x3fff) + p_data_ram);
+	p_i2c_multilane_instance->lane_stride = p_i2c_multilane_config->lane_stride;
+
+	/* initialize the parameter values */
+	for (i = 0; i < _FRAME_SIZE_I2C_multilane_ / 4; i++)
+		frame[i] = 0;
+
+	// same default timing as the I2C master
+	bit_time_tcr1_cnt = tcr1_freq / (p_i2c_multilane_config->bit_rate_khz * 1000);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tLOW_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tHIGH_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tBUF_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tSU_STA_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tSU_STO_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tHD_DAT_, bit_time_tcr1_cnt / 20);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__tr_max_, bit_time_tcr1_cnt / 10);
+
+	// set the cmd buffer ptr and the lanes
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__p_cmd_list_, (uint32_t)p_i2c_multilane_config->p_cmd_buffer & 0x3fff);
+	AW_ETPU_I2C_FRAME_SET_8(frame, _CPBA8_I2C_multilane__lane_cnt_, lane_cnt);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_multilane__lane_stride_, p_i2c_multilane_config->lane_stride);
+
+	fs_memcpy32_ext(pba, frame, _FRAME_SIZE_I2C_multilane_);
+
+	/* no function modes */
+	for (i = 0; i < chan_cnt; i++)
+		eTPU->CHAN[channel+i].SCR.R = 0;
+
+	/* write hsr to init the channels */
+	for (i = 0; i < chan_cnt; i++)
+		eTPU->CHAN[channel+i].HSRR.R = ETPU_I2C_INIT_HSR;
+
+	/* fully write channel configuration register */
+	/* channel         = SCL_out */
+	/* channel+1       = SCL_in */
+	/* channel+2+2*n   = SDA_out of lane n */
+	/* channel+3+2*n   = SDA_in of lane n */
+	/* this has the side-effect of starting the function running */
+	eTPU->CHAN[channel+ETPU_I2C_MULTILANE_SCL_OUT_OFFSET].CR.R = (priority << 28) +
+		(_ENTRY_TABLE_PIN_DIR_I2C_multilane_I2C_SCL_out_ << 25) +
+		(_ENTRY_TABLE_TYPE_I2C_multilane_I2C_SCL_out_ << 24) +
+		(_FUNCTION_NUM_I2C_multilane_I2C_SCL_out_ << 16) +
+		i2c_multilane_cpba;
+	eTPU->CHAN[channel+ETPU_I2C_MULTILANE_SCL_IN_OFFSET].CR.R = (priority << 28) +
+		(_ENTRY_TABLE_PIN_DIR_I2C_multilane_I2C_SCL_in_ << 25) +
+		(_ENTRY_TABLE_TYPE_I2C_multilane_I2C_SCL_in_ << 24) +
+		(_FUNCTION_NUM_I2C_multilane_I2C_SCL_in_ << 16) +
+		i2c_multilane_cpba;
+	for (i = 0; i < lane_cnt; i++)
+	{
+		eTPU->CHAN[channel+ETPU_I2C_MULTILANE_SDA_OUT_OFFSET+i*ETPU_I2C_MULTILANE_LANE_CHANNELS].CR.R = (priority << 28) +
+			(_ENTRY_TABLE_PIN_DIR_I2C_multilane_I2C_SDA_out_ << 25) +
+			(_ENTRY_TABLE_TYPE_I2C_multilane_I2C_SDA_out_ << 24) +
+			(_FUNCTION_NUM_I2C_multilane_I2C_SDA_out_ << 16) +
+			i2c_multilane_cpba;
+		eTPU->CHAN[channel+ETPU_I2C_MULTILANE_SDA_IN_OFFSET+i*ETPU_I2C_MULTILANE_LANE_CHANNELS].CR.R = (priority << 28) +
+			(_ENTRY_TABLE_PIN_DIR_I2C_multilane_I2C_SDA_in_ << 25) +
+			(_ENTRY_TABLE_TYPE_I2C_multilane_I2C_SDA_in_ << 24) +
+			(_FUNCTION_NUM_I2C_multilane_I2C_SDA_in_ << 16) +
+			i2c_multilane_cpba;
+	}
+
+	p_i2c_multilane_instance->shutdown.state = ETPU_I2C_SHUTDOWN_IDLE;
+
+	// handle is now valid
+	p_i2c_multilane_instance->p_etpu = eTPU;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_set_timing(
+    struct aw_i2c_multilane_instance_t  *p_i2c_multilane_instance,
+    struct aw_i2c_multilane_config_t    *p_i2c_multilane_config)
+{
+	uint32_t tcr1_freq;
+	uint8_t channel = p_i2c_multilane_instance->base_chan_num;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+
+    if (p_i2c_multilane_instance->em == EM_AB)
+    {
+        if (channel < 32)
+        {
+            tcr1_freq = etpu_a_tcr1_freq;
+        }
+        else
+        {
+            tcr1_freq = etpu_b_tcr1_freq;
+        }
+    }
+    else
+    {
+        tcr1_freq = etpu_c_tcr1_freq;
+    }
+	// put it into counts/us (hz => mhz)
+	tcr1_freq /= 1000000;
+
+	p_i2c_multilane_instance->p_cpba_pse->_tLOW = (tcr1_freq * p_i2c_multilane_config->tLOW) / 1000;
+	p_i2c_multilane_instance->p_cpba_pse->_tHIGH = (tcr1_freq * p_i2c_multilane_config->tHIGH) / 1000;
+	p_i2c_multilane_instance->p_cpba_pse->_tBUF = (tcr1_freq * p_i2c_multilane_config->tBUF) / 1000;
+	p_i2c_multilane_instance->p_cpba_pse->_tSU_STA = (tcr1_freq * p_i2c_multilane_config->tSU_STA) / 1000;
+	p_i2c_multilane_instance->p_cpba_pse->_tSU_STO = (tcr1_freq * p_i2c_multilane_config->tSU_STO) / 1000;
+	p_i2c_multilane_instance->p_cpba_pse->_tHD_DAT = (tcr1_freq * p_i2c_multilane_config->tHD_DAT) / 1000;
+	p_i2c_multilane_instance->p_cpba_pse->_tr_max = (tcr1_freq * p_i2c_multilane_config->tr_max) / 1000;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_transmit(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr,
+    uint8_t lane_data)
+{
+	struct aw_etpu_i2c_cmd_words* p_cmd;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buffer_size && !buffer_ptr) || !AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
+		return FS_ETPU_ERROR_VALUE;
+	if (lane_data && (p_i2c_multilane_instance->lane_cnt > 1) && (buffer_size > p_i2c_multilane_instance->lane_stride))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// check ready flag first
+	if (p_i2c_multilane_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_cmd = p_i2c_multilane_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_WRITE_MESSAGE), buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(lane_data ? ETPU_I2C_CMD_LANE_DATA : 0, buffer_size);
+
+	// set one cmd and go
+	p_i2c_multilane_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_multilane_instance->p_etpu->CHAN[p_i2c_multilane_instance->base_chan_num].HSRR.R = ETPU_I2C_MULTILANE_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_receive(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr)
+{
+	struct aw_etpu_i2c_cmd_words* p_cmd;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!buffer_size || !buffer_ptr || !AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
+		return FS_ETPU_ERROR_VALUE;
+	if ((p_i2c_multilane_instance->lane_cnt > 1) && (buffer_size > p_i2c_multilane_instance->lane_stride))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// check ready flag first
+	if (p_i2c_multilane_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_cmd = p_i2c_multilane_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_READ_MESSAGE), buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(0, buffer_size);
+
+	// set one cmd and go
+	p_i2c_multilane_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_multilane_instance->p_etpu->CHAN[p_i2c_multilane_instance->base_chan_num].HSRR.R = ETPU_I2C_MULTILANE_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_encoded_transfer(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!cmd_words_ptr || !cmd_cnt || (cmd_cnt > 0xff))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// check ready flag first
+	if (p_i2c_multilane_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	// copy the whole list in one burst, then go
+	fs_memcpy32_ext((uint32_t*)p_i2c_multilane_instance->p_cmd_list, (uint32_t*)cmd_words_ptr,
+		cmd_cnt * sizeof(struct aw_etpu_i2c_cmd_words));
+	p_i2c_multilane_instance->p_cpba->_cmd_cnt = cmd_cnt;
+	p_i2c_multilane_instance->p_etpu->CHAN[p_i2c_multilane_instance->base_chan_num].HSRR.R = ETPU_I2C_MULTILANE_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_is_busy(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t* busy_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!busy_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	*busy_ptr = p_i2c_multilane_instance->p_cpba->_in_use_flag ? 1 : 0;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_get_lane_nack(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t* lane_nack_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!lane_nack_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// only meaningful once the transfer is complete
+	if (p_i2c_multilane_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	*lane_nack_ptr = p_i2c_multilane_instance->p_cpba->_lane_nack;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_multilane_shutdown(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance)
+{
+	int32_t err_code;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_multilane_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+	err_code = aw_etpu_i2c_shutdown_step(&p_i2c_multilane_instance->shutdown,
+		p_i2c_multilane_instance->em, p_i2c_multilane_instance->base_chan_num, ETPU_I2C_MULTILANE_CHANNELS_USED(p_i2c_multilane_instance->lane_cnt));
+	if (err_code)
+		return err_code;
+
+	// handle is no longer valid
+	p_i2c_multilane_instance->p_etpu = 0;
+
+	return 0;
+}
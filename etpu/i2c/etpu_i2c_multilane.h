@@ -0,0 +1,235 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_multilane.h
+*
+* DESCRIPTION: API for initializing and controlling the I2C eTPU function
+* (multi-lane master: one SCL, several SDA lines)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+**************************************************************************/
+
+#ifndef __ETPU_I2C_MULTILANE_H
+#define __ETPU_I2C_MULTILANE_H
+
+#include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_util_ext.h"
+#include "etpu_auto_api.h"	/* channel frame overlays (etpu_set_struct.h) */
+#include "etpu_i2c.h"	/* non-blocking shutdown */
+#include "etpu_i2c_master.h"	/* transfer command words */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A structure to represent an instance of I2C_multilane
+ *  It includes static I2C_multilane initialization items.  Once
+ *  aw_etpu_i2c_multilane_init() succeeds it also serves as a validated
+ *  handle (see aw_i2c_master_instance_t). */
+struct aw_i2c_multilane_instance_t
+{
+    ETPU_MODULE         em;
+    /* base_chan_num - the base channel for the I2C eTPU multi-lane master.
+     *		The channels are defined as follows:
+     *			base_chan_num       - SCL_out
+     *			base_chan_num+1     - SCL_in
+     *			base_chan_num+2+2*n - SDA_out of lane n
+     *			base_chan_num+3+2*n - SDA_in of lane n
+     *		All of them must be in the same eTPU engine. */
+    uint8_t             base_chan_num;
+    /* lane_cnt - the number of SDA lanes, 1 to
+     *		ETPU_I2C_MULTILANE_MAX_LANES. */
+    uint8_t             lane_cnt;
+    /* priority - the priority assigned to all channels, with a range of
+     *		1 (low) to 3 (high).  Each SCL clock is one thread, which
+     *		loops over the lanes and must complete within tHIGH of the
+     *		clock's rising edge. */
+    uint8_t             priority;
+    volatile etpu_if_I2C_multilane_CHANNEL_FRAME              *p_cpba;        /* set during initialization */
+    volatile etpu_if_I2C_multilane_CHANNEL_FRAME_unsignedPSE  *p_cpba_pse;    /* set during initialization */
+    /* p_etpu - the eTPU module base; non-NULL only once initialization
+     *		has succeeded. */
+    volatile struct eTPU_struct         *p_etpu;        /* set during initialization */
+    /* p_cmd_list - host address of the command list the channel frame
+     *		points to (shadow of _p_cmd_list). */
+    struct aw_etpu_i2c_cmd_words        *p_cmd_list;    /* set during initialization */
+    /* lane_stride - shadow of the configured lane_stride. */
+    uint32_t                            lane_stride;   /* set during initialization */
+    /* shutdown - progress of aw_etpu_i2c_multilane_shutdown(). */
+    struct aw_etpu_i2c_shutdown_t       shutdown;      /* set during initialization */
+};
+
+/** A structure to represent a configuration of I2C_multilane. */
+struct aw_i2c_multilane_config_t
+{
+    /* p_cmd_buffer - pointer to a buffer in eTPU data memory (SDM) that is to
+     *		be used for transfer commands, 8 bytes per command. */
+    uint8_t             *p_cmd_buffer;
+    /* lane_stride - the distance in bytes between the data buffers of two
+     *		consecutive lanes: lane n reads into, and with per-lane write
+     *		data writes from, buffer_ptr + n * lane_stride. */
+    uint32_t            lane_stride;
+    /* bit_rate_khz - the bit rate in kHz.  The initialization function
+     *		derives all the bit timings from this rate; the
+     *		aw_etpu_i2c_multilane_set_timing() interface can be used to
+     *		override them. */
+    uint32_t            bit_rate_khz;
+
+    // the below are only used by the set_timing() interface, in ns, with the
+    // same meaning as for the I2C master (see aw_i2c_master_config_t).
+    uint32_t            tLOW;
+    uint32_t            tHIGH;
+    uint32_t            tBUF;
+    uint32_t            tSU_STA;
+    uint32_t            tSU_STO;
+    uint32_t            tHD_DAT;
+    uint32_t            tr_max;
+};
+
+
+/****************************************************************
+ * I2C multi-lane master initialization.  This one routine
+ * initializes all eTPU channels of the master,
+ * ETPU_I2C_MULTILANE_CHANNELS_USED(lane_cnt) consecutive channels.
+ *
+ * The channel group is validated here, once; on success the
+ * instance becomes a handle for the calls below, which then only
+ * check that the instance was initialized
+ * (FS_ETPU_ERROR_UNINITIALIZED if not).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_init(
+    struct aw_i2c_multilane_instance_t  *p_i2c_multilane_instance,
+    struct aw_i2c_multilane_config_t    *p_i2c_multilane_config);
+
+
+/****************************************************************
+ * Allows direct configuration of each timing parameter used by
+ * the master.  Should only be called with no transfer in
+ * progress.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_set_timing(
+    struct aw_i2c_multilane_instance_t  *p_i2c_multilane_instance,
+    struct aw_i2c_multilane_config_t    *p_i2c_multilane_config);
+
+
+/****************************************************************
+ * Transmit data to the specified slave address on every lane.
+ * When transmission is complete, a channel interrupt will be
+ * generated from the base channel.
+ *
+ * slave_address - the slave address, where it is assumed bit 0
+ *		is 0 (write).
+ * buffer_size - the size in bytes of the data to be transmitted
+ *		on each lane.  It does not include the header byte.
+ * buffer_ptr - the buffer from which data is transmitted.  The buffer
+ *		must reside in eTPU data memory (SDM).
+ * lane_data - 0 to send the same buffer on every lane, else lane n
+ *		sends buffer_ptr + n * lane_stride.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_transmit(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr,
+    uint8_t lane_data);
+
+
+/****************************************************************
+ * Receive data from the specified slave address on every lane.
+ * When receipt is complete, a channel interrupt will be generated
+ * from the base channel.
+ *
+ * slave_address - the slave address, where it is assumed bit 0
+ *		is 0 and will be filled in based upon read/write.
+ * buffer_size - the size in bytes of the data to be received on
+ *		each lane.
+ * buffer_ptr - the buffer of lane 0; lane n receives into
+ *		buffer_ptr + n * lane_stride.  The buffers must reside in
+ *		eTPU data memory (SDM).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_receive(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr);
+
+
+/****************************************************************
+ * Issue a list of pre-encoded commands in combined format, on
+ * every lane (see aw_etpu_i2c_master_encoded_transfer()).  Only
+ * 7-bit headers are supported; of the flags, only
+ * ETPU_I2C_CMD_LANE_DATA is used, selecting per-lane write data.
+ * Read data is always per lane.  The list is copied into the
+ * command buffer, which must hold cmd_cnt commands.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_encoded_transfer(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt);
+
+
+/****************************************************************
+ * Find out whether a transfer is in progress.
+ *
+ * busy_ptr - the byte location at which to write 1 if a transfer
+ *		is in progress, else 0.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_is_busy(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t* busy_ptr);
+
+
+/****************************************************************
+ * Get the lanes that NACKed during the last transfer.  A NACKed
+ * lane was released for the rest of its command; any data it
+ * received in that command is invalid.
+ *
+ * lane_nack_ptr - the byte location at which to write the lane
+ *		mask (bit n = lane n NACKed).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_get_lane_nack(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance,
+    uint8_t* lane_nack_ptr);
+
+
+/****************************************************************
+ * Shut down the master and disable all its channels.  The
+ * instance must be re-initialized before it is used again.
+ *
+ * The shutdown does not wait on the eTPU: the first call issues
+ * the shutdown HSRs (once no other HSR is pending), and the call is
+ * repeated (e.g. from a periodic task) until it returns pass, at
+ * which point the channels are disabled.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY while the shutdown is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_multilane_shutdown(
+    struct aw_i2c_multilane_instance_t *p_i2c_multilane_instance);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ETPU_I2C_MULTILANE_H
@@ -0,0 +1,316 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_node.h
+*
+* DESCRIPTION: API for initializing and controlling the I2C eTPU function
+* (node: combined master and slave on one channel group)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+**************************************************************************/
+
+#ifndef __ETPU_I2C_NODE_H
+#define __ETPU_I2C_NODE_H
+
+#include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_util_ext.h"
+#include "etpu_auto_api.h"	/* channel frame overlays (etpu_set_struct.h) */
+#include "etpu_i2c.h"	/* non-blocking shutdown */
+#include "etpu_i2c_master.h"	/* transfer command words */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A structure to represent an instance of I2C_node
+ *  It includes static I2C_node initialization items.  Once
+ *  aw_etpu_i2c_node_init() succeeds it also serves as a validated
+ *  handle (see aw_i2c_master_instance_t). */
+struct aw_i2c_node_instance_t
+{
+    ETPU_MODULE         em;
+    /* base_chan_num - the base channel for the I2C eTPU node.  The channels
+     *		are laid out as for the I2C master:
+     *			base_chan_num   - SCL_out
+     *			base_chan_num+1 - SCL_in
+     *			base_chan_num+2 - SDA_out
+     *			base_chan_num+3 - SDA_in */
+    uint8_t             base_chan_num;
+    /* priority - the priority assigned to all the channels, with
+     *		a range of 1 (low) to 3 (high). */
+    uint8_t             priority;
+    volatile etpu_if_I2C_node_CHANNEL_FRAME                *p_cpba;        /* set during initialization */
+    volatile etpu_if_I2C_node_CHANNEL_FRAME_unsignedPSE    *p_cpba_pse;    /* set during initialization */
+    /* p_etpu - the eTPU module base; non-NULL only once initialization
+     *		has succeeded. */
+    volatile struct eTPU_struct         *p_etpu;        /* set during initialization */
+    /* p_data_ram - host address of the module SDM (eTPU address 0). */
+    uint8_t                             *p_data_ram;    /* set during initialization */
+    /* p_cmd_list - host address of the command list the channel frame
+     *		points to (shadow of _p_cmd_list). */
+    struct aw_etpu_i2c_cmd_words        *p_cmd_list;    /* set during initialization */
+    /* p_write_buffer, write_buffer_size - shadows of the write buffer
+     *		configuration (host address), kept by init/set_write_buffer. */
+    uint8_t                             *p_write_buffer;    /* set during initialization */
+    uint32_t                            write_buffer_size;  /* set during initialization */
+    /* shutdown - progress of aw_etpu_i2c_node_shutdown(). */
+    struct aw_etpu_i2c_shutdown_t       shutdown;      /* set during initialization */
+};
+
+/** A structure to represent a configuration of I2C_node. */
+struct aw_i2c_node_config_t
+{
+    // master role
+
+    /* p_cmd_buffer - pointer to a buffer in eTPU data memory (SDM) that is to
+     *		be used for transfer commands, 8 bytes per command. */
+    uint8_t             *p_cmd_buffer;
+    /* bit_rate_khz - the bit rate in kHz.  The initialization function
+     *		derives all the bit timings from this rate; the
+     *		aw_etpu_i2c_node_set_timing() interface can be used to
+     *		override them. */
+    uint32_t            bit_rate_khz;
+
+    // the below are only used by the set_timing() interface, in ns, with the
+    // same meaning as for the I2C master (see aw_i2c_master_config_t).
+    // tBUF is also the slave role's bus idle detection time.
+    uint32_t            tLOW;
+    uint32_t            tHIGH;
+    uint32_t            tBUF;
+    uint32_t            tSU_STA;
+    uint32_t            tSU_STO;
+    uint32_t            tHD_DAT;
+    uint32_t            tr_max;
+
+    // slave role, with the same meaning as for the I2C slave (see
+    // aw_i2c_slave_config_t); only 7-bit addressing and "data ready" mode
+
+    uint8_t             address;
+    uint8_t             address_mask;
+    uint8_t             accept_general_call;
+    uint8_t             *p_read_buffer;
+    uint32_t            read_buffer_size;
+    uint8_t             *p_write_buffer;
+    uint32_t            write_buffer_size;
+};
+
+
+/****************************************************************
+ * I2C node initialization.  This one routine initializes all
+ * four eTPU channels of the node, which starts in the slave role.
+ * Four consecutive channels must be used.
+ *
+ * The channel group is validated here, once; on success the
+ * instance becomes a handle for the calls below, which then only
+ * check that the instance was initialized
+ * (FS_ETPU_ERROR_UNINITIALIZED if not).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_init(
+    struct aw_i2c_node_instance_t  *p_i2c_node_instance,
+    struct aw_i2c_node_config_t    *p_i2c_node_config);
+
+
+/****************************************************************
+ * Allows direct configuration of each timing parameter used by
+ * the node.  Should only be called with no transfer in progress.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_set_timing(
+    struct aw_i2c_node_instance_t  *p_i2c_node_instance,
+    struct aw_i2c_node_config_t    *p_i2c_node_config);
+
+
+/****************************************************************
+ * Transmit data to the specified slave address.  The transfer
+ * starts once the bus is idle; a transfer addressed to this node
+ * by another master is served first.  When transmission is
+ * complete, or arbitration is lost, a channel interrupt will be
+ * generated from the SCL_out channel.
+ *
+ * slave_address - the slave address, where it is assumed bit 0
+ *		is 0 (write).
+ * buffer_size - the size in bytes of the data to be transmitted.
+ *		It does not include the header byte.
+ * buffer_ptr - the buffer from which data is transmitted.  The buffer
+ *		must reside in eTPU data memory (SDM).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_transmit(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr);
+
+
+/****************************************************************
+ * Receive data from the specified slave address.  As for
+ * aw_etpu_i2c_node_transmit().
+ *
+ * slave_address - the slave address, where it is assumed bit 0
+ *		is 0 and will be filled in based upon read/write.
+ * buffer_size - the size in bytes of the data to be received.
+ * buffer_ptr - the buffer into which data is received.  The buffer
+ *		must reside in eTPU data memory (SDM).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_receive(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr);
+
+
+/****************************************************************
+ * Issue a list of pre-encoded commands in combined format (see
+ * aw_etpu_i2c_master_encoded_transfer()).  Only 7-bit headers
+ * are supported and the flags are not used; a NACKed command is
+ * recorded in the error flags and the list goes on.  The list is
+ * copied into the command buffer, which must hold cmd_cnt
+ * commands.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_encoded_transfer(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt);
+
+
+/****************************************************************
+ * Find out whether a transfer requested by the host is pending
+ * or in progress.
+ *
+ * busy_ptr - the byte location at which to write 1 if a transfer
+ *		is in progress, else 0.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_is_busy(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* busy_ptr);
+
+
+/****************************************************************
+ * Find out whether the last transfer lost arbitration to another
+ * master.  The lost transfer is not retried; the node went on in
+ * the slave role.
+ *
+ * arb_lost_ptr - the byte location at which to write 1 if
+ *		arbitration was lost, else 0.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_get_arb_lost(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* arb_lost_ptr);
+
+
+/****************************************************************
+ * Configure a new slave role read buffer (see
+ * aw_etpu_i2c_slave_set_read_buffer()).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_set_read_buffer(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* buffer_ptr,
+    uint32_t size);
+
+
+/****************************************************************
+ * Configure a new slave role write buffer (see
+ * aw_etpu_i2c_slave_set_write_buffer()).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_set_write_buffer(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* buffer_ptr,
+    uint32_t size);
+
+
+/****************************************************************
+ * Get the header byte, size and error flags of the last transfer
+ * another master made to this node (see
+ * aw_etpu_i2c_slave_get_transfer_status()).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer to this node is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_get_transfer_status(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* header_ptr,
+    uint32_t* size_ptr,
+    uint8_t* error_flags_ptr);
+
+
+/****************************************************************
+ * Copy out the data another master wrote to this node (see
+ * aw_etpu_i2c_slave_get_write_data()).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer to this node is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_get_write_data(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* header_ptr,
+    uint8_t* dest_buffer_ptr,
+    uint32_t* size_ptr);
+
+
+/****************************************************************
+ * Latch, clear and get the error flags of both roles (see
+ * aw_etpu_i2c_master_latch_clear_error_flags()).  Master and slave
+ * error flags use separate bits (etpu_i2c_common.h).
+ *
+ * error_flags_ptr - the byte location at which to write the error flags
+ *		retrieved from the eTPU.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_latch_clear_error_flags(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance);
+int32_t aw_etpu_i2c_node_get_running_error_flags(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* error_flags_ptr);
+int32_t aw_etpu_i2c_node_clear_running_error_flags(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance);
+int32_t aw_etpu_i2c_node_get_latched_error_flags(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance,
+    uint8_t* error_flags_ptr);
+int32_t aw_etpu_i2c_node_clear_latched_error_flags(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance);
+
+
+/****************************************************************
+ * Shut down the node and disable all its channels.  The
+ * instance must be re-initialized before it is used again.
+ *
+ * The shutdown does not wait on the eTPU: the first call issues
+ * the shutdown HSRs (once no other HSR is pending), and the call is
+ * repeated (e.g. from a periodic task) until it returns pass, at
+ * which point the channels are disabled.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY while the shutdown is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_node_shutdown(
+    struct aw_i2c_node_instance_t *p_i2c_node_instance);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ETPU_I2C_NODE_H
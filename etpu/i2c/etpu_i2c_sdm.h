@@ -0,0 +1,95 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_sdm.h
+*
+* DESCRIPTION: Compile-time SDM (eTPU shared data memory) budget for a
+* declared I2C system configuration.
+*
+* The globals, each I2C channel frame, command lists and data buffers are
+* all carved out of SDM by fs_etpu_malloc_ext(), which otherwise only
+* reports an overflow at run time.  A system describes its SDM use as a
+* list, in allocation order, which AW_ETPU_I2C_SDM_LAYOUT() and
+* AW_ETPU_I2C_SDM_CHECK() turn into:
+*   - an enum layout map, AW_ETPU_I2C_SDM_<name>_START/_END, giving the
+*     SDM offset of every item with fs_etpu_malloc_ext 8-byte rounding,
+*     and AW_ETPU_I2C_SDM_<tag>_TOTAL;
+*   - a compile error (negative array size naming <tag>) if the total
+*     does not fit the data RAM of the part;
+*   - a const table, aw_etpu_i2c_sdm_map_<tag>[], holding the same map so
+*     it can be inspected in the debugger and linker map.
+*
+* Example (items must be listed in the order they are allocated):
+*   #define MY_I2C_SDM(X) \
+*       X(ab_globals,      AW_ETPU_I2C_SDM_GLOBALS_SIZE) \
+*       X(ab_master_cmds,  AW_ETPU_I2C_SDM_CMD_LIST_SIZE(2)) \
+*       X(ab_master_buf,   64) \
+*       X(ab_master_frame, AW_ETPU_I2C_SDM_MASTER_FRAME_SIZE)
+*   AW_ETPU_I2C_SDM_LAYOUT(MY_I2C_SDM, ab);                         (header)
+*   AW_ETPU_I2C_SDM_CHECK(MY_I2C_SDM, ab, FS_ETPU_DATA_RAM_SIZE);   (etpu_gct.c)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+**************************************************************************/
+
+#ifndef __ETPU_I2C_SDM_H
+#define __ETPU_I2C_SDM_H
+
+#include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_set_defines.h"
+#include "etpu_i2c_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* fs_etpu_malloc_ext() hands out SDM in multiples of 8 bytes */
+#define AW_ETPU_I2C_SDM_ROUND(bytes)		((((uint32_t)(bytes)) + 7) & ~7u)
+
+/* item sizes */
+#define AW_ETPU_I2C_SDM_GLOBALS_SIZE		(_GLOBAL_DATA_SIZE_ + _STACK_SIZE_)
+#define AW_ETPU_I2C_SDM_MASTER_FRAME_SIZE	_FRAME_SIZE_I2C_master_
+#define AW_ETPU_I2C_SDM_SLAVE_FRAME_SIZE	_FRAME_SIZE_I2C_slave_
+#define AW_ETPU_I2C_SDM_MONITOR_FRAME_SIZE	_FRAME_SIZE_I2C_monitor_
+#define AW_ETPU_I2C_SDM_CMD_LIST_SIZE(cmd_cnt)	((cmd_cnt) * 8)
+#define AW_ETPU_I2C_SDM_MONITOR_RING_SIZE(rec_cnt)	((rec_cnt) * ETPU_I2C_MONITOR_REC_SIZE)
+
+/* fs_etpu_malloc_ext() keeps the end of the last allocation at or below
+ * fs_etpu_data_ram_end, the address of the last word of data RAM */
+#define AW_ETPU_I2C_SDM_LIMIT(data_ram_size)	((data_ram_size) - 4)
+
+/* one entry of the const layout map */
+struct aw_etpu_i2c_sdm_item
+{
+    const char  *name;
+    uint32_t    offset;     /* from the start of data RAM */
+    uint32_t    size;       /* after rounding */
+};
+
+/* X-macro helpers */
+#define AW_ETPU_I2C_SDM_X_ENUM(name, bytes) \
+	AW_ETPU_I2C_SDM_##name##_START, \
+	AW_ETPU_I2C_SDM_##name##_END = AW_ETPU_I2C_SDM_##name##_START + AW_ETPU_I2C_SDM_ROUND(bytes) - 1,
+#define AW_ETPU_I2C_SDM_X_ITEM(name, bytes) \
+	{ #name, AW_ETPU_I2C_SDM_##name##_START, AW_ETPU_I2C_SDM_ROUND(bytes) },
+
+/* Declare the layout map of one module's SDM.  Use at file scope; may be
+ * placed in a header so the offsets are visible wherever needed. */
+#define AW_ETPU_I2C_SDM_LAYOUT(list, tag) \
+	enum { list(AW_ETPU_I2C_SDM_X_ENUM) AW_ETPU_I2C_SDM_##tag##_TOTAL }
+
+/* Check the layout fits data RAM of data_ram_size bytes (the
+ * FS_ETPU_DATA_RAM_SIZE/FS_ETPU_C_DATA_RAM_SIZE value from the part's
+ * *_vars.h) and define the const map table.  Use at file scope in the
+ * one translation unit that includes *_vars.h. */
+#define AW_ETPU_I2C_SDM_CHECK(list, tag, data_ram_size) \
+	typedef char aw_etpu_i2c_sdm_overflow_##tag[ \
+		(AW_ETPU_I2C_SDM_##tag##_TOTAL <= AW_ETPU_I2C_SDM_LIMIT(data_ram_size)) ? 1 : -1]; \
+	const struct aw_etpu_i2c_sdm_item aw_etpu_i2c_sdm_map_##tag[] = { list(AW_ETPU_I2C_SDM_X_ITEM) }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ETPU_I2C_SDM_H
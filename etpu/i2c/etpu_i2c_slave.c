@@ -13,6 +13,7 @@
 **************************************************************************/
 
 #include "etpu_util_ext.h"
+#include "etpu_i2c.h"
 #include "etpu_i2c_slave.h"
 #include "etpu_i2c_common.h"
 #include "etpu_set_defines.h"
@@ -25,10 +26,16 @@ int32_t aw_etpu_i2c_slave_init(
     volatile struct eTPU_struct * eTPU;
 	uint32_t *pba;	/* parameter base address for channel */
 	uint32_t tcr1_freq;
+	uint32_t hold_timeout;
 	uint32_t i2c_slave_cpba;
+	uint32_t frame[_FRAME_SIZE_I2C_slave_ / 4];
+	uint32_t i;
 	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 	uint8_t priority = p_i2c_slave_instance->priority;
 
+	// invalidate the handle until initialization succeeds
+	p_i2c_slave_instance->p_etpu = 0;
+
 #ifdef ETPU_I2C_PARAMETER_CHECK
 	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
 		return FS_ETPU_ERROR_VALUE;
@@ -54,6 +61,22 @@ int32_t aw_etpu_i2c_slave_init(
         tcr1_freq = etpu_c_tcr1_freq;
     }
 
+	// put tcr1 freq into counts/us (hz => mhz)
+	tcr1_freq /= 1000000;
+
+	hold_timeout = tcr1_freq * p_i2c_slave_config->hold_timeout_us;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (p_i2c_slave_config->hold_timeout_us)
+	{
+		if (tcr1_freq && (p_i2c_slave_config->hold_timeout_us > ETPU_I2C_SLAVE_HOLD_TIMEOUT_MAX_TICKS / tcr1_freq))
+			return FS_ETPU_ERROR_VALUE;
+		if (!p_i2c_slave_config->p_fallback_buffer || !p_i2c_slave_config->fallback_buffer_size)
+			return FS_ETPU_ERROR_VALUE;
+	}
+	if (p_i2c_slave_config->address_10bit && (p_i2c_slave_config->address10 > ETPU_I2C_ADDR10_MAX))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
 	/* Disable channels to assign function safely */
 	fs_etpu_disable_ext(p_i2c_slave_instance->em, channel );
 	fs_etpu_disable_ext(p_i2c_slave_instance->em, channel + 1 );
@@ -82,25 +105,56 @@ int32_t aw_etpu_i2c_slave_init(
 	eTPU->CHAN[channel+2].CR.B.CPBA = i2c_slave_cpba;
 	eTPU->CHAN[channel+3].CR.B.CPBA = i2c_slave_cpba;
 
-	p_i2c_slave_instance->p_cpba = (void*)pba;
-	p_i2c_slave_instance->p_cpba_pse = (void*)((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+	p_i2c_slave_instance->p_cpba = (volatile etpu_if_I2C_slave_CHANNEL_FRAME*)pba;
+	if (p_i2c_slave_instance->em == EM_AB)
+	{
+		p_i2c_slave_instance->p_data_ram = (uint8_t*)fs_etpu_data_ram_start;
+		p_i2c_slave_instance->p_cpba_pse = (volatile etpu_if_I2C_slave_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+	}
+	else
+	{
+		p_i2c_slave_instance->p_data_ram = (uint8_t*)fs_etpu_c_data_ram_start;
+		p_i2c_slave_instance->p_cpba_pse = (volatile etpu_if_I2C_slave_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_c_data_ram_ext - fs_etpu_c_data_ram_start));
+	}
+	p_i2c_slave_instance->p_write_buffer = ((uint32_t)p_i2c_slave_config->p_write_buffer & 0x3fff) + p_i2c_slave_instance->p_data_ram;
+	p_i2c_slave_instance->write_buffer_size = p_i2c_slave_config->write_buffer_size;
 
 	/* initialize the parameter values */
-	fs_memset32_ext(pba, 0, _FRAME_SIZE_I2C_slave_); // zero everything
+	/* the frame is built in RAM and written in one burst, rather than */
+	/* zeroed then updated one field at a time over the peripheral bus */
+	for (i = 0; i < _FRAME_SIZE_I2C_slave_ / 4; i++)
+		frame[i] = 0;
 
-	// put tcr1 freq into counts/us (hz => mhz)
-	tcr1_freq /= 1000000;
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__tSU_DAT_, (uint24_t)((tcr1_freq * p_i2c_slave_config->tSU_DAT) / 1000));
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__tBUF_, (uint24_t)((tcr1_freq * p_i2c_slave_config->tBUF) / 1000));
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__tSU_DAT_, (tcr1_freq * p_i2c_slave_config->tSU_DAT) / 1000);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__tBUF_, (tcr1_freq * p_i2c_slave_config->tBUF) / 1000);
 
 	// set up other chan frame parameters
-	fs_etpu_set_chan_local_8_ext (p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__address_, p_i2c_slave_config->address);
-	fs_etpu_set_chan_local_8_ext (p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__address_mask_, p_i2c_slave_config->address_mask);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__accept_general_call_, p_i2c_slave_config->accept_general_call);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__read_buffer_, (uint24_t)p_i2c_slave_config->p_read_buffer & 0x3fff);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__read_buffer_size_, p_i2c_slave_config->read_buffer_size);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__write_buffer_, (uint24_t)p_i2c_slave_config->p_write_buffer & 0x3fff);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__write_buffer_size_, p_i2c_slave_config->write_buffer_size);
+	if (p_i2c_slave_config->address_10bit)
+	{
+		// the first header byte is matched as a 7-bit header, the second
+		// byte separately
+		AW_ETPU_I2C_FRAME_SET_8 (frame, _CPBA8_I2C_slave__address_, ETPU_I2C_ADDR10_HEADER | ((p_i2c_slave_config->address10 >> 7) & 0x06));
+		AW_ETPU_I2C_FRAME_SET_8 (frame, _CPBA8_I2C_slave__address_mask_, ~ETPU_I2C_RW_MASK);
+		AW_ETPU_I2C_FRAME_SET_8 (frame, _CPBA8_I2C_slave__address_10bit_, 1);
+		AW_ETPU_I2C_FRAME_SET_8 (frame, _CPBA8_I2C_slave__address_low_, p_i2c_slave_config->address10);
+	}
+	else
+	{
+		AW_ETPU_I2C_FRAME_SET_8 (frame, _CPBA8_I2C_slave__address_, p_i2c_slave_config->address);
+		AW_ETPU_I2C_FRAME_SET_8 (frame, _CPBA8_I2C_slave__address_mask_, p_i2c_slave_config->address_mask);
+	}
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__accept_general_call_, p_i2c_slave_config->accept_general_call);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__read_buffer_, (uint32_t)p_i2c_slave_config->p_read_buffer & 0x3fff);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__read_buffer_size_, p_i2c_slave_config->read_buffer_size);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__write_buffer_, (uint32_t)p_i2c_slave_config->p_write_buffer & 0x3fff);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__write_buffer_size_, p_i2c_slave_config->write_buffer_size);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__hold_timeout_, hold_timeout);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__fallback_buffer_, (uint32_t)p_i2c_slave_config->p_fallback_buffer & 0x3fff);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_slave__fallback_buffer_size_, p_i2c_slave_config->fallback_buffer_size);
+
+	fs_memcpy32_ext(pba, frame, _FRAME_SIZE_I2C_slave_);
 
 	/* write FM (function mode) bits (only used on SCL_in) */
 	eTPU->CHAN[channel+ETPU_I2C_SLAVE_SCL_IN_OFFSET].SCR.R = p_i2c_slave_config->data_mode;
@@ -141,6 +195,9 @@ int32_t aw_etpu_i2c_slave_init(
 		(_FUNCTION_NUM_I2C_slave_I2C_SDA_out_ << 16) +
 		i2c_slave_cpba;
 
+	// handle is now valid
+	p_i2c_slave_instance->p_etpu = eTPU;
+
 	return 0;
 }
 
@@ -150,34 +207,53 @@ int32_t aw_etpu_i2c_slave_set_read_buffer(
     uint8_t* buffer_ptr,
     uint32_t size)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+	p_i2c_slave_instance->p_cpba_pse->_read_buffer = (uint32_t)buffer_ptr & 0x3fff;
+	p_i2c_slave_instance->p_cpba_pse->_read_buffer_size = size;
+	return 0;
+}
+
+int32_t aw_etpu_i2c_slave_set_fallback_buffer(
+    struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
+    uint8_t* buffer_ptr,
+    uint32_t size)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!buffer_ptr || !size)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__read_buffer_, (uint24_t)buffer_ptr & 0x3fff);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__read_buffer_size_, size);
+	p_i2c_slave_instance->p_cpba_pse->_fallback_buffer = (uint32_t)buffer_ptr & 0x3fff;
+	p_i2c_slave_instance->p_cpba_pse->_fallback_buffer_size = size;
 	return 0;
 }
 
 int32_t aw_etpu_i2c_slave_issue_data_ready(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+	p_i2c_slave_instance->p_etpu->CHAN[p_i2c_slave_instance->base_chan_num + ETPU_I2C_SLAVE_SCL_OUT_OFFSET].HSRR.R = ETPU_I2C_SLAVE_DATA_READY;
+	return 0;
+}
+
+int32_t aw_etpu_i2c_slave_get_host_latency(
+    struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
+    uint32_t* latency_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!latency_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-    if (p_i2c_slave_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
-	eTPU->CHAN[channel + ETPU_I2C_SLAVE_SCL_OUT_OFFSET].HSRR.R = ETPU_I2C_SLAVE_DATA_READY;
+	*latency_ptr = 0x00ffffff & p_i2c_slave_instance->p_cpba_pse->_host_latency;
 	return 0;
 }
 
@@ -187,13 +263,14 @@ int32_t aw_etpu_i2c_slave_set_write_buffer(
     uint8_t* buffer_ptr,
     uint32_t size)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__write_buffer_, (uint24_t)buffer_ptr & 0x3fff);
-	fs_etpu_set_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__write_buffer_size_, size);
+	p_i2c_slave_instance->p_write_buffer = ((uint32_t)buffer_ptr & 0x3fff) + p_i2c_slave_instance->p_data_ram;
+	p_i2c_slave_instance->write_buffer_size = size;
+	p_i2c_slave_instance->p_cpba_pse->_write_buffer = (uint32_t)buffer_ptr & 0x3fff;
+	p_i2c_slave_instance->p_cpba_pse->_write_buffer_size = size;
 	return 0;
 }
 
@@ -204,17 +281,28 @@ int32_t aw_etpu_i2c_slave_get_transfer_status(
     uint32_t* size_ptr,
     uint8_t* error_flags_ptr)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA24_I2C_slave__header_, 24, 0 },
+		{ _CPBA24_I2C_slave__byte_cnt_, 24, 0 },
+		{ _CPBA8_I2C_slave__error_flags_, 8, 0 },
+	};
+	int32_t err_code;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
+	// take a coherent snapshot of all three so they describe the same transfer
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_slave_instance->p_cpba,
+		_CPBA24_I2C_slave__result_seq_, fields, 3, 0);
+	if (err_code)
+		return err_code;
+
 	if (header_ptr)
-		*header_ptr = (uint8_t)fs_etpu_get_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__header_);
+		*header_ptr = (uint8_t)fields[0].value;
 	if (size_ptr)
-		*size_ptr = fs_etpu_get_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__byte_cnt_);
+		*size_ptr = fields[1].value;
 	if (error_flags_ptr)
-		*error_flags_ptr = fs_etpu_get_chan_local_8_ext(p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__error_flags_);
+		*error_flags_ptr = (uint8_t)fields[2].value;
 	return 0;
 }
 
@@ -225,27 +313,33 @@ int32_t aw_etpu_i2c_slave_get_write_data(
     uint8_t* dest_buffer_ptr,
     uint32_t* size_ptr)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
-	uint32_t i;
-	uint8_t* src_buffer_ptr;
-	uint32_t size;
+	struct aw_etpu_i2c_seq_field fields[] = {
+		{ _CPBA24_I2C_slave__header_, 24, 0 },
+		{ _CPBA24_I2C_slave__byte_cnt_, 24, 0 },
+	};
+	struct aw_etpu_i2c_seq_copy copy;
+	int32_t err_code;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 	if (!size_ptr || !header_ptr || !dest_buffer_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-	*header_ptr = (uint8_t)fs_etpu_get_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__header_);
-	*size_ptr = fs_etpu_get_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__byte_cnt_);
+	// header, size and buffer contents are copied under the result sequence
+	// counter so that they all describe the same completed transfer
 	// make sure not to exceed max buffer size
 	// it is up to the host to check for a buffer overflow fault
-	size = fs_etpu_get_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__write_buffer_size_);
-	if (*size_ptr < size)
-		size = *size_ptr;
-	src_buffer_ptr = (uint8_t*)(fs_etpu_get_chan_local_24_ext(p_i2c_slave_instance->em, channel, _CPBA24_I2C_slave__write_buffer_) +
-        (p_i2c_slave_instance->em == EM_AB ? fs_etpu_data_ram_start : fs_etpu_c_data_ram_start));
-	for (i = 0; i < size; i++)
-		*dest_buffer_ptr++ = *src_buffer_ptr++;
+	copy.src = p_i2c_slave_instance->p_write_buffer;
+	copy.dest = dest_buffer_ptr;
+	copy.size = p_i2c_slave_instance->write_buffer_size;
+	copy.limit_field = 1; // byte_cnt
+	err_code = aw_etpu_i2c_seq_read_frame((volatile uint8_t*)p_i2c_slave_instance->p_cpba,
+		_CPBA24_I2C_slave__result_seq_, fields, 2, &copy);
+	if (err_code)
+		return err_code;
+
+	*header_ptr = (uint8_t)fields[0].value;
+	*size_ptr = fields[1].value;
 	return 0;
 }
 
@@ -253,21 +347,11 @@ int32_t aw_etpu_i2c_slave_get_write_data(
 int32_t aw_etpu_i2c_slave_latch_clear_error_flags(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance)
 {
-    volatile struct eTPU_struct * eTPU;
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
-    if (p_i2c_slave_instance->em == EM_AB)
-    {
-        eTPU = eTPU_AB;
-    }
-    else
-    {
-        eTPU = eTPU_C;
-    }
-	eTPU->CHAN[channel+ETPU_I2C_SLAVE_SCL_IN_OFFSET].HSRR.R = ETPU_I2C_LATCH_CLEAR_ERRORS_HSR;
+	p_i2c_slave_instance->p_etpu->CHAN[p_i2c_slave_instance->base_chan_num+ETPU_I2C_SLAVE_SCL_IN_OFFSET].HSRR.R = ETPU_I2C_LATCH_CLEAR_ERRORS_HSR;
 	return 0;
 }
 
@@ -275,26 +359,24 @@ int32_t aw_etpu_i2c_slave_get_running_error_flags(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
     uint8_t* error_flags_ptr)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 	if (!error_flags_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-	*error_flags_ptr = fs_etpu_get_chan_local_8_ext(p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__error_flags_);
+	*error_flags_ptr = p_i2c_slave_instance->p_cpba->_error_flags;
 	return 0;
 }
 
 int32_t aw_etpu_i2c_slave_clear_running_error_flags(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
-	fs_etpu_set_chan_local_8_ext(p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__error_flags_, 0);
+	p_i2c_slave_instance->p_cpba->_error_flags = 0;
 	return 0;
 }
 
@@ -302,25 +384,23 @@ int32_t aw_etpu_i2c_slave_get_latched_error_flags(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
     uint8_t* error_flags_ptr)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 	if (!error_flags_ptr)
 		return FS_ETPU_ERROR_VALUE;
 #endif
-	*error_flags_ptr = fs_etpu_get_chan_local_8_ext(p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__latched_error_flags_);
+	*error_flags_ptr = p_i2c_slave_instance->p_cpba->_latched_error_flags;
 	return 0;
 }
 
 int32_t aw_etpu_i2c_slave_clear_latched_error_flags(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance)
 {
-	uint8_t channel = p_i2c_slave_instance->base_chan_num;
 #ifdef ETPU_I2C_PARAMETER_CHECK
-	if (((channel > (32 - ETPU_I2C_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_CHANNELS_USED)))
-		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_slave_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
 #endif
-	fs_etpu_set_chan_local_8_ext(p_i2c_slave_instance->em, channel, _CPBA8_I2C_slave__latched_error_flags_, 0);
+	p_i2c_slave_instance->p_cpba->_latched_error_flags = 0;
 	return 0;
 }
@@ -15,13 +15,20 @@
 #define __ETPU_I2C_SLAVE_H
 
 #include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_util_ext.h"
+#include "etpu_auto_api.h"	/* channel frame overlays (etpu_set_struct.h) */
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* largest data-wait hold timeout, in TCR1 counts */
+#define ETPU_I2C_SLAVE_HOLD_TIMEOUT_MAX_TICKS	0x7fffff
+
 /** A structure to represent an instance of I2C_slave
- *  It includes static I2C_slave initialization items. */
+ *  It includes static I2C_slave initialization items.  Once
+ *  aw_etpu_i2c_slave_init() succeeds it also serves as a validated
+ *  handle (see aw_i2c_master_instance_t). */
 struct aw_i2c_slave_instance_t
 {
     ETPU_MODULE         em;
@@ -37,8 +44,17 @@ struct aw_i2c_slave_instance_t
      *		that does most of the servicing and work, but they are
      *		assigned the same priority as SCL_out. */
     uint8_t             priority;
-    void                *p_cpba;        /* set during initialization */
-    void                *p_cpba_pse;    /* set during initialization */
+    volatile etpu_if_I2C_slave_CHANNEL_FRAME               *p_cpba;        /* set during initialization */
+    volatile etpu_if_I2C_slave_CHANNEL_FRAME_unsignedPSE   *p_cpba_pse;    /* set during initialization */
+    /* p_etpu - the eTPU module base; non-NULL only once initialization
+     *		has succeeded. */
+    volatile struct eTPU_struct         *p_etpu;        /* set during initialization */
+    /* p_data_ram - host address of the module SDM (eTPU address 0). */
+    uint8_t                             *p_data_ram;    /* set during initialization */
+    /* p_write_buffer, write_buffer_size - shadows of the write buffer
+     *		configuration (host address), kept by init/set_write_buffer. */
+    uint8_t                             *p_write_buffer;    /* set during initialization */
+    uint32_t                            write_buffer_size;  /* set during initialization */
 };
 
 /** A structure to represent a configuration of I2C_slave.
@@ -46,7 +62,8 @@ struct aw_i2c_slave_instance_t
 struct aw_i2c_slave_config_t
 {
     /* address - the 7-bit address of this I2C slave instance, in bits 7-1.
-     *		Works in conjunction with the address_mask value. */
+     *		Works in conjunction with the address_mask value.  Not used if
+     *		address_10bit is set. */
     uint8_t address;
     /* address_mask - an 8-bit mask that is applied to a received header byte
      *		before being compared to the slave address setting.  Bit 0 should
@@ -90,6 +107,27 @@ struct aw_i2c_slave_config_t
      *		seperated by at least tBUF ns or the slave will not properly process
      *		it. */
     uint32_t tBUF;
+    /* hold_timeout_us - in "data wait" mode, the longest time in us the slave
+     *		holds SCL low waiting for aw_etpu_i2c_slave_issue_data_ready().  When
+     *		it expires the fallback buffer is served instead and the
+     *		ETPU_I2C_SLAVE_HOLD_TIMEOUT error flag is set.  0 waits indefinitely. */
+    uint32_t hold_timeout_us;
+    /* p_fallback_buffer - pointer to the data served on a hold timeout
+     *		(pointer must be in eTPU data space - SDM, but can be in host or eTPU
+     *		pointer address space).  Required if hold_timeout_us is non-zero. */
+    uint8_t* p_fallback_buffer;
+    /* fallback_buffer_size - size of the fallback buffer in bytes, at least 1
+     *		if hold_timeout_us is non-zero.  Reads past it are handled as for
+     *		the read buffer. */
+    uint32_t fallback_buffer_size;
+    /* address_10bit - if non-zero, this slave instance answers to the
+     *		10-bit address address10 instead of address/address_mask. */
+    uint8_t address_10bit;
+    /* address10 - the 10-bit address of this I2C slave instance (0 - 0x3ff),
+     *		used if address_10bit is set.  The slave stays addressed until
+     *		the next STOP, so it also accepts the repeated-START read form.
+     *		The reported header is the first address byte (11110 A9 A8 R/W). */
+    uint16_t address10;
 };
 
 /****************************************************************
@@ -97,6 +135,10 @@ struct aw_i2c_slave_config_t
  * four eTPU channels that act as an I2C slave.  Four consecutive
  * channels must be used for I2C.
  *
+ * The channel group is validated here, once; on success the instance
+ * becomes a handle for the calls below, which then only check that
+ * the instance was initialized (FS_ETPU_ERROR_UNINITIALIZED if not).
+ *
  * Returns failure code, or pass (0).
  ****************************************************************/
 int32_t aw_etpu_i2c_slave_init(
@@ -121,16 +163,50 @@ int32_t aw_etpu_i2c_slave_set_read_buffer(
     uint8_t* buffer_ptr,
     uint32_t size);
 
+/****************************************************************
+ * Configure a new fallback buffer for an I2C slave instance, served
+ * when a data-wait hold times out.
+ *
+ * buffer_ptr - pointer to the buffer (pointer must be in eTPU data
+ *		space - SDM, but can be in host or eTPU pointer address space).
+ * size - the size of the buffer in bytes (at least 1).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_slave_set_fallback_buffer(
+    struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
+    uint8_t* buffer_ptr,
+    uint32_t size);
+
 /****************************************************************
  * Notify an I2C slave that is waiting for data (data wait mode,
  * read request pending) that it is ready.  This allows the slave
  * to respond to the requesting master.
  *
+ * If the hold has already timed out (see hold_timeout_us) the request
+ * is ignored apart from recording the host latency; the master has
+ * been served the fallback buffer.
+ *
  * Returns failure code, or pass (0).
  ****************************************************************/
 int32_t aw_etpu_i2c_slave_issue_data_ready(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance);
 
+/****************************************************************
+ * Get the time the host took to answer the last read data request
+ * in data-wait mode, from the request interrupt to the data ready
+ * host service request, in TCR1 counts.  A data ready request that
+ * arrived after a hold timeout is still measured, so this shows how
+ * late the host was.
+ *
+ * latency_ptr - pointer to the location to which to write the latency.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_slave_get_host_latency(
+    struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
+    uint32_t* latency_ptr);
+
 /****************************************************************
  * Configure a new write buffer for an I2C slave instance.
  *
@@ -165,7 +241,10 @@ int32_t aw_etpu_i2c_slave_set_write_buffer(
  * error_flags_ptr - the byte location at which to write the error flags
  *		retrieved from the eTPU.
  *
- * Returns failure code, or pass (0).
+ * The values are read as one coherent snapshot (see aw_etpu_i2c_seq_begin()).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer to this slave is in
+ * progress, other failure code, or pass (0).
  ****************************************************************/
 int32_t aw_etpu_i2c_slave_get_transfer_status(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
@@ -190,7 +269,11 @@ int32_t aw_etpu_i2c_slave_get_transfer_status(
  *		returned value will be larger than the amount of data that is
  *		actually returned, which is limited to the write buffer size.
  *
- * Returns failure code, or pass (0).
+ * The header, size and data are read as one coherent snapshot (see
+ * aw_etpu_i2c_seq_begin()).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer to this slave is in
+ * progress, other failure code, or pass (0).
  ****************************************************************/
 int32_t aw_etpu_i2c_slave_get_write_data(
     struct aw_i2c_slave_instance_t *p_i2c_slave_instance,
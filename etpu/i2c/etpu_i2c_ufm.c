@@ -0,0 +1,292 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_ufm.c
+*
+* DESCRIPTION: Implementation of API for initializing and controlling the
+* I2C write-only push-pull transmitter eTPU function.  See the .h file for
+* API documentation.
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+**************************************************************************/
+
+#include "etpu_util_ext.h"
+#include "etpu_i2c.h"
+#include "etpu_i2c_ufm.h"
+#include "etpu_i2c_common.h"
+#include "etpu_set_defines.h"
+
+
+int32_t aw_etpu_i2c_ufm_init(
+    struct aw_i2c_ufm_instance_t  *p_i2c_ufm_instance,
+    struct aw_i2c_ufm_config_t    *p_i2c_ufm_config)
+{
+    volatile struct eTPU_struct * eTPU;
+	uint32_t *pba;	/* parameter base address for channel */
+	uint32_t tcr1_freq;
+	uint32_t bit_time_tcr1_cnt;
+	uint32_t i2c_ufm_cpba;
+	uint32_t frame[_FRAME_SIZE_I2C_ufm_ / 4];
+	uint32_t i;
+	uint8_t *p_data_ram;
+	uint8_t channel = p_i2c_ufm_instance->base_chan_num;
+	uint8_t priority = p_i2c_ufm_instance->priority;
+
+	// invalidate the handle until initialization succeeds
+	p_i2c_ufm_instance->p_etpu = 0;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (((channel > (32 - ETPU_I2C_UFM_CHANNELS_USED)) && (channel < 64)) || (channel > 96 - (ETPU_I2C_UFM_CHANNELS_USED)))
+		return FS_ETPU_ERROR_VALUE;
+	if (!priority || (priority > 3))
+		return FS_ETPU_ERROR_VALUE;
+	if (!p_i2c_ufm_config->p_cmd_buffer || !p_i2c_ufm_config->bit_rate_khz)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+    if (p_i2c_ufm_instance->em == EM_AB)
+    {
+        eTPU = eTPU_AB;
+        p_data_ram = (uint8_t*)fs_etpu_data_ram_start;
+        if (channel < 32)
+        {
+            tcr1_freq = etpu_a_tcr1_freq;
+        }
+        else
+        {
+            tcr1_freq = etpu_b_tcr1_freq;
+        }
+    }
+    else
+    {
+        eTPU = eTPU_C;
+        p_data_ram = (uint8_t*)fs_etpu_c_data_ram_start;
+        tcr1_freq = etpu_c_tcr1_freq;
+    }
+
+	/* Disable channels to assign function safely */
+	fs_etpu_disable_ext(p_i2c_ufm_instance->em, channel );
+	fs_etpu_disable_ext(p_i2c_ufm_instance->em, channel + 1 );
+
+	/* allocate a channel frame if not already done so */
+	/* NOTE: this means that re-initialization of this channel (2 channels) */
+	/* must re-use the same channel frame allocation */
+	if (eTPU->CHAN[channel].CR.B.CPBA == 0 )
+	{
+		/* get parameter RAM
+		number of parameters passed from eTPU C code */
+		pba = fs_etpu_malloc_ext(p_i2c_ufm_instance->em, _FRAME_SIZE_I2C_ufm_);
+		if (pba == 0)
+			return (FS_ETPU_ERROR_MALLOC);
+	}
+	else /*set pba to what is in the CR register*/
+	{
+		pba = fs_etpu_get_cpba_ext(p_i2c_ufm_instance->em, channel);
+	}
+	// the channel pair shares the same channel frame
+	i2c_ufm_cpba = ((uint32_t)pba & 0x3fff)>>3;
+	eTPU->CHAN[channel  ].CR.B.CPBA = i2c_ufm_cpba;
+	eTPU->CHAN[channel+1].CR.B.CPBA = i2c_ufm_cpba;
+
+	p_i2c_ufm_instance->p_cpba = (volatile etpu_if_I2C_ufm_CHANNEL_FRAME*)pba;
+	if (p_i2c_ufm_instance->em == EM_AB)
+	{
+		p_i2c_ufm_instance->p_cpba_pse = (volatile etpu_if_I2C_ufm_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_data_ram_ext - fs_etpu_data_ram_start));
+	}
+	else
+	{
+		p_i2c_ufm_instance->p_cpba_pse = (volatile etpu_if_I2C_ufm_CHANNEL_FRAME_unsignedPSE*)
+			((uint32_t)pba + (fs_etpu_c_data_ram_ext - fs_etpu_c_data_ram_start));
+	}
+	p_i2c_ufm_instance->p_cmd_list = (struct aw_etpu_i2c_cmd_words*)
+		(((uint32_t)p_i2c_ufm_config->p_cmd_buffer & 0x3fff) + p_data_ram);
+
+	/* initialize the parameter values */
+	for (i = 0; i < _FRAME_SIZE_I2C_ufm_ / 4; i++)
+		frame[i] = 0;
+
+	// same default timing as the I2C master: a symmetric clock, the half
+	// bit time for START/STOP timing, and a twentieth for the data hold
+	bit_time_tcr1_cnt = tcr1_freq / (p_i2c_ufm_config->bit_rate_khz * 1000);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__tLOW_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__tHIGH_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__tBUF_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__tSU_STA_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__tSU_STO_, bit_time_tcr1_cnt / 2);
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__tHD_DAT_, bit_time_tcr1_cnt / 20);
+
+	// set the cmd buffer ptr
+	AW_ETPU_I2C_FRAME_SET_24(frame, _CPBA24_I2C_ufm__p_cmd_list_, (uint32_t)p_i2c_ufm_config->p_cmd_buffer & 0x3fff);
+
+	fs_memcpy32_ext(pba, frame, _FRAME_SIZE_I2C_ufm_);
+
+	/* no function modes */
+	eTPU->CHAN[channel+ETPU_I2C_UFM_SCL_OUT_OFFSET].SCR.R = 0;
+	eTPU->CHAN[channel+ETPU_I2C_UFM_SDA_OUT_OFFSET].SCR.R = 0;
+
+	/* write hsr to init the channels */
+	eTPU->CHAN[channel  ].HSRR.R = ETPU_I2C_INIT_HSR;
+	eTPU->CHAN[channel+1].HSRR.R = ETPU_I2C_INIT_HSR;
+
+	/* fully write channel configuration register */
+	/* channel   = SCL_out */
+	/* channel+1 = SDA_out */
+	/* this has the side-effect of starting the function running */
+	eTPU->CHAN[channel+ETPU_I2C_UFM_SCL_OUT_OFFSET].CR.R = (priority << 28) +
+		(_ENTRY_TABLE_PIN_DIR_I2C_ufm_I2C_SCL_out_ << 25) +
+		(_ENTRY_TABLE_TYPE_I2C_ufm_I2C_SCL_out_ << 24) +
+		(_FUNCTION_NUM_I2C_ufm_I2C_SCL_out_ << 16) +
+		i2c_ufm_cpba;
+	eTPU->CHAN[channel+ETPU_I2C_UFM_SDA_OUT_OFFSET].CR.R = (priority << 28) +
+		(_ENTRY_TABLE_PIN_DIR_I2C_ufm_I2C_SDA_out_ << 25) +
+		(_ENTRY_TABLE_TYPE_I2C_ufm_I2C_SDA_out_ << 24) +
+		(_FUNCTION_NUM_I2C_ufm_I2C_SDA_out_ << 16) +
+		i2c_ufm_cpba;
+
+	p_i2c_ufm_instance->shutdown.state = ETPU_I2C_SHUTDOWN_IDLE;
+
+	// handle is now valid
+	p_i2c_ufm_instance->p_etpu = eTPU;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_ufm_set_timing(
+    struct aw_i2c_ufm_instance_t  *p_i2c_ufm_instance,
+    struct aw_i2c_ufm_config_t    *p_i2c_ufm_config)
+{
+	uint32_t tcr1_freq;
+	uint8_t channel = p_i2c_ufm_instance->base_chan_num;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_ufm_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (p_i2c_ufm_config->tHD_DAT >= p_i2c_ufm_config->tLOW)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+    if (p_i2c_ufm_instance->em == EM_AB)
+    {
+        if (channel < 32)
+        {
+            tcr1_freq = etpu_a_tcr1_freq;
+        }
+        else
+        {
+            tcr1_freq = etpu_b_tcr1_freq;
+        }
+    }
+    else
+    {
+        tcr1_freq = etpu_c_tcr1_freq;
+    }
+	// put it into counts/us (hz => mhz)
+	tcr1_freq /= 1000000;
+
+	p_i2c_ufm_instance->p_cpba_pse->_tLOW = (tcr1_freq * p_i2c_ufm_config->tLOW) / 1000;
+	p_i2c_ufm_instance->p_cpba_pse->_tHIGH = (tcr1_freq * p_i2c_ufm_config->tHIGH) / 1000;
+	p_i2c_ufm_instance->p_cpba_pse->_tBUF = (tcr1_freq * p_i2c_ufm_config->tBUF) / 1000;
+	p_i2c_ufm_instance->p_cpba_pse->_tSU_STA = (tcr1_freq * p_i2c_ufm_config->tSU_STA) / 1000;
+	p_i2c_ufm_instance->p_cpba_pse->_tSU_STO = (tcr1_freq * p_i2c_ufm_config->tSU_STO) / 1000;
+	p_i2c_ufm_instance->p_cpba_pse->_tHD_DAT = (tcr1_freq * p_i2c_ufm_config->tHD_DAT) / 1000;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_ufm_transmit(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr)
+{
+	struct aw_etpu_i2c_cmd_words* p_cmd;
+
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_ufm_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if ((buffer_size && !buffer_ptr) || !AW_ETPU_I2C_CMD_SIZE_VALID(buffer_size))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// check ready flag first
+	if (p_i2c_ufm_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	p_cmd = p_i2c_ufm_instance->p_cmd_list;
+	p_cmd->header_buffer = AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_ENCODE_HEADER(slave_address, ETPU_I2C_WRITE_MESSAGE), buffer_ptr);
+	p_cmd->size = AW_ETPU_I2C_CMD_WORD1(0, buffer_size);
+
+	// set one cmd and go
+	p_i2c_ufm_instance->p_cpba->_cmd_cnt = 1;
+	p_i2c_ufm_instance->p_etpu->CHAN[p_i2c_ufm_instance->base_chan_num].HSRR.R = ETPU_I2C_UFM_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_ufm_encoded_transfer(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_ufm_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!cmd_words_ptr || !cmd_cnt || (cmd_cnt > 0xff))
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	// check ready flag first
+	if (p_i2c_ufm_instance->p_cpba->_in_use_flag)
+		return FS_ETPU_ERROR_NOT_READY;
+
+	// copy the whole list in one burst, then go
+	fs_memcpy32_ext((uint32_t*)p_i2c_ufm_instance->p_cmd_list, (uint32_t*)cmd_words_ptr,
+		cmd_cnt * sizeof(struct aw_etpu_i2c_cmd_words));
+	p_i2c_ufm_instance->p_cpba->_cmd_cnt = cmd_cnt;
+	p_i2c_ufm_instance->p_etpu->CHAN[p_i2c_ufm_instance->base_chan_num].HSRR.R = ETPU_I2C_UFM_START_TRANSFER_HSR;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_ufm_is_busy(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance,
+    uint8_t* busy_ptr)
+{
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_ufm_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+	if (!busy_ptr)
+		return FS_ETPU_ERROR_VALUE;
+#endif
+
+	*busy_ptr = p_i2c_ufm_instance->p_cpba->_in_use_flag ? 1 : 0;
+
+	return 0;
+}
+
+
+int32_t aw_etpu_i2c_ufm_shutdown(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance)
+{
+	int32_t err_code;
+#ifdef ETPU_I2C_PARAMETER_CHECK
+	if (!p_i2c_ufm_instance->p_etpu)
+		return FS_ETPU_ERROR_UNINITIALIZED;
+#endif
+	err_code = aw_etpu_i2c_shutdown_step(&p_i2c_ufm_instance->shutdown,
+		p_i2c_ufm_instance->em, p_i2c_ufm_instance->base_chan_num, ETPU_I2C_UFM_CHANNELS_USED);
+	if (err_code)
+		return err_code;
+
+	// handle is no longer valid
+	p_i2c_ufm_instance->p_etpu = 0;
+
+	return 0;
+}
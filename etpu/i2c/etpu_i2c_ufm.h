@@ -0,0 +1,183 @@
+/**************************************************************************
+* FILE NAME: etpu_i2c_ufm.h
+*
+* DESCRIPTION: API for initializing and controlling the I2C eTPU function
+* (write-only push-pull transmitter, Ultra Fast-mode style)
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+**************************************************************************/
+
+#ifndef __ETPU_I2C_UFM_H
+#define __ETPU_I2C_UFM_H
+
+#include "typedefs.h"	/* type definitions for eTPU interface */
+#include "etpu_util_ext.h"
+#include "etpu_auto_api.h"	/* channel frame overlays (etpu_set_struct.h) */
+#include "etpu_i2c.h"	/* non-blocking shutdown */
+#include "etpu_i2c_master.h"	/* transfer command words */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A structure to represent an instance of I2C_ufm
+ *  It includes static I2C_ufm initialization items.  Once
+ *  aw_etpu_i2c_ufm_init() succeeds it also serves as a validated
+ *  handle (see aw_i2c_master_instance_t). */
+struct aw_i2c_ufm_instance_t
+{
+    ETPU_MODULE         em;
+    /* base_chan_num - the base channel for the I2C eTPU UFm transmitter.
+     *		The channels are defined as follows:
+     *			base_chan_num   - SCL_out (USCL)
+     *			base_chan_num+1 - SDA_out (USDA)
+     *		Both pins must be configured push-pull (not open-drain). */
+    uint8_t             base_chan_num;
+    /* priority - the priority assigned to both channels, with a range of
+     *		1 (low) to 3 (high).  Each SCL clock is one thread, which must
+     *		be serviced within tHIGH of the clock's rising edge; a later
+     *		thread stretches the clock. */
+    uint8_t             priority;
+    volatile etpu_if_I2C_ufm_CHANNEL_FRAME              *p_cpba;        /* set during initialization */
+    volatile etpu_if_I2C_ufm_CHANNEL_FRAME_unsignedPSE  *p_cpba_pse;    /* set during initialization */
+    /* p_etpu - the eTPU module base; non-NULL only once initialization
+     *		has succeeded. */
+    volatile struct eTPU_struct         *p_etpu;        /* set during initialization */
+    /* p_cmd_list - host address of the command list the channel frame
+     *		points to (shadow of _p_cmd_list). */
+    struct aw_etpu_i2c_cmd_words        *p_cmd_list;    /* set during initialization */
+    /* shutdown - progress of aw_etpu_i2c_ufm_shutdown(). */
+    struct aw_etpu_i2c_shutdown_t       shutdown;      /* set during initialization */
+};
+
+/** A structure to represent a configuration of I2C_ufm. */
+struct aw_i2c_ufm_config_t
+{
+    /* p_cmd_buffer - pointer to a buffer in eTPU data memory (SDM) that is to
+     *		be used for transfer commands, 8 bytes per command. */
+    uint8_t             *p_cmd_buffer;
+    /* bit_rate_khz - the bit rate in kHz.  The initialization function
+     *		derives all the bit timings from this rate; the
+     *		aw_etpu_i2c_ufm_set_timing() interface can be used to override
+     *		them. */
+    uint32_t            bit_rate_khz;
+
+    // the below are only used by the set_timing() interface, in ns, with the
+    // same meaning as for the I2C master (see aw_i2c_master_config_t).
+    // tHD_DAT must be below tLOW, as SDA changes tHD_DAT after SCL falls.
+    uint32_t            tLOW;
+    uint32_t            tHIGH;
+    uint32_t            tBUF;
+    uint32_t            tSU_STA;
+    uint32_t            tSU_STO;
+    uint32_t            tHD_DAT;
+};
+
+
+/****************************************************************
+ * I2C UFm transmitter initialization.  This one routine
+ * initializes both eTPU channels of the write-only push-pull
+ * transmitter; two consecutive channels must be used.
+ *
+ * The channel pair is validated here, once; on success the instance
+ * becomes a handle for the calls below, which then only check that
+ * the instance was initialized (FS_ETPU_ERROR_UNINITIALIZED if not).
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_ufm_init(
+    struct aw_i2c_ufm_instance_t  *p_i2c_ufm_instance,
+    struct aw_i2c_ufm_config_t    *p_i2c_ufm_config);
+
+
+/****************************************************************
+ * Allows direct configuration of each timing parameter used by
+ * the transmitter.  Should only be called with no transfer in
+ * progress.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_ufm_set_timing(
+    struct aw_i2c_ufm_instance_t  *p_i2c_ufm_instance,
+    struct aw_i2c_ufm_config_t    *p_i2c_ufm_config);
+
+
+/****************************************************************
+ * Transmit a buffer of data to the specified slave address.  When
+ * transmission is complete (SDA has risen for the STOP), a channel
+ * interrupt will be generated from the base channel.  No ACKs are
+ * read, so there is no failure to report.
+ *
+ * slave_address - the slave address, where it is assumed bit 0
+ *		is 0 (write).
+ * buffer_size - the size in bytes of the data to be transmitted.
+ *		It does not include the header byte.
+ * buffer_ptr - the buffer from which data is transmitted.  The buffer
+ *		must reside in eTPU data memory (SDM).
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_ufm_transmit(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance,
+    uint8_t slave_address,
+    uint32_t buffer_size,
+    uint8_t* buffer_ptr);
+
+
+/****************************************************************
+ * Transmit a list of pre-encoded commands, each after a START or
+ * repeated START, in one transfer ending with a STOP; e.g. one
+ * frame to each of a chain of LED drivers.  The command words are
+ * those of the I2C master (AW_ETPU_I2C_CMD_WORDS()); the flags are
+ * ignored and the header byte is sent as given.  The list is copied
+ * into the command buffer, which must hold cmd_cnt commands.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY if a transfer is in progress,
+ * other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_ufm_encoded_transfer(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance,
+    const struct aw_etpu_i2c_cmd_words* cmd_words_ptr,
+    uint32_t cmd_cnt);
+
+
+/****************************************************************
+ * Find out whether a transfer is in progress.
+ *
+ * busy_ptr - the byte location at which to write 1 if a transfer
+ *		is in progress, else 0.
+ *
+ * Returns failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_ufm_is_busy(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance,
+    uint8_t* busy_ptr);
+
+
+/****************************************************************
+ * Shut down the transmitter and disable its channels; both pins
+ * stop driving.  The instance must be re-initialized before it is
+ * used again.
+ *
+ * The shutdown does not wait on the eTPU: the first call issues
+ * the shutdown HSRs (once no other HSR is pending), and the call is
+ * repeated (e.g. from a periodic task) until it returns pass, at
+ * which point the channels are disabled.
+ *
+ * Returns FS_ETPU_ERROR_NOT_READY while the shutdown is in
+ * progress, other failure code, or pass (0).
+ ****************************************************************/
+int32_t aw_etpu_i2c_ufm_shutdown(
+    struct aw_i2c_ufm_instance_t *p_i2c_ufm_instance);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ETPU_I2C_UFM_H
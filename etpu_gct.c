@@ -48,6 +48,7 @@
 #include "etpu_i2c_master.h"
 #include "etpu_i2c_slave.h"
 #include "etpu_i2c_common.h"
+#include "etpu_i2c_fixed.h"
 
 
 /*******************************************************************************
@@ -242,13 +243,16 @@ struct <func2>_states_t <func2>_states;
 #endif
 
 
+/* the declared SDM layout must fit the part's data RAM */
+AW_ETPU_I2C_SDM_CHECK(ETPU_SDM_LAYOUT_AB, ab, FS_ETPU_DATA_RAM_SIZE);
+
 /* defined I2C structures */
 
 /* I2C Master */
 struct aw_i2c_master_instance_t  i2c_master_instance =
 {
     EM_AB,
-    0, // base channel 0
+    ETPU_I2C_MASTER_BASE_CHAN,
     3,
     (void*)0,
     (void*)0,
@@ -256,6 +260,7 @@ struct aw_i2c_master_instance_t  i2c_master_instance =
 struct aw_i2c_master_config_t    i2c_master_config =
 {
     (uint8_t*)0, // will be filled in once allocated
+    0,
     100, // kHz bit rate
     // detailed timing parameters - not used in this example - just set to 0
     0,
@@ -265,13 +270,30 @@ struct aw_i2c_master_config_t    i2c_master_config =
     0,
     0,
     0,
+    0, // no byte timeout
+    0, // no transfer timeout
+    0, // no automatic bus recovery
+    0, // no NACK retries
+    ETPU_I2C_CMD_NACK_CONTINUE, // a failed command goes on to the next
+    0, // no extra retry interval
+    0, // the same interval before each retry
+    0, // no bus hold timeout
+    0, // sole master on the bus
+    // Hs-mode timing profile - not used in this example - just set to 0
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0, // Hs-mode master id
 };
 
 /* I2C Slave 1 */
 struct aw_i2c_slave_instance_t   i2c_slave1_instance =
 {
     EM_AB,
-    10, // base channel 10
+    ETPU_I2C_SLAVE1_BASE_CHAN,
     3,
     (void*)0,
     (void*)0,
@@ -288,12 +310,17 @@ struct aw_i2c_slave_config_t     i2c_slave1_config =
     0, // write buffer size will be filled in once allocated
     1250, // tSU_DAT, ns
     4700, // tBUF, ns
+    0, // no data-wait hold timeout
+    (uint8_t*)0, // no fallback buffer
+    0, // fallback buffer size
+    0, // 7-bit address
+    0, // no 10-bit address
 };
 /* I2C Slave 2 */
 struct aw_i2c_slave_instance_t   i2c_slave2_instance =
 {
     EM_AB,
-    14, // base channel 14
+    ETPU_I2C_SLAVE2_BASE_CHAN,
     3,
     (void*)0,
     (void*)0,
@@ -310,6 +337,11 @@ struct aw_i2c_slave_config_t     i2c_slave2_config =
     0, // write buffer size will be filled in once allocated
     1250, // tSU_DAT, ns
     4700, // tBUF, ns
+    0, // no data-wait hold timeout
+    (uint8_t*)0, // no fallback buffer
+    0, // fallback buffer size
+    0, // 7-bit address
+    0, // no 10-bit address
 };
 
 // I2C buffers
@@ -324,9 +356,73 @@ extern uint8_t* g_p_i2c_slave2_read_buf;
 extern uint8_t* g_p_i2c_slave2_write_buf;
 
 
+/*******************************************************************************
+* FUNCTION: my_system_etpu_code_loaded
+****************************************************************************//*!
+* @brief   This function checks whether the code RAM of a module already
+*          holds the code image, e.g. after a warm reset.  The engines are
+*          stopped, as code RAM is only readable with MCR[VIS] set; they are
+*          restarted by fs_etpu_init_ext.  The whole code RAM is checked:
+*          the image, and the zeroes fs_etpu_init_ext fills the rest with so
+*          that the MISC signature matches.
+*
+* @return  Non-zero if the code RAM matches the image.
+*******************************************************************************/
+static uint32_t my_system_etpu_code_loaded(
+  ETPU_MODULE em,
+  const uint32_t *code,
+  uint32_t code_size)
+{
+  volatile struct eTPU_struct * eTPU;
+  const volatile uint32_t *scm;
+  uint32_t scm_size;
+  uint32_t i;
+
+  if (em == EM_AB)
+  {
+    eTPU = eTPU_AB;
+    scm = (const volatile uint32_t *)fs_etpu_code_start;
+  }
+  else
+  {
+    eTPU = eTPU_C;
+    scm = (const volatile uint32_t *)fs_etpu_c_code_start;
+  }
+
+  scm_size = (eTPU->MCR.B.SCMSIZE + 1) * 2048;
+  if (code_size > scm_size) return(0);
+
+  eTPU->ECR_A.B.MDIS = 1;
+  eTPU->ECR_B.B.MDIS = 1;
+  eTPU->MCR.B.VIS = 1;
+  if (eTPU->MCR.B.VIS == 0) return(0);
+  for (i = 0; i < code_size / 4; i++)
+    if (scm[i] != code[i]) break;
+  if (i == code_size / 4)
+  {
+    for (; i < scm_size / 4; i++)
+      if (scm[i] != 0) break;
+  }
+  eTPU->MCR.B.VIS = 0;
+  return(i == scm_size / 4);
+}
+
 /*******************************************************************************
 * FUNCTION: my_system_etpu_init
 ****************************************************************************//*!
+* @brief   This function initialize the eTPU module with a full cold boot.
+*          See my_system_etpu_init_mode.
+*
+* @return  Zero or an error code is returned.
+*******************************************************************************/
+int32_t my_system_etpu_init(void)
+{
+  return(my_system_etpu_init_mode(ETPU_BOOT_COLD));
+}
+
+/*******************************************************************************
+* FUNCTION: my_system_etpu_init_mode
+****************************************************************************//*!
 * @brief   This function initialize the eTPU module:
 *          -# Initialize global setting using fs_etpu_init function
 *             and the my_etpu_config structure
@@ -334,20 +430,35 @@ extern uint8_t* g_p_i2c_slave2_write_buf;
 *             fs_etpu2_init function
 *          -# Initialize channel setting using channel function APIs
 *
+* @param   boot_mode - ETPU_BOOT_COLD clears all of data RAM and loads the
+*          code.  ETPU_BOOT_FAST clears only the globals and stack; every
+*          I2C channel frame is written in full by its init function, and
+*          buffers hold stale data until written.  ETPU_BOOT_WARM is as
+*          ETPU_BOOT_FAST, but skips the code load if code RAM already
+*          matches the image.  Both modules are brought up back to back
+*          with no waits; no channel function runs until my_system_etpu_start.
+*
 * @return  Zero or an error code is returned.
 *******************************************************************************/
-int32_t my_system_etpu_init(void)
+int32_t my_system_etpu_init_mode(uint32_t boot_mode)
 {
   int32_t err_code;
+  uint32_t *code;
 
   /* Initialization of eTPU DATA RAM */
-  fs_memset32_ext((uint32_t*)fs_etpu_data_ram_start, 0, fs_etpu_data_ram_end - fs_etpu_data_ram_start);
+  if (boot_mode == ETPU_BOOT_COLD)
+    fs_memset32_ext((uint32_t*)fs_etpu_data_ram_start, 0, fs_etpu_data_ram_end - fs_etpu_data_ram_start);
+  else
+    fs_memset32_ext((uint32_t*)fs_etpu_data_ram_start, 0, AW_ETPU_I2C_SDM_ROUND(AW_ETPU_I2C_SDM_GLOBALS_SIZE));
 
   /* Initialization of eTPU global settings */
+  code = (uint32_t *)etpu_code;
+  if ((boot_mode == ETPU_BOOT_WARM) && my_system_etpu_code_loaded(EM_AB, code, sizeof(etpu_code)))
+    code = 0; /* already loaded */
   err_code = fs_etpu_init_ext(
     EM_AB,
     &my_etpu_config,
-    (uint32_t *)etpu_code, sizeof(etpu_code),
+    code, sizeof(etpu_code),
     (uint32_t *)etpu_globals, sizeof(etpu_globals));
   if(err_code != 0) return(err_code);
 
@@ -369,13 +480,19 @@ int32_t my_system_etpu_init(void)
 #if defined(MPC5777C)
 /* eTPU-C module */
   /* Initialization of eTPU DATA RAM */
-  fs_memset32_ext((uint32_t*)fs_etpu_c_data_ram_start, 0, fs_etpu_c_data_ram_end - fs_etpu_c_data_ram_start);
+  if (boot_mode == ETPU_BOOT_COLD)
+    fs_memset32_ext((uint32_t*)fs_etpu_c_data_ram_start, 0, fs_etpu_c_data_ram_end - fs_etpu_c_data_ram_start);
+  else
+    fs_memset32_ext((uint32_t*)fs_etpu_c_data_ram_start, 0, AW_ETPU_I2C_SDM_ROUND(C_GLOBAL_DATA_SIZE_ + C_STACK_SIZE_));
 
   /* Initialization of eTPU global settings */
+  code = (uint32_t *)etpu_c_code;
+  if ((boot_mode == ETPU_BOOT_WARM) && my_system_etpu_code_loaded(EM_C, code, sizeof(etpu_c_code)))
+    code = 0; /* already loaded */
   err_code = fs_etpu_init_ext(
     EM_C,
     &my_etpu_c_config,
-    (uint32_t *)etpu_c_code, sizeof(etpu_c_code),
+    code, sizeof(etpu_c_code),
     (uint32_t *)etpu_c_globals, sizeof(etpu_c_globals));
   if(err_code != 0) return(err_code);
 
@@ -413,34 +530,35 @@ int32_t my_system_etpu_init(void)
     // initialize I2C channels
     
     // first need to allocate some buffers
-	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, 64, &g_p_i2c_master_cmd_buf))
+	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_master_cmd_buf))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, 64, &g_p_i2c_master_buf1))
+	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_master_buf1))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, 64, &g_p_i2c_master_buf2))
+	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_master_buf2))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, 64, &g_p_i2c_master_buf3))
+	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_master_buf3))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, 64, &g_p_i2c_master_buf4))
+	if (aw_etpu_i2c_allocate_buffer(i2c_master_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_master_buf4))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_slave1_instance.em, 64, &g_p_i2c_slave1_read_buf))
+	if (aw_etpu_i2c_allocate_buffer(i2c_slave1_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_slave1_read_buf))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_slave1_instance.em, 64, &g_p_i2c_slave1_write_buf))
+	if (aw_etpu_i2c_allocate_buffer(i2c_slave1_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_slave1_write_buf))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_slave2_instance.em, 64, &g_p_i2c_slave2_read_buf))
+	if (aw_etpu_i2c_allocate_buffer(i2c_slave2_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_slave2_read_buf))
 		return FS_ETPU_ERROR_MALLOC;
-	if (aw_etpu_i2c_allocate_buffer(i2c_slave2_instance.em, 64, &g_p_i2c_slave2_write_buf))
+	if (aw_etpu_i2c_allocate_buffer(i2c_slave2_instance.em, ETPU_I2C_BUF_SIZE, &g_p_i2c_slave2_write_buf))
 		return FS_ETPU_ERROR_MALLOC;
     // set buffer info into config structures
     i2c_master_config.p_cmd_buffer = g_p_i2c_master_cmd_buf;
+    i2c_master_config.cmd_buffer_size = ETPU_I2C_BUF_SIZE;
     i2c_slave1_config.p_read_buffer = g_p_i2c_slave1_read_buf;
-    i2c_slave1_config.read_buffer_size = 64;
+    i2c_slave1_config.read_buffer_size = ETPU_I2C_BUF_SIZE;
     i2c_slave1_config.p_write_buffer = g_p_i2c_slave1_write_buf;
-    i2c_slave1_config.write_buffer_size = 64;
+    i2c_slave1_config.write_buffer_size = ETPU_I2C_BUF_SIZE;
     i2c_slave2_config.p_read_buffer = g_p_i2c_slave2_read_buf;
-    i2c_slave2_config.read_buffer_size = 64;
+    i2c_slave2_config.read_buffer_size = ETPU_I2C_BUF_SIZE;
     i2c_slave2_config.p_write_buffer = g_p_i2c_slave2_write_buf;
-    i2c_slave2_config.write_buffer_size = 64;
+    i2c_slave2_config.write_buffer_size = ETPU_I2C_BUF_SIZE;
 
     // now initialize functions
     err_code = aw_etpu_i2c_master_init(&i2c_master_instance, &i2c_master_config);
@@ -450,6 +568,10 @@ int32_t my_system_etpu_init(void)
     err_code = aw_etpu_i2c_slave_init(&i2c_slave2_instance, &i2c_slave2_config);
     if (err_code != FS_ETPU_ERROR_NONE) return(err_code + (i2c_slave2_instance.base_chan_num<<16));
 
+    // buffers allocated from here on can be released and reused
+    err_code = aw_etpu_i2c_pool_init(EM_AB, ETPU_I2C_POOL_SIZE);
+    if (err_code != FS_ETPU_ERROR_NONE) return(err_code);
+
   return(0);
 }
 
@@ -58,6 +58,44 @@
 #define ETPU_SPI_SLAVE1_SCLK_CHAN   ETPU_ENGINE_A_CHANNEL(8)
 #define ETPU_SPI_SLAVE1_MOSI_CHAN   ETPU_ENGINE_A_CHANNEL(9)
 
+#define ETPU_I2C_MASTER_BASE_CHAN   ETPU_ENGINE_A_CHANNEL(0)
+#define ETPU_I2C_SLAVE1_BASE_CHAN   ETPU_ENGINE_A_CHANNEL(10)
+#define ETPU_I2C_SLAVE2_BASE_CHAN   ETPU_ENGINE_A_CHANNEL(14)
+
+/* the I2C channel groups are fixed - check them at compile time; the
+ * fast-path helpers (etpu_i2c_fixed.h) take the channel by these tags */
+#include "etpu_i2c_fixed.h"
+
+AW_ETPU_I2C_CHECK_CHANNEL_GROUP(EM_AB, ETPU_I2C_MASTER_BASE_CHAN, i2c_master);
+AW_ETPU_I2C_CHECK_CHANNEL_GROUP(EM_AB, ETPU_I2C_SLAVE1_BASE_CHAN, i2c_slave1);
+AW_ETPU_I2C_CHECK_CHANNEL_GROUP(EM_AB, ETPU_I2C_SLAVE2_BASE_CHAN, i2c_slave2);
+
+/*******************************************************************************
+* eTPU-AB SDM layout, in allocation order (see etpu_i2c_sdm.h)
+*******************************************************************************/
+#include "etpu_i2c_sdm.h"
+
+#define ETPU_I2C_BUF_SIZE           64
+#define ETPU_I2C_POOL_SIZE          256
+
+#define ETPU_SDM_LAYOUT_AB(X) \
+    X(ab_globals,           AW_ETPU_I2C_SDM_GLOBALS_SIZE) \
+    X(ab_master_cmd_buf,    ETPU_I2C_BUF_SIZE) \
+    X(ab_master_buf1,       ETPU_I2C_BUF_SIZE) \
+    X(ab_master_buf2,       ETPU_I2C_BUF_SIZE) \
+    X(ab_master_buf3,       ETPU_I2C_BUF_SIZE) \
+    X(ab_master_buf4,       ETPU_I2C_BUF_SIZE) \
+    X(ab_slave1_read_buf,   ETPU_I2C_BUF_SIZE) \
+    X(ab_slave1_write_buf,  ETPU_I2C_BUF_SIZE) \
+    X(ab_slave2_read_buf,   ETPU_I2C_BUF_SIZE) \
+    X(ab_slave2_write_buf,  ETPU_I2C_BUF_SIZE) \
+    X(ab_master_frame,      AW_ETPU_I2C_SDM_MASTER_FRAME_SIZE) \
+    X(ab_slave1_frame,      AW_ETPU_I2C_SDM_SLAVE_FRAME_SIZE) \
+    X(ab_slave2_frame,      AW_ETPU_I2C_SDM_SLAVE_FRAME_SIZE) \
+    X(ab_buffer_pool,       ETPU_I2C_POOL_SIZE)
+
+AW_ETPU_I2C_SDM_LAYOUT(ETPU_SDM_LAYOUT_AB, ab);
+
 /*******************************************************************************
 * Define Interrupt Enable, DMA Enable and Output Disable
 *******************************************************************************/
@@ -101,7 +139,13 @@ extern struct aw_i2c_slave_config_t     i2c_slave2_config;
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
+/* boot modes of my_system_etpu_init_mode() */
+#define ETPU_BOOT_COLD  0   /* clear all data RAM, load code */
+#define ETPU_BOOT_FAST  1   /* clear only globals and stack, load code */
+#define ETPU_BOOT_WARM  2   /* as FAST, keep code RAM if it matches the image */
+
 int32_t my_system_etpu_init (void);
+int32_t my_system_etpu_init_mode (uint32_t boot_mode);
 void    my_system_etpu_start(void);
 
 /*******************************************************************************
@@ -23,6 +23,7 @@ uint32_t fs_etpu_code_start =     0xC3FD0000;
 uint32_t fs_etpu_data_ram_start = 0xC3FC8000;
 uint32_t fs_etpu_data_ram_end =   0xC3FC89FC;
 uint32_t fs_etpu_data_ram_ext =   0xC3FCC000;
+#define FS_ETPU_DATA_RAM_SIZE   0xA00 /* fs_etpu_data_ram_end - fs_etpu_data_ram_start + 4 */
 
 /* no C module on this part - set addresses to 0 */
 volatile struct eTPU_struct * const eTPU_C  = (struct eTPU_struct *)0; 
@@ -30,6 +31,7 @@ uint32_t fs_etpu_c_code_start =     0x0;
 uint32_t fs_etpu_c_data_ram_start = 0x0;
 uint32_t fs_etpu_c_data_ram_end =   0x0;
 uint32_t fs_etpu_c_data_ram_ext =   0x0;
+#define FS_ETPU_C_DATA_RAM_SIZE 0x0
 
 /*********************************************************************
  *
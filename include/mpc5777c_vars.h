@@ -20,6 +20,7 @@ const uint32_t fs_etpu_code_start =     0xC3FD0000;
 const uint32_t fs_etpu_data_ram_start = 0xC3FC8000;
 const uint32_t fs_etpu_data_ram_end =   0xC3FC97FC;
 const uint32_t fs_etpu_data_ram_ext =   0xC3FCC000;
+#define FS_ETPU_DATA_RAM_SIZE   0x1800 /* fs_etpu_data_ram_end - fs_etpu_data_ram_start + 4 */
 
 /* no C module on this part - set addresses to 0 */
 volatile struct eTPU_struct * const eTPU_C  = (struct eTPU_struct *)0xFFE00000; 
@@ -27,6 +28,7 @@ const uint32_t fs_etpu_c_code_start =     0xFFE10000;
 const uint32_t fs_etpu_c_data_ram_start = 0xFFE08000;
 const uint32_t fs_etpu_c_data_ram_end =   0xFFE08BFC;
 const uint32_t fs_etpu_c_data_ram_ext =   0xFFE0C000;
+#define FS_ETPU_C_DATA_RAM_SIZE 0xC00
 
 /*********************************************************************
  *
@@ -78,6 +78,66 @@ echo Running "SlaveErrorTest" ...
 %DEVTOOL% -p=Proj.ETpuIdeProj -s=SlaveErrorTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
 if  %ERRORLEVEL% NEQ 0 ( goto errors )
 
+echo Running "ResultSeqTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=ResultSeqTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "BusRecoveryTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=BusRecoveryTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "TimeoutTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=TimeoutTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "HoldTimeoutTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=HoldTimeoutTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "AbortTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=AbortTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "HoldTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=HoldTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "NackRetryTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=NackRetryTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "NackPolicyTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=NackPolicyTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "ArbitrationTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=ArbitrationTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "MonitorTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=MonitorTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "Address10Test" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=Address10Test.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "HsModeTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=HsModeTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "UfmTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=UfmTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "MultilaneTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=MultilaneTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
+echo Running "NodeTest" ...
+%DEVTOOL% -p=Proj.ETpuIdeProj -s=NodeTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
+if  %ERRORLEVEL% NEQ 0 ( goto errors )
+
 echo Test for 100 percent code coverage...
 %DEVTOOL% -p=Proj.ETpuIdeProj -s=CoverageTest.ETpuCommand -NoBuild %DEVTOOL_OPTIONS% %1 %2 %3 %4
 if  %ERRORLEVEL% NEQ 0 ( goto errors )
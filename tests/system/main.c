@@ -15,10 +15,15 @@
 #include "etpu_i2c_master.h"
 #include "etpu_i2c_slave.h"
 #include "etpu_i2c_common.h"
+#include "etpu_i2c_fixed.h"
 
 /* set to 1 on succesful completion */
 uint32_t g_complete_flag = 0;
 
+/* set to 1 once the eTPU boot is done; the CPU script checks it against */
+/* the boot time budget */
+uint32_t g_boot_done_flag = 0;
+
 uint8_t g_i2c_error_flags;
 
 uint8_t* g_p_i2c_master_cmd_buf;
@@ -154,18 +159,110 @@ int user_main()
 {
 	uint8_t header;
 	uint32_t size;
+	uint8_t error_flags;
 	uint8_t i2c_local_buffer[64];
+	struct aw_etpu_i2c_cmd_words cmd_words[1];
+	struct aw_i2c_master_instance_t uninit_master_instance = { EM_AB, 0, 3 };
+	struct aw_etpu_i2c_pool_stats pool_stats;
+	uint8_t* p_pool_buf1;
+	uint8_t* p_pool_buf2;
+	ETPU_MODULE place_em;
+	uint8_t place_chan;
+	uint32_t place_load;
+	struct aw_etpu_i2c_shutdown_t shutdowns[2];
+	int32_t err_code;
+	int32_t err_code2;
+	uint8_t recovery_clocks;
 
 	/* initialize interrupt support */
 	isrLibInit();
 
-	/* eTPU init */
-	if (my_system_etpu_init())
+	/* eTPU init - the I2C functions need no more than a fast boot; on a */
+	/* first boot code RAM does not match, so the code is loaded */
+	if (my_system_etpu_init_mode(ETPU_BOOT_WARM))
 		return 1; // init failed
+	g_boot_done_flag = 1;
+
+	// the SDM layout declared in etpu_gct.h must match what was allocated
+	if (((uint32_t)g_p_i2c_master_cmd_buf - fs_etpu_data_ram_start != AW_ETPU_I2C_SDM_ab_master_cmd_buf_START) ||
+		((uint32_t)i2c_slave2_instance.p_cpba - fs_etpu_data_ram_start != AW_ETPU_I2C_SDM_ab_slave2_frame_START) ||
+		((uint32_t)fs_etpu_free_param - fs_etpu_data_ram_start != AW_ETPU_I2C_SDM_ab_TOTAL))
+		return 1;
+
+	// the channel frames, written as one image each, must hold the configuration
+	if (((0x00ffffff & i2c_master_instance.p_cpba_pse->_p_cmd_list) != ((uint32_t)g_p_i2c_master_cmd_buf & 0x3fff)) ||
+		(i2c_slave1_instance.p_cpba->_address != 0x64) || (i2c_slave2_instance.p_cpba->_address_mask != 0xf0) ||
+		((0x00ffffff & i2c_slave2_instance.p_cpba_pse->_write_buffer_size) != ETPU_I2C_BUF_SIZE))
+		return 1;
+
+	// pool buffers are reused once released; other classes are carved fresh
+	if (aw_etpu_i2c_allocate_buffer(EM_AB, 20, &p_pool_buf1))
+		return 1;
+	if ((uint32_t)p_pool_buf1 - fs_etpu_data_ram_start != AW_ETPU_I2C_SDM_ab_buffer_pool_START)
+		return 1;
+	if (aw_etpu_i2c_free_buffer(EM_AB, p_pool_buf1, 20))
+		return 1;
+	if (aw_etpu_i2c_allocate_buffer(EM_AB, 32, &p_pool_buf2) || (p_pool_buf2 != p_pool_buf1))
+		return 1;
+	if (aw_etpu_i2c_allocate_buffer(EM_AB, 64, &p_pool_buf1) || (p_pool_buf1 != p_pool_buf2 + 32))
+		return 1;
+	if (aw_etpu_i2c_allocate_buffer(EM_AB, ETPU_I2C_POOL_SIZE, &p_pool_buf1) != FS_ETPU_ERROR_MALLOC)
+		return 1;
+	if (aw_etpu_i2c_free_buffer(EM_AB, p_pool_buf2 + 4, 32) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	// the class comes from the pool's record: a wrong size, a block that
+	// is not allocated and a second free are all refused
+	if (aw_etpu_i2c_free_buffer(EM_AB, p_pool_buf2, 64) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	if (aw_etpu_i2c_free_buffer(EM_AB, p_pool_buf2 + 8, 8) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	if (aw_etpu_i2c_free_buffer(EM_AB, p_pool_buf2, 32))
+		return 1;
+	if (aw_etpu_i2c_free_buffer(EM_AB, p_pool_buf2, 32) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	if (aw_etpu_i2c_pool_get_stats(EM_AB, &pool_stats))
+		return 1;
+	if ((pool_stats.arena_bytes != ETPU_I2C_POOL_SIZE) || (pool_stats.uncarved_bytes != ETPU_I2C_POOL_SIZE - 96) ||
+		(pool_stats.used_bytes != 64) || (pool_stats.peak_used_bytes != 96) || (pool_stats.free_bytes != 32) ||
+		(pool_stats.free_block_cnt[2] != 1) || (pool_stats.fail_cnt != 1))
+		return 1;
+
+	// placement bookkeeping only (this part has no engine B): groups go to
+	// the least loaded engine and never overlap the fixed instances
+	if (aw_etpu_i2c_place_add_engine(ETPU_I2C_ENGINE_A, ~0x0003fc0fu, 0) ||
+		aw_etpu_i2c_place_add_engine(ETPU_I2C_ENGINE_B, 0x000000ffu, AW_ETPU_I2C_SLAVE_LOAD(200)))
+		return 1;
+	if (aw_etpu_i2c_place(AW_ETPU_I2C_MASTER_LOAD(100), &place_em, &place_chan) ||
+		(place_em != EM_AB) || (place_chan != 4))
+		return 1;
+	if (aw_etpu_i2c_place(AW_ETPU_I2C_SLAVE_LOAD(100), &place_em, &place_chan) ||
+		(place_em != EM_AB) || (place_chan != 64))
+		return 1;
+	if (aw_etpu_i2c_place(AW_ETPU_I2C_SLAVE_LOAD(100), &place_em, &place_chan) ||
+		(place_em != EM_AB) || (place_chan != 18))
+		return 1;
+	if (aw_etpu_i2c_place(AW_ETPU_I2C_SLAVE_LOAD(100), &place_em, &place_chan) ||
+		(place_em != EM_AB) || (place_chan != 68))
+		return 1;
+	// with a group freed on engine B, its budget still sends a heavier bus to A
+	if (aw_etpu_i2c_unplace(EM_AB, 68, AW_ETPU_I2C_SLAVE_LOAD(100)))
+		return 1;
+	if (aw_etpu_i2c_place(AW_ETPU_I2C_SLAVE_LOAD(150), &place_em, &place_chan) ||
+		(place_em != EM_AB) || (place_chan != 22))
+		return 1;
+	if (aw_etpu_i2c_unplace(EM_AB, 68, AW_ETPU_I2C_SLAVE_LOAD(100)) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	if (aw_etpu_i2c_place_get_load(ETPU_I2C_ENGINE_A, &place_load) ||
+		(place_load != AW_ETPU_I2C_MASTER_LOAD(100) + AW_ETPU_I2C_SLAVE_LOAD(250)))
+		return 1;
 
 	/* start the eTPU timers */
 	my_system_etpu_start();
 
+	// calls through an instance that was never initialized must be rejected
+	if (aw_etpu_i2c_master_transmit(&uninit_master_instance, 0x64, 4, g_p_i2c_master_buf1) != FS_ETPU_ERROR_UNINITIALIZED)
+		return 1;
+
 	at_time(3000);
 
 	/* issue a transmit request */
@@ -232,6 +329,16 @@ int user_main()
 		(g_i2c_error_flags != 0))
 		return 1;
 
+	// check that coherent retrieval of the read data and status works
+	if (aw_etpu_i2c_master_get_read_data(&i2c_master_instance, g_p_i2c_master_buf1, i2c_local_buffer, 8, &error_flags))
+		return 1;
+	if ((i2c_local_buffer[0] != 0x01) || (i2c_local_buffer[7] != 0xef) || (error_flags != 0))
+		return 1;
+	if (aw_etpu_i2c_slave_get_transfer_status(&i2c_slave1_instance, &header, &size, &error_flags))
+		return 1;
+	if ((header != 0x65) || (size != 8) || (error_flags != 0))
+		return 1;
+
 
 	at_time(5000);
 
@@ -280,9 +387,9 @@ int user_main()
     }
 
 	aw_etpu_i2c_slave_clear_running_error_flags(&i2c_slave2_instance);
-	((struct aw_etpu_i2c_transfer_cmd*)g_p_i2c_master_cmd_buf)->_header = 0x75;
-	((struct aw_etpu_i2c_transfer_cmd*)g_p_i2c_master_cmd_buf)->_p_buffer = (uint32_t)g_p_i2c_master_buf1 & 0x3fff;
-	((struct aw_etpu_i2c_transfer_cmd*)g_p_i2c_master_cmd_buf)->_size = 3;
+	cmd_words[0].header_buffer = AW_ETPU_I2C_CMD_WORD0(0x75, g_p_i2c_master_buf1);
+	cmd_words[0].size = 3;
+	fs_memcpy32_ext((uint32_t*)g_p_i2c_master_cmd_buf, (uint32_t*)cmd_words, sizeof(struct aw_etpu_i2c_cmd_words));
 	if (aw_etpu_i2c_master_raw_transfer(&i2c_master_instance, (struct aw_etpu_i2c_transfer_cmd*)g_p_i2c_master_cmd_buf, 1))
 		return 1;
 
@@ -293,7 +400,11 @@ int user_main()
 	g_p_i2c_slave2_read_buf[0] = 0xaa;
 	g_p_i2c_slave2_read_buf[1] = 0x55;
 	g_p_i2c_slave2_read_buf[2] = 0xaa;
-	aw_etpu_i2c_slave_issue_data_ready(&i2c_slave2_instance);
+	/* a tag naming another instance's channel group is refused */
+	if (aw_etpu_i2c_slave_fixed_issue_data_ready(&i2c_slave1_instance, i2c_slave2) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	if (aw_etpu_i2c_slave_fixed_issue_data_ready(&i2c_slave2_instance, i2c_slave2))
+		return 1;
 
 	// check for master transfer complete done
 	g_i2c_error_flags = 0;
@@ -313,7 +424,7 @@ int user_main()
 
 	/* test general call */
 	g_p_i2c_master_buf3[0] = 0xcc;
-	if (aw_etpu_i2c_master_transmit(&i2c_master_instance, 0x00, 1, g_p_i2c_master_buf3))
+	if (aw_etpu_i2c_master_fixed_transmit(&i2c_master_instance, i2c_master, 0x00, 1, g_p_i2c_master_buf3))
 		return 1;
 
 	/* need to wait for completion by polling on CISR - normally handled */
@@ -341,12 +452,71 @@ int user_main()
 
 
 
-	at_time(8000);
+	at_time(7500);
+
+	/* test a pre-encoded command list */
+	g_p_i2c_master_buf3[0] = 0x5a;
+	g_p_i2c_master_buf3[1] = 0xa5;
+	cmd_words[0].header_buffer = AW_ETPU_I2C_CMD_WORD0(AW_ETPU_I2C_HEADER(0x64, ETPU_I2C_WRITE_MESSAGE), g_p_i2c_master_buf3);
+	cmd_words[0].size = 2;
+	/* a list longer than the command buffer is refused, not copied */
+	if (aw_etpu_i2c_master_encoded_transfer(&i2c_master_instance, cmd_words,
+		i2c_master_instance.cmd_capacity + 1) != FS_ETPU_ERROR_VALUE)
+		return 1;
+	if (aw_etpu_i2c_master_encoded_transfer(&i2c_master_instance, cmd_words, 1))
+		return 1;
+
+	g_i2c_error_flags = 0;
+	if (aw_etpu_i2c_master_wait_for_done_int(&i2c_master_instance))
+		return 1;
+	if (aw_etpu_i2c_slave_wait_for_done_int(&i2c_slave1_instance))
+		return 1;
+	if ((g_p_i2c_slave1_write_buf[0] != 0x5a) || (g_p_i2c_slave1_write_buf[1] != 0xa5) || (g_i2c_error_flags != 0))
+		return 1;
+
+
+	at_time(7750);
 
-	/* shutdown the I2C drivers */
-	if (aw_etpu_i2c_shutdown(EM_AB, i2c_master_instance.base_chan_num))
+	/* bus recovery on a free bus - no clocks needed, just the STOP */
+	if (aw_etpu_i2c_master_recover_bus(&i2c_master_instance))
+		return 1;
+	if (aw_etpu_i2c_master_recover_bus(&i2c_master_instance) != FS_ETPU_ERROR_NOT_READY)
+		return 1;
+
+	g_i2c_error_flags = 0;
+	if (aw_etpu_i2c_master_wait_for_done_int(&i2c_master_instance))
+		return 1;
+	if (aw_etpu_i2c_master_get_recovery_status(&i2c_master_instance, &recovery_clocks, &error_flags))
 		return 1;
-	if (aw_etpu_i2c_shutdown(EM_AB, i2c_slave1_instance.base_chan_num))
+	if ((recovery_clocks != 0) || (error_flags != 0) || (g_i2c_error_flags != 0))
+		return 1;
+
+
+	at_time(8000);
+
+	/* shutdown the I2C drivers - master and slave1 together without */
+	/* blocking, each once any transfer in progress has ended */
+	shutdowns[0].em = i2c_master_instance.em;
+	shutdowns[0].channel = i2c_master_instance.base_chan_num;
+	shutdowns[0].chan_cnt = ETPU_I2C_CHANNELS_USED;
+	shutdowns[0].seq_offset = _CPBA24_I2C_master__result_seq_;
+	shutdowns[0].state = ETPU_I2C_SHUTDOWN_IDLE;
+	shutdowns[1].em = i2c_slave1_instance.em;
+	shutdowns[1].channel = i2c_slave1_instance.base_chan_num;
+	shutdowns[1].chan_cnt = ETPU_I2C_CHANNELS_USED;
+	shutdowns[1].seq_offset = _CPBA24_I2C_slave__result_seq_;
+	shutdowns[1].state = ETPU_I2C_SHUTDOWN_IDLE;
+	if (aw_etpu_i2c_shutdown_poll(&shutdowns[0]) != FS_ETPU_ERROR_UNINITIALIZED)
+		return 1;
+	if (aw_etpu_i2c_shutdown_start(&shutdowns[0], 1) || aw_etpu_i2c_shutdown_start(&shutdowns[1], 1))
+		return 1;
+	do
+	{
+		err_code = aw_etpu_i2c_shutdown_poll(&shutdowns[0]);
+		err_code2 = aw_etpu_i2c_shutdown_poll(&shutdowns[1]);
+	} while ((err_code == FS_ETPU_ERROR_NOT_READY) || (err_code2 == FS_ETPU_ERROR_NOT_READY));
+	if (err_code || err_code2 ||
+		(shutdowns[0].state != ETPU_I2C_SHUTDOWN_DONE) || (shutdowns[1].state != ETPU_I2C_SHUTDOWN_DONE))
 		return 1;
 	if (aw_etpu_i2c_shutdown(EM_AB, i2c_slave2_instance.base_chan_num))
 		return 1;
@@ -0,0 +1,763 @@
+/**************************************************************************
+* FILE NAME: i2c_monitor_decode.c
+*
+* DESCRIPTION: Offline decoder for I2C bus monitor captures.  Reads the
+* raw ring records logged by the I2C_monitor eTPU function, rebuilds the
+* bus transactions and exports them as CSV (one row per addressed
+* transfer), a per-address summary CSV and/or a VCD file for waveform
+* viewers.
+*
+*========================================================================
+* REV      AUTHOR      DATE        DESCRIPTION OF CHANGE
+* ---   -----------  ----------    ---------------------
+* 1.0     J Diener   19/Oct/26     Initial version.
+*
+* Build (Linux or another POSIX system, any C99 compiler):
+*   cc -O2 -I ../../etpu/_etpu_set -o i2c_monitor_decode i2c_monitor_decode.c
+*
+* Test (decodes test/capture.bin and compares with test/expected.csv):
+*   sh test/test.sh
+*
+* Usage:
+*   i2c_monitor_decode [-c out.csv] [-s summary.csv] [-v out.vcd]
+*                      [-a address] [-f tcr1_hz] [capture.bin | -]
+*
+*   -c  write one CSV row per transfer (START/repeated START to the next
+*       repeated START/STOP)
+*   -s  write a CSV summary per 7-bit address
+*   -v  write a VCD file (1 ns timescale)
+*   -a  only write CSV rows for this 7-bit address (the VCD and the
+*       summary always cover the whole bus)
+*   -f  TCR1 frequency in Hz, default 100000000
+*   With no input file, or "-", the capture is read from stdin.
+*
+* Capture format:
+*   The records exactly as they sit in the monitor ring, oldest first, 8
+*   bytes each (ETPU_I2C_MONITOR_REC_xxx_OFFSET), big-endian as in SDM:
+*   type, 24-bit timestamp, data, 24-bit ack_time.  aw_etpu_i2c_monitor_
+*   read_raw() returns them in this form; the host only has to write the
+*   words out big-endian.  There is no file header.
+*
+*   Timestamps are free-running 24-bit TCR1 values.  They are unwrapped
+*   into a 64-bit timeline from the difference to the previous record, so
+*   an idle gap of more than 2^24 TCR1 ticks (168 ms at 100 MHz) between
+*   two records is seen modulo that span.  Records dropped on a full ring
+*   show up as transfers that are cut short (end column START or EOF).
+*
+* Throughput:
+*   The capture is read in large blocks and decoded without per-record
+*   allocation or stdio formatting calls, so decoding runs at several
+*   hundred MB/s of capture; the output side usually dominates.
+*
+**************************************************************************/
+
+// getopt() and optind/optarg are POSIX, not C99
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "etpu_i2c_common.h"
+
+
+#define IN_BUF_SIZE		(4u << 20) // multiple of ETPU_I2C_MONITOR_REC_SIZE
+#define OUT_BUF_SIZE	(1u << 20)
+#define OUT_MAX_ITEM	256        // longest single item written to an output
+#define DATA_MAX		256        // data bytes kept per transfer for the CSV
+#define ADDR_CNT		128        // 7-bit addresses
+
+#define TIME_MASK		0x00ffffff
+
+
+/////////////////////////////////////////////////////////////////////
+// buffered output; writes go through a local copy of the buffer pointer,
+// since stores through char* would otherwise force it to be reloaded
+
+struct out_buf
+{
+	FILE* fp;
+	char* p_buf;
+	char* p;
+	char* p_end;
+};
+
+static int out_open(
+    struct out_buf* ob,
+    const char* path)
+{
+	ob->fp = fopen(path, "wb");
+	if (!ob->fp)
+		return -1;
+	ob->p_buf = malloc(OUT_BUF_SIZE);
+	if (!ob->p_buf)
+		return -1;
+	ob->p = ob->p_buf;
+	ob->p_end = ob->p_buf + OUT_BUF_SIZE;
+	return 0;
+}
+
+static int out_flush(
+    struct out_buf* ob)
+{
+	size_t len = (size_t)(ob->p - ob->p_buf);
+	ob->p = ob->p_buf;
+	return (fwrite(ob->p_buf, 1, len, ob->fp) == len) ? 0 : -1;
+}
+
+static int out_close(
+    struct out_buf* ob)
+{
+	int err = 0;
+	if (!ob->fp)
+		return 0;
+	if (out_flush(ob))
+		err = -1;
+	if (fclose(ob->fp))
+		err = -1;
+	free(ob->p_buf);
+	ob->fp = 0;
+	return err;
+}
+
+// make room for one item (a CSV row up to its data column, a VCD line);
+// items are at most OUT_MAX_ITEM bytes
+static inline void out_reserve(
+    struct out_buf* ob)
+{
+	if (ob->p_end - ob->p < OUT_MAX_ITEM)
+		out_flush(ob);
+}
+
+static inline void out_char(
+    struct out_buf* ob,
+    char c)
+{
+	*ob->p++ = c;
+}
+
+static inline void out_str(
+    struct out_buf* ob,
+    const char* s)
+{
+	char* p = ob->p;
+	while (*s)
+		*p++ = *s++;
+	ob->p = p;
+}
+
+static inline void out_u64(
+    struct out_buf* ob,
+    uint64_t val)
+{
+	char tmp[20];
+	char* p = ob->p;
+	uint32_t low;
+	int n = 0;
+	// stay in 32-bit arithmetic for the common case
+	while (val > 0xffffffffu)
+	{
+		tmp[n++] = (char)('0' + val % 10);
+		val /= 10;
+	}
+	low = (uint32_t)val;
+	do
+	{
+		tmp[n++] = (char)('0' + low % 10);
+		low /= 10;
+	} while (low);
+	while (n)
+		*p++ = tmp[--n];
+	ob->p = p;
+}
+
+static inline void out_hex2(
+    struct out_buf* ob,
+    uint32_t val)
+{
+	static const char hex[] = "0123456789abcdef";
+	ob->p[0] = hex[(val >> 4) & 0xf];
+	ob->p[1] = hex[val & 0xf];
+	ob->p += 2;
+}
+
+static inline void out_bin(
+    struct out_buf* ob,
+    uint32_t val,
+    int width)
+{
+	char* p = ob->p;
+	*p++ = 'b';
+	while (width--)
+		*p++ = (char)('0' + ((val >> width) & 1));
+	ob->p = p;
+}
+
+
+/////////////////////////////////////////////////////////////////////
+// decoder state
+
+enum end_cond
+{
+	END_STOP,
+	END_RSTART,
+	END_START,  // a new START without a STOP; records were dropped
+	END_EOF,
+};
+
+static const char* const end_cond_name[] = { "STOP", "RSTART", "START", "EOF" };
+
+struct addr_stats
+{
+	uint64_t writes;
+	uint64_t reads;
+	uint64_t header_nacks;
+	uint64_t bytes;
+	uint64_t data_nacks;
+};
+
+struct decoder
+{
+	// options
+	uint64_t tcr1_hz;
+	uint64_t ns_per_tick;  // non-zero when a tick is a whole number of ns
+	int addr_filter;       // -1 for all
+	struct out_buf csv;
+	struct out_buf vcd;
+	struct out_buf summary;
+
+	// timeline
+	int have_time;
+	uint32_t prev_stamp;
+	uint64_t now;          // unwrapped TCR1 ticks
+
+	// current message (START ... STOP) and transfer (segment of it)
+	int in_msg;
+	int in_seg;
+	int have_header;
+	uint64_t msg_cnt;
+	uint32_t seg_idx;
+	uint64_t seg_start;
+	uint64_t seg_end;
+	uint8_t header;
+	uint8_t header_nack;
+	uint32_t byte_cnt;
+	uint32_t data_nack_cnt;
+	uint8_t data[DATA_MAX];
+
+	// VCD
+	int vcd_have_time;
+	uint64_t vcd_time;
+
+	// statistics
+	uint64_t rec_cnt;
+	uint64_t seg_cnt;
+	uint64_t orphan_cnt;   // bytes/STOPs outside of a transfer
+	uint64_t bad_type_cnt;
+	struct addr_stats addr[ADDR_CNT];
+};
+
+static uint64_t ticks_to_ns(
+    const struct decoder* dec,
+    uint64_t ticks)
+{
+	if (dec->ns_per_tick)
+		return ticks * dec->ns_per_tick;
+	return (ticks / dec->tcr1_hz) * 1000000000u +
+		((ticks % dec->tcr1_hz) * 1000000000u) / dec->tcr1_hz;
+}
+
+// unwrap a 24-bit stamp against the previous one
+static uint64_t unwrap(
+    struct decoder* dec,
+    uint32_t stamp)
+{
+	if (dec->have_time)
+		dec->now += (stamp - dec->prev_stamp) & TIME_MASK;
+	else
+		dec->now = stamp;
+	dec->have_time = 1;
+	dec->prev_stamp = stamp;
+	return dec->now;
+}
+
+
+/////////////////////////////////////////////////////////////////////
+// VCD output
+
+#define VCD_BUSY	"!"
+#define VCD_START	"\""
+#define VCD_ADDR	"#"
+#define VCD_RW		"$"
+#define VCD_DATA	"%"
+#define VCD_NACK	"&"
+
+static void vcd_header(
+    struct decoder* dec)
+{
+	struct out_buf* ob = &dec->vcd;
+	out_str(ob, "$version i2c_monitor_decode $end\n"); out_reserve(ob);
+	out_str(ob, "$timescale 1ns $end\n"); out_reserve(ob);
+	out_str(ob, "$scope module i2c $end\n"); out_reserve(ob);
+	out_str(ob, "$var wire 1 " VCD_BUSY " busy $end\n"); out_reserve(ob);
+	out_str(ob, "$var wire 1 " VCD_START " start $end\n"); out_reserve(ob);
+	out_str(ob, "$var wire 7 " VCD_ADDR " addr $end\n"); out_reserve(ob);
+	out_str(ob, "$var wire 1 " VCD_RW " rw $end\n"); out_reserve(ob);
+	out_str(ob, "$var wire 8 " VCD_DATA " data $end\n"); out_reserve(ob);
+	out_str(ob, "$var wire 1 " VCD_NACK " nack $end\n"); out_reserve(ob);
+	out_str(ob, "$upscope $end\n$enddefinitions $end\n"); out_reserve(ob);
+	out_str(ob, "$dumpvars\n0" VCD_BUSY "\n0" VCD_START "\n"); out_reserve(ob);
+	out_str(ob, "bx " VCD_ADDR "\nx" VCD_RW "\nbx " VCD_DATA "\nx" VCD_NACK "\n$end\n");
+}
+
+// move the VCD time forward to ticks; time never goes backwards
+static void vcd_at(
+    struct decoder* dec,
+    uint64_t ticks)
+{
+	struct out_buf* ob = &dec->vcd;
+	uint64_t t = ticks_to_ns(dec, ticks);
+	if (dec->vcd_have_time && (t <= dec->vcd_time))
+		return;
+	dec->vcd_have_time = 1;
+	dec->vcd_time = t;
+	out_reserve(ob);
+	out_char(ob, '#');
+	out_u64(ob, t);
+	out_char(ob, '\n');
+}
+
+static void vcd_bit(
+    struct decoder* dec,
+    char val,
+    const char* id)
+{
+	struct out_buf* ob = &dec->vcd;
+	out_reserve(ob);
+	out_char(ob, val);
+	out_str(ob, id);
+	out_char(ob, '\n');
+}
+
+static void vcd_vec(
+    struct decoder* dec,
+    uint32_t val,
+    int width,
+    const char* id)
+{
+	struct out_buf* ob = &dec->vcd;
+	out_reserve(ob);
+	out_bin(ob, val, width);
+	out_char(ob, ' ');
+	out_str(ob, id);
+	out_char(ob, '\n');
+}
+
+static void vcd_vec_x(
+    struct decoder* dec,
+    const char* id)
+{
+	struct out_buf* ob = &dec->vcd;
+	out_reserve(ob);
+	out_str(ob, "bx ");
+	out_str(ob, id);
+	out_char(ob, '\n');
+}
+
+
+/////////////////////////////////////////////////////////////////////
+// transaction reconstruction
+
+static void seg_open(
+    struct decoder* dec,
+    uint64_t t)
+{
+	dec->in_seg = 1;
+	dec->have_header = 0;
+	dec->seg_start = t;
+	dec->seg_end = t;
+	dec->header = 0;
+	dec->header_nack = 0;
+	dec->byte_cnt = 0;
+	dec->data_nack_cnt = 0;
+}
+
+static void seg_close(
+    struct decoder* dec,
+    enum end_cond end,
+    uint64_t t)
+{
+	struct out_buf* ob = &dec->csv;
+	struct addr_stats* as;
+	uint32_t addr;
+	uint32_t i;
+	uint32_t n;
+
+	if (!dec->in_seg)
+		return;
+	dec->in_seg = 0;
+	dec->seg_cnt++;
+	if (end != END_EOF)
+		dec->seg_end = t;
+
+	addr = dec->header >> 1;
+	if (dec->have_header)
+	{
+		as = &dec->addr[addr];
+		if (dec->header & ETPU_I2C_RW_MASK)
+			as->reads++;
+		else
+			as->writes++;
+		as->header_nacks += dec->header_nack;
+		as->bytes += dec->byte_cnt;
+		as->data_nacks += dec->data_nack_cnt;
+	}
+
+	if (!ob->fp)
+		return;
+	if ((dec->addr_filter >= 0) && (!dec->have_header || ((int)addr != dec->addr_filter)))
+		return;
+
+	// message,segment,start_ns,end_ns,address,rw,header_ack,bytes,data_nacks,end,data
+	out_reserve(ob);
+	out_u64(ob, dec->msg_cnt);
+	out_char(ob, ',');
+	out_u64(ob, dec->seg_idx);
+	out_char(ob, ',');
+	out_u64(ob, ticks_to_ns(dec, dec->seg_start));
+	out_char(ob, ',');
+	out_u64(ob, ticks_to_ns(dec, dec->seg_end));
+	out_char(ob, ',');
+	if (dec->have_header)
+	{
+		out_str(ob, "0x");
+		out_hex2(ob, addr);
+		out_str(ob, (dec->header & ETPU_I2C_RW_MASK) ? ",R," : ",W,");
+		out_str(ob, dec->header_nack ? "NACK," : "ACK,");
+	}
+	else
+	{
+		out_str(ob, ",,,");
+	}
+	out_u64(ob, dec->byte_cnt);
+	out_char(ob, ',');
+	out_u64(ob, dec->data_nack_cnt);
+	out_char(ob, ',');
+	out_str(ob, end_cond_name[end]);
+	out_char(ob, ',');
+	n = (dec->byte_cnt < DATA_MAX) ? dec->byte_cnt : DATA_MAX;
+	for (i = 0; i < n; i++)
+	{
+		out_reserve(ob);
+		if (i)
+			out_char(ob, ' ');
+		out_hex2(ob, dec->data[i]);
+	}
+	out_reserve(ob);
+	if (n < dec->byte_cnt)
+		out_str(ob, " ...");
+	out_char(ob, '\n');
+}
+
+static void on_condition(
+    struct decoder* dec,
+    uint32_t type,
+    uint32_t stamp)
+{
+	uint64_t t = unwrap(dec, stamp);
+
+	if (type == ETPU_I2C_MONITOR_REC_STOP)
+	{
+		if (!dec->in_msg)
+			dec->orphan_cnt++;
+		seg_close(dec, END_STOP, t);
+		dec->in_msg = 0;
+		if (dec->vcd.fp)
+		{
+			vcd_at(dec, t);
+			vcd_bit(dec, '0', VCD_BUSY);
+			vcd_vec_x(dec, VCD_ADDR);
+			vcd_bit(dec, 'x', VCD_RW);
+			vcd_vec_x(dec, VCD_DATA);
+			vcd_bit(dec, 'x', VCD_NACK);
+		}
+		return;
+	}
+
+	// START, or a repeated START; a repeated START with no message open
+	// (capture started mid-message) still opens one
+	if ((type == ETPU_I2C_MONITOR_REC_RSTART) && dec->in_msg)
+	{
+		seg_close(dec, END_RSTART, t);
+		dec->seg_idx++;
+	}
+	else
+	{
+		seg_close(dec, END_START, t);
+		dec->in_msg = 1;
+		dec->msg_cnt++;
+		dec->seg_idx = 0;
+	}
+	seg_open(dec, t);
+	if (dec->vcd.fp)
+	{
+		vcd_at(dec, t);
+		vcd_bit(dec, '1', VCD_BUSY);
+		vcd_bit(dec, '1', VCD_START);
+		vcd_at(dec, t + 1);
+		vcd_bit(dec, '0', VCD_START);
+	}
+}
+
+static void on_byte(
+    struct decoder* dec,
+    uint32_t type,
+    uint32_t stamp,
+    uint32_t data,
+    uint32_t ack_stamp)
+{
+	uint64_t t = unwrap(dec, stamp);
+	uint64_t t_ack = unwrap(dec, ack_stamp);
+	uint32_t nack = (type & ETPU_I2C_MONITOR_REC_NACK) ? 1 : 0;
+
+	if (!dec->in_seg)
+	{
+		dec->orphan_cnt++;
+	}
+	else if ((type & ETPU_I2C_MONITOR_REC_TYPE_MASK) == ETPU_I2C_MONITOR_REC_HEADER)
+	{
+		dec->have_header = 1;
+		dec->header = (uint8_t)data;
+		dec->header_nack = (uint8_t)nack;
+		dec->seg_end = t_ack;
+	}
+	else if (dec->have_header)
+	{
+		if (dec->byte_cnt < DATA_MAX)
+			dec->data[dec->byte_cnt] = (uint8_t)data;
+		dec->byte_cnt++;
+		dec->data_nack_cnt += nack;
+		dec->seg_end = t_ack;
+	}
+	else
+	{
+		dec->orphan_cnt++;
+	}
+
+	if (dec->vcd.fp)
+	{
+		vcd_at(dec, t);
+		if ((type & ETPU_I2C_MONITOR_REC_TYPE_MASK) == ETPU_I2C_MONITOR_REC_HEADER)
+		{
+			vcd_vec(dec, data >> 1, 7, VCD_ADDR);
+			vcd_bit(dec, (data & ETPU_I2C_RW_MASK) ? '1' : '0', VCD_RW);
+		}
+		vcd_vec(dec, data, 8, VCD_DATA);
+		vcd_bit(dec, 'x', VCD_NACK);
+		vcd_at(dec, t_ack);
+		vcd_bit(dec, nack ? '1' : '0', VCD_NACK);
+	}
+}
+
+static void decode_block(
+    struct decoder* dec,
+    const uint8_t* p,
+    size_t rec_cnt)
+{
+	uint32_t type;
+	uint32_t stamp;
+	uint32_t ack_stamp;
+
+	dec->rec_cnt += rec_cnt;
+	for (; rec_cnt; rec_cnt--, p += ETPU_I2C_MONITOR_REC_SIZE)
+	{
+		type = p[ETPU_I2C_MONITOR_REC_TYPE_OFFSET];
+		stamp = ((uint32_t)p[ETPU_I2C_MONITOR_REC_TIME_OFFSET] << 16) |
+			((uint32_t)p[ETPU_I2C_MONITOR_REC_TIME_OFFSET+1] << 8) |
+			p[ETPU_I2C_MONITOR_REC_TIME_OFFSET+2];
+		switch (type & ETPU_I2C_MONITOR_REC_TYPE_MASK)
+		{
+		case ETPU_I2C_MONITOR_REC_START:
+		case ETPU_I2C_MONITOR_REC_RSTART:
+		case ETPU_I2C_MONITOR_REC_STOP:
+			on_condition(dec, type & ETPU_I2C_MONITOR_REC_TYPE_MASK, stamp);
+			break;
+		case ETPU_I2C_MONITOR_REC_HEADER:
+		case ETPU_I2C_MONITOR_REC_DATA:
+			ack_stamp = ((uint32_t)p[ETPU_I2C_MONITOR_REC_ACK_TIME_OFFSET] << 16) |
+				((uint32_t)p[ETPU_I2C_MONITOR_REC_ACK_TIME_OFFSET+1] << 8) |
+				p[ETPU_I2C_MONITOR_REC_ACK_TIME_OFFSET+2];
+			on_byte(dec, type, stamp, p[ETPU_I2C_MONITOR_REC_DATA_OFFSET], ack_stamp);
+			break;
+		default:
+			dec->bad_type_cnt++;
+			break;
+		}
+	}
+}
+
+static void write_summary(
+    struct decoder* dec)
+{
+	struct out_buf* ob = &dec->summary;
+	struct addr_stats* as;
+	uint32_t addr;
+
+	out_str(ob, "address,writes,reads,header_nacks,bytes,data_nacks\n");
+	for (addr = 0; addr < ADDR_CNT; addr++)
+	{
+		as = &dec->addr[addr];
+		if (!as->writes && !as->reads)
+			continue;
+		out_reserve(ob);
+		out_str(ob, "0x");
+		out_hex2(ob, addr);
+		out_char(ob, ',');
+		out_u64(ob, as->writes);
+		out_char(ob, ',');
+		out_u64(ob, as->reads);
+		out_char(ob, ',');
+		out_u64(ob, as->header_nacks);
+		out_char(ob, ',');
+		out_u64(ob, as->bytes);
+		out_char(ob, ',');
+		out_u64(ob, as->data_nacks);
+		out_char(ob, '\n');
+	}
+}
+
+
+/////////////////////////////////////////////////////////////////////
+
+static void usage(void)
+{
+	fprintf(stderr,
+		"usage: i2c_monitor_decode [-c out.csv] [-s summary.csv] [-v out.vcd]\n"
+		"                          [-a address] [-f tcr1_hz] [capture.bin | -]\n");
+}
+
+int main(
+    int argc,
+    char** argv)
+{
+	static struct decoder dec;
+	const char* csv_path = 0;
+	const char* vcd_path = 0;
+	const char* summary_path = 0;
+	FILE* in;
+	uint8_t* p_in;
+	size_t fill = 0;
+	size_t len;
+	size_t whole;
+	char* p_end;
+	int err = 0;
+	int opt;
+
+	dec.tcr1_hz = 100000000u;
+	dec.addr_filter = -1;
+	while ((opt = getopt(argc, argv, "c:s:v:a:f:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 'c': csv_path = optarg; break;
+		case 's': summary_path = optarg; break;
+		case 'v': vcd_path = optarg; break;
+		case 'a':
+			dec.addr_filter = (int)strtol(optarg, &p_end, 0);
+			if (*p_end || (dec.addr_filter < 0) || (dec.addr_filter >= ADDR_CNT))
+			{
+				fprintf(stderr, "i2c_monitor_decode: bad 7-bit address '%s'\n", optarg);
+				return 2;
+			}
+			break;
+		case 'f':
+			dec.tcr1_hz = strtoull(optarg, &p_end, 0);
+			if (*p_end || !dec.tcr1_hz)
+			{
+				fprintf(stderr, "i2c_monitor_decode: bad TCR1 frequency '%s'\n", optarg);
+				return 2;
+			}
+			break;
+		default:
+			usage();
+			return 2;
+		}
+	}
+	if ((argc - optind > 1) || (!csv_path && !vcd_path && !summary_path))
+	{
+		usage();
+		return 2;
+	}
+	if ((1000000000u % dec.tcr1_hz) == 0)
+		dec.ns_per_tick = 1000000000u / dec.tcr1_hz;
+
+	if ((optind == argc) || !strcmp(argv[optind], "-"))
+		in = stdin;
+	else
+		in = fopen(argv[optind], "rb");
+	if (!in)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+	if ((csv_path && out_open(&dec.csv, csv_path)) ||
+		(vcd_path && out_open(&dec.vcd, vcd_path)) ||
+		(summary_path && out_open(&dec.summary, summary_path)))
+	{
+		perror("i2c_monitor_decode");
+		return 1;
+	}
+	p_in = malloc(IN_BUF_SIZE);
+	if (!p_in)
+	{
+		perror("i2c_monitor_decode");
+		return 1;
+	}
+
+	if (dec.csv.fp)
+		out_str(&dec.csv, "message,segment,start_ns,end_ns,address,rw,header_ack,bytes,data_nacks,end,data\n");
+	if (dec.vcd.fp)
+		vcd_header(&dec);
+
+	// decode whole records; a partial record is kept for the next block
+	while ((len = fread(p_in + fill, 1, IN_BUF_SIZE - fill, in)) > 0)
+	{
+		fill += len;
+		whole = fill / ETPU_I2C_MONITOR_REC_SIZE;
+		decode_block(&dec, p_in, whole);
+		whole *= ETPU_I2C_MONITOR_REC_SIZE;
+		memmove(p_in, p_in + whole, fill - whole);
+		fill -= whole;
+	}
+	if (ferror(in))
+	{
+		perror("i2c_monitor_decode: read");
+		err = 1;
+	}
+	seg_close(&dec, END_EOF, dec.now);
+	if (dec.summary.fp)
+		write_summary(&dec);
+
+	if (out_close(&dec.csv) || out_close(&dec.vcd) || out_close(&dec.summary))
+	{
+		perror("i2c_monitor_decode: write");
+		err = 1;
+	}
+	if (in != stdin)
+		fclose(in);
+	free(p_in);
+
+	fprintf(stderr, "%llu records, %llu messages, %llu transfers",
+		(unsigned long long)dec.rec_cnt, (unsigned long long)dec.msg_cnt,
+		(unsigned long long)dec.seg_cnt);
+	if (dec.orphan_cnt)
+		fprintf(stderr, ", %llu records outside a transfer", (unsigned long long)dec.orphan_cnt);
+	if (dec.bad_type_cnt)
+		fprintf(stderr, ", %llu records of unknown type", (unsigned long long)dec.bad_type_cnt);
+	if (fill)
+		fprintf(stderr, ", %u trailing bytes ignored", (unsigned)fill);
+	fprintf(stderr, "\n");
+	return err;
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Decode the fixed capture and compare the CSV with the expected output.
+#
+# capture.bin holds these monitor ring records (type, time, data, ack_time):
+#   START   0xfffff0                  message 1; the timestamps wrap
+#   HEADER  0xfffff8  0x50  0xfffffc  between its data byte and STOP
+#   DATA    0x000004  0x12  0x000008
+#   STOP    0x000010
+#   START   0x000100                  message 2; write, repeated START,
+#   HEADER  0x000108  0xa0  0x00010c  then a read whose byte is NACKed
+#   DATA    0x000110  0x00  0x000114
+#   RSTART  0x000120
+#   HEADER  0x000128  0xa1  0x00012c
+#   DATA|NACK 0x000130 0x55 0x000134
+#   STOP    0x000140
+#   START   0x000200                  message 3; STOP lost, so it ends
+#   HEADER  0x000208  0x52  0x00020c  at the next START
+#   START   0x000300                  message 4
+#   HEADER  0x000308  0x54  0x00030c
+#   STOP    0x000310
+#
+# Usage: sh test.sh   (from any directory; needs cc)
+
+cd "$(dirname "$0")" || exit 1
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+cc -std=c99 -Wall -O2 -I ../../../etpu/_etpu_set -o "$tmp/i2c_monitor_decode" ../i2c_monitor_decode.c || exit 1
+"$tmp/i2c_monitor_decode" -c "$tmp/out.csv" capture.bin || exit 1
+if diff -u expected.csv "$tmp/out.csv"; then
+	echo "PASS"
+else
+	echo "FAIL"
+	exit 1
+fi